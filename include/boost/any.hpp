@@ -33,7 +33,11 @@
 
 #include <boost/any/bad_any_cast.hpp>
 #include <boost/any/fwd.hpp>
+#include <boost/any/detail/allocation.hpp>
 #include <boost/any/detail/placeholder.hpp>
+#ifdef BOOST_ANY_USE_HOLDER_VALUE_OPS
+#include <boost/any/detail/value_ops.hpp>
+#endif
 
 namespace boost {
 
@@ -233,6 +237,29 @@ BOOST_ANY_BEGIN_MODULE_EXPORT
             {
             }
 
+            static void* operator new(std::size_t size)
+            {
+                return boost::anys::detail::allocate_block<ValueType, holder>(size);
+            }
+
+            static void operator delete(void* p) noexcept
+            {
+                boost::anys::detail::deallocate_block<ValueType, holder>(p);
+            }
+
+#ifdef __cpp_aligned_new
+            // Over-aligned holders are never pooled
+            static void* operator new(std::size_t size, std::align_val_t alignment)
+            {
+                return ::operator new(size, alignment);
+            }
+
+            static void operator delete(void* p, std::align_val_t alignment) noexcept
+            {
+                ::operator delete(p, alignment);
+            }
+#endif
+
         public: // queries
 
             const boost::typeindex::type_info& type() const noexcept override
@@ -245,6 +272,25 @@ BOOST_ANY_BEGIN_MODULE_EXPORT
                 return new holder(held);
             }
 
+#ifdef BOOST_ANY_USE_HOLDER_VALUE_OPS
+            const boost::anys::detail::value_ops* ops() const noexcept override
+            {
+                return &boost::anys::detail::value_ops_of<ValueType>::value;
+            }
+
+            void* address() const noexcept override
+            {
+                return const_cast<ValueType*>(std::addressof(held));
+            }
+#endif
+
+#if defined(BOOST_ANY_USE_POLYMORPHIC_CAST) && !defined(BOOST_NO_EXCEPTIONS)
+            void throw_address() const override
+            {
+                throw const_cast<ValueType*>(std::addressof(held));
+            }
+#endif
+
         public: // representation
 
             ValueType held;
@@ -259,6 +305,8 @@ BOOST_ANY_BEGIN_MODULE_EXPORT
 
         friend class boost::anys::unique_any;
 
+        friend struct boost::anys::detail::placeholder_access;
+
         placeholder * content;
         /// @endcond
     };
@@ -320,7 +368,7 @@ BOOST_ANY_BEGIN_MODULE_EXPORT
 
         nonref * result = boost::any_cast<nonref>(std::addressof(operand));
         if(!result)
-            boost::throw_exception(bad_any_cast());
+            anys::detail::throw_bad_any_cast();
 
         // Attempt to avoid construction of a temporary object in cases when
         // `ValueType` is not a reference. Example:
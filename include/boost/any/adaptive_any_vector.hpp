@@ -0,0 +1,333 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/any for Documentation.
+
+#ifndef BOOST_ANYS_ADAPTIVE_ANY_VECTOR_HPP_INCLUDED
+#define BOOST_ANYS_ADAPTIVE_ANY_VECTOR_HPP_INCLUDED
+
+#include <boost/any/detail/config.hpp>
+
+#if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+/// \file boost/any/adaptive_any_vector.hpp
+/// \brief \copybrief boost::anys::adaptive_any_vector
+
+#ifndef BOOST_ANY_INTERFACE_UNIT
+#include <boost/config.hpp>
+#ifdef BOOST_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/assert.hpp>
+#endif  // #ifndef BOOST_ANY_INTERFACE_UNIT
+
+#include <boost/any/any_ref.hpp>
+#include <boost/any/basic_any.hpp>
+#include <boost/any/typed_span.hpp>
+#include <boost/any/detail/erased_array.hpp>
+#include <boost/any/detail/value_ops.hpp>
+
+namespace boost {
+
+namespace anys {
+
+BOOST_ANY_BEGIN_MODULE_EXPORT
+
+/// \brief Sequence of values of any types, that stores the values as a plain
+/// array while all of them have the same type.
+///
+/// Most of the sequences of anys in practice hold values of a single type.
+/// boost::anys::adaptive_any_vector keeps such values contiguously, without
+/// a holder per value, as `std::vector<T>` would. The first insertion of a
+/// value of another type, or of an empty any, moves all the values into
+/// holders, so the sequence continues to work as
+/// `std::vector<boost::any>`.
+///
+/// Elements are accessed via boost::anys::any_ref and
+/// boost::anys::any_cref, that work with boost::any_cast:
+/// \code
+/// boost::anys::adaptive_any_vector column;
+/// column.push_back(1);
+/// column.push_back(2);
+/// assert(boost::any_cast<int>(column[1]) == 2);
+///
+/// for (int& v : column.homogeneous_span<int>()) {
+///     // Plain array walk
+/// }
+/// \endcode
+class adaptive_any_vector {
+public:
+    using size_type = std::size_t;
+
+    /// \post this->empty() is true.
+    adaptive_any_vector() = default;
+
+    /// Copies the elements of `other`.
+    /// \throws std::bad_alloc or any exceptions arising from the copy
+    /// constructors of the stored types.
+    adaptive_any_vector(const adaptive_any_vector&) = default;
+
+    /// Moves the elements of `other` into `*this`.
+    /// \throws Nothing.
+    adaptive_any_vector(adaptive_any_vector&& other) noexcept
+      : values(std::move(other.values))
+      , holders(std::move(other.holders))
+      , mixed(other.mixed)
+    {
+        other.mixed = false;
+    }
+
+    /// Copies `rhs`, discarding previous content.
+    /// \throws std::bad_alloc or any exceptions arising from the copy
+    /// constructors of the stored types. Strong exception guarantee.
+    adaptive_any_vector& operator=(const adaptive_any_vector& rhs)
+    {
+        adaptive_any_vector(rhs).swap(*this);
+        return *this;
+    }
+
+    /// Moves `rhs` into `*this`, discarding previous content.
+    /// \throws Nothing.
+    adaptive_any_vector& operator=(adaptive_any_vector&& rhs) noexcept
+    {
+        adaptive_any_vector(std::move(rhs)).swap(*this);
+        return *this;
+    }
+
+    /// Constructs a `ValueType` from `args` at the end of the sequence.
+    /// \returns Reference to the new element.
+    /// \throws std::bad_alloc or any exceptions arising from the constructor
+    /// of `ValueType` or from the copy constructor of the stored type on
+    /// switching to holders. Strong exception guarantee.
+    template <class ValueType, class... Args>
+    ValueType& emplace_back(Args&&... args)
+    {
+        static_assert(
+            !std::is_reference<ValueType>::value && !std::is_const<ValueType>::value,
+            "boost::anys::adaptive_any_vector stores non-const values"
+        );
+        static_assert(
+            !anys::detail::is_some_any<ValueType>::value,
+            "boost::anys::adaptive_any_vector::emplace_back shall not be used with any types, "
+            "use push_back"
+        );
+        static_assert(
+            std::is_copy_constructible<ValueType>::value,
+            "boost::anys::adaptive_any_vector requires copy constructible types"
+        );
+
+        const detail::value_ops& ops = detail::value_ops_of<ValueType>::value;
+        if (same_type(ops)) {
+            retype(ops);
+            return *static_cast<ValueType*>(values.construct_back([&args...](void* place) {
+                ::new (place) ValueType(std::forward<Args>(args)...);
+            }));
+        }
+
+        ValueType value(std::forward<Args>(args)...);
+        return *static_cast<ValueType*>(push_back_holder(detail::erased_value(ops, std::addressof(value))));
+    }
+
+    /// Copies or moves `value` to the end of the sequence.
+    /// \throws std::bad_alloc or any exceptions arising from the copy or move
+    /// constructor of `ValueType` or from the copy constructor of the stored
+    /// type on switching to holders. Strong exception guarantee.
+    template <class ValueType>
+    typename std::enable_if<!anys::detail::is_basic_any<typename std::decay<ValueType>::type>::value>::type
+    push_back(ValueType&& value)
+    {
+        emplace_back<typename std::decay<ValueType>::type>(std::forward<ValueType>(value));
+    }
+
+    /// Moves the content of `value` to the end of the sequence, leaving the
+    /// `value` empty. An empty `value` adds an empty element.
+    /// Requires `BOOST_ANY_USE_HOLDER_VALUE_OPS`, see boost::anys::basic_any.
+    /// \throws std::bad_alloc or any exceptions arising from the move
+    /// constructor of the stored types.
+    template <std::size_t OptimizeForSize, std::size_t OptimizeForAlignment>
+    void push_back(basic_any<OptimizeForSize, OptimizeForAlignment>&& value)
+    {
+        const detail::value_ops* ops = detail::basic_any_access::ops(value);
+        void* const address = detail::basic_any_access::address(value);
+        if (ops && same_type(*ops)) {
+            retype(*ops);
+            values.move_back(address);
+        } else {
+            push_back_holder(ops ? detail::erased_value(*ops, address) : detail::erased_value());
+        }
+        detail::basic_any_access::reset(value);
+    }
+
+    /// Copies the content of `value` to the end of the sequence. An empty
+    /// `value` adds an empty element.
+    /// Requires `BOOST_ANY_USE_HOLDER_VALUE_OPS`, see boost::anys::basic_any.
+    /// \throws std::bad_alloc or any exceptions arising from the copy
+    /// constructor of the stored type or the move constructor of the stored
+    /// types.
+    template <std::size_t OptimizeForSize, std::size_t OptimizeForAlignment>
+    void push_back(const basic_any<OptimizeForSize, OptimizeForAlignment>& value)
+    {
+        push_back(basic_any<OptimizeForSize, OptimizeForAlignment>(value));
+    }
+
+    /// \returns Reference to the element at `index`.
+    /// \pre `index < this->size()`
+    any_ref operator[](std::size_t index) noexcept
+    {
+        BOOST_ASSERT(index < size());
+        if (!mixed) {
+            return detail::any_ref_access::make(&values.ops(), values.at(index));
+        }
+        const detail::erased_value& h = holders[index];
+        return detail::any_ref_access::make(h.ops(), h.data());
+    }
+
+    /// \returns Reference to the element at `index`.
+    /// \pre `index < this->size()`
+    any_cref operator[](std::size_t index) const noexcept
+    {
+        return const_cast<adaptive_any_vector&>(*this)[index];
+    }
+
+    /// \returns `true` if all the elements have the same type and are stored
+    /// contiguously. `true` for an empty sequence.
+    bool is_homogeneous() const noexcept { return !mixed; }
+
+    /// \returns View to all the elements if all of them have `ValueType`,
+    /// an empty view otherwise.
+    template <class ValueType>
+    typed_span<ValueType> homogeneous_span() noexcept
+    {
+        return !mixed && values.has_type() && values.size() && &values.ops() == &detail::value_ops_of<ValueType>::value
+            ? typed_span<ValueType>(static_cast<ValueType*>(values.data()), values.size())
+            : typed_span<ValueType>();
+    }
+
+    /// \returns View to all the elements if all of them have `ValueType`,
+    /// an empty view otherwise.
+    template <class ValueType>
+    typed_span<const ValueType> homogeneous_span() const noexcept
+    {
+        return const_cast<adaptive_any_vector&>(*this).homogeneous_span<ValueType>();
+    }
+
+    /// \returns Count of elements.
+    size_type size() const noexcept { return mixed ? holders.size() : values.size(); }
+
+    /// \returns `true` if there are no elements.
+    bool empty() const noexcept { return !size(); }
+
+    /// Makes sure that `count` elements of the current type fit without
+    /// reallocations.
+    /// \throws std::bad_alloc or any exceptions arising from the copy
+    /// constructors of the stored types. Strong exception guarantee.
+    void reserve(std::size_t count)
+    {
+        if (mixed) {
+            holders.reserve(count);
+        } else if (values.has_type()) {
+            values.reserve(count);
+        }
+    }
+
+    /// Destroys all the elements. The sequence becomes homogeneous again.
+    void clear() noexcept
+    {
+        values = detail::erased_array();
+        holders.clear();
+        mixed = false;
+    }
+
+    /// Exchanges the content of `*this` and `rhs`.
+    /// \throws Nothing.
+    void swap(adaptive_any_vector& rhs) noexcept
+    {
+        values.swap(rhs.values);
+        holders.swap(rhs.holders);
+        std::swap(mixed, rhs.mixed);
+    }
+
+private:
+    /// @cond
+    bool same_type(const detail::value_ops& ops) const noexcept
+    {
+        return !mixed && (!values.has_type() || !values.size() || &values.ops() == &ops);
+    }
+
+    // The empty array keeps the type of the last stored values, for example
+    // after a throwing emplace_back() of a new type
+    void retype(const detail::value_ops& ops)
+    {
+        if (!values.has_type() || (!values.size() && &values.ops() != &ops)) {
+            values = detail::erased_array(ops);
+        }
+    }
+
+    void* push_back_holder(detail::erased_value&& value)
+    {
+        if (!mixed) {
+            spill(1);
+        }
+        holders.push_back(std::move(value));
+        return holders.back().data();
+    }
+
+    // Moves all the values into holders. The memory for all the holders is
+    // allocated before the values are touched, and the values are copied if
+    // their move may throw, so the values stay intact on exception.
+    BOOST_NOINLINE void spill(std::size_t additional)
+    {
+        std::vector<detail::erased_value> new_holders;
+        new_holders.reserve(values.size() + additional);
+        if (values.size()) {
+            const detail::value_ops& ops = values.ops();
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                new_holders.push_back(detail::erased_value::reserve(ops));
+            }
+
+            if (ops.nothrow_move || !ops.copy) {
+                for (std::size_t i = 0; i < values.size(); ++i) {
+                    new_holders[i].construct_move(ops, values.at(i));
+                }
+            } else {
+                for (std::size_t i = 0; i < values.size(); ++i) {
+                    new_holders[i].construct_copy(ops, values.at(i));
+                }
+            }
+        }
+        holders.swap(new_holders);
+        values = detail::erased_array();
+        mixed = true;
+    }
+
+    detail::erased_array values;
+    std::vector<detail::erased_value> holders;
+    bool mixed = false;
+    /// @endcond
+};
+
+/// Exchanges the content of `lhs` and `rhs`.
+/// \throws Nothing.
+inline void swap(adaptive_any_vector& lhs, adaptive_any_vector& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+BOOST_ANY_END_MODULE_EXPORT
+
+} // namespace anys
+
+} // namespace boost
+
+#endif  // #if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+#endif // #ifndef BOOST_ANYS_ADAPTIVE_ANY_VECTOR_HPP_INCLUDED
@@ -0,0 +1,351 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/any for Documentation.
+
+#ifndef BOOST_ANYS_ANY_BLOCK_HPP_INCLUDED
+#define BOOST_ANYS_ANY_BLOCK_HPP_INCLUDED
+
+#include <boost/any/detail/config.hpp>
+
+#if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+/// \file boost/any/any_block.hpp
+/// \brief \copybrief boost::anys::any_block
+
+#ifndef BOOST_ANY_INTERFACE_UNIT
+#include <boost/config.hpp>
+#ifdef BOOST_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <boost/assert.hpp>
+#endif  // #ifndef BOOST_ANY_INTERFACE_UNIT
+
+#include <boost/any.hpp>
+#include <boost/any/any_ref.hpp>
+#include <boost/any/basic_any.hpp>
+#include <boost/any/detail/erased_array.hpp>
+#include <boost/any/detail/placeholder.hpp>
+#include <boost/any/detail/value_ops.hpp>
+
+namespace boost {
+
+namespace anys {
+
+/// @cond
+namespace detail {
+
+    struct block_entry {
+        const value_ops* ops;
+        void* data;
+    };
+
+    template <std::size_t Size, std::size_t Alignment>
+    block_entry block_source(const basic_any<Size, Alignment>& value) noexcept
+    {
+        return {
+            basic_any_access::ops(value),
+            basic_any_access::address(const_cast<basic_any<Size, Alignment>&>(value))
+        };
+    }
+
+#ifdef BOOST_ANY_USE_HOLDER_VALUE_OPS
+    inline block_entry block_source(const boost::any& value) noexcept
+    {
+        const placeholder* content = placeholder_access::content(value);
+        return content ? block_entry{content->ops(), content->address()} : block_entry{nullptr, nullptr};
+    }
+#else
+    template <class Any>
+    typename std::enable_if<std::is_same<Any, boost::any>::value, block_entry>::type
+    block_source(const Any&) noexcept
+    {
+        static_assert(
+            !std::is_same<Any, boost::any>::value,
+            "boost::anys::any_block requires BOOST_ANY_USE_HOLDER_VALUE_OPS to copy boost::any values"
+        );
+        return {nullptr, nullptr};
+    }
+#endif
+
+    inline block_entry block_source(any_cref value) noexcept
+    {
+        return {any_ref_access::ops(value), const_cast<void*>(any_ref_access::data(value))};
+    }
+
+    inline block_entry block_source(any_ref value) noexcept
+    {
+        return detail::block_source(any_cref(value));
+    }
+
+    constexpr std::size_t align_offset(std::size_t offset, std::size_t alignment) noexcept
+    {
+        return (offset + alignment - 1) / alignment * alignment;
+    }
+
+} // namespace detail
+/// @endcond
+
+BOOST_ANY_BEGIN_MODULE_EXPORT
+
+/// \brief Fixed size sequence of values of any types, that keeps copies of
+/// all the values in a single allocation.
+///
+/// Copying boost::any or boost::anys::basic_any values requires
+/// `BOOST_ANY_USE_HOLDER_VALUE_OPS` to be defined consistently in all the
+/// translation units of the program, otherwise such copies do not compile.
+/// The macro makes the holders of boost::any and the managers of
+/// boost::anys::basic_any report the operations on their values, at the
+/// cost of instantiating them for every stored type. Values referenced by
+/// boost::anys::any_ref and boost::anys::any_cref are copied without the
+/// macro.
+///
+/// Copying a `std::vector<boost::any>` allocates a holder per element.
+/// boost::anys::any_block computes the total size of the values first and
+/// copy constructs all of them into one memory block, so a snapshot of N
+/// values costs one allocation:
+/// \code
+/// #define BOOST_ANY_USE_HOLDER_VALUE_OPS
+/// #include <boost/any/any_block.hpp>
+///
+/// std::vector<boost::any> state = ...;
+/// const boost::anys::any_block snapshot(state.begin(), state.end());
+/// assert(boost::any_cast<int>(snapshot[0]) == boost::any_cast<int>(state[0]));
+/// \endcode
+///
+/// Elements are accessed via boost::anys::any_ref and
+/// boost::anys::any_cref, that work with boost::any_cast. The values share
+/// the lifetime of the block.
+class any_block {
+public:
+    /// \post this->empty() is true.
+    any_block() noexcept
+      : raw(nullptr)
+      , entries(nullptr)
+      , count(0)
+    {}
+
+    /// Copies the values of [`first`, `last`) into a single allocation.
+    /// Empty elements produce empty elements of the block.
+    ///
+    /// `ForwardIterator` shall dereference to boost::anys::any_ref or
+    /// boost::anys::any_cref, or to boost::any or boost::anys::basic_any if
+    /// `BOOST_ANY_USE_HOLDER_VALUE_OPS` is defined.
+    /// \throws std::bad_alloc or any exceptions arising from the copy
+    /// constructors of the stored types.
+    template <class ForwardIterator>
+    any_block(ForwardIterator first, ForwardIterator last)
+      : any_block()
+    {
+        build(
+            static_cast<std::size_t>(std::distance(first, last)),
+            [first]() mutable { return detail::block_source(*first++); }
+        );
+    }
+
+    /// Makes `n` copies of `value` in a single allocation.
+    ///
+    /// `Any` shall be boost::anys::any_ref or boost::anys::any_cref, or
+    /// boost::any or boost::anys::basic_any if
+    /// `BOOST_ANY_USE_HOLDER_VALUE_OPS` is defined.
+    /// \throws std::bad_alloc or any exceptions arising from the copy
+    /// constructor of the stored type.
+    template <class Any>
+    any_block(std::size_t n, const Any& value)
+      : any_block()
+    {
+        const detail::block_entry source = detail::block_source(value);
+        build(n, [source]() { return source; });
+    }
+
+    /// Copies the values of `other` into a single allocation.
+    /// \throws std::bad_alloc or any exceptions arising from the copy
+    /// constructors of the stored types.
+    any_block(const any_block& other)
+      : any_block()
+    {
+        const detail::block_entry* source = other.entries;
+        build(other.count, [source]() mutable { return *source++; });
+    }
+
+    /// Takes the values of `other`, leaving it empty.
+    /// \throws Nothing.
+    any_block(any_block&& other) noexcept
+      : raw(other.raw)
+      , entries(other.entries)
+      , count(other.count)
+    {
+        other.raw = nullptr;
+        other.entries = nullptr;
+        other.count = 0;
+    }
+
+    /// Copies `rhs`, discarding previous content.
+    /// \throws std::bad_alloc or any exceptions arising from the copy
+    /// constructors of the stored types. Strong exception guarantee.
+    any_block& operator=(const any_block& rhs)
+    {
+        any_block(rhs).swap(*this);
+        return *this;
+    }
+
+    /// Moves `rhs` into `*this`, discarding previous content.
+    /// \throws Nothing.
+    any_block& operator=(any_block&& rhs) noexcept
+    {
+        any_block(std::move(rhs)).swap(*this);
+        return *this;
+    }
+
+    ~any_block() noexcept
+    {
+        destroy(entries, count);
+        ::operator delete(raw);
+    }
+
+    /// \returns Reference to the element at `index`.
+    /// \pre `index < this->size()`
+    any_ref operator[](std::size_t index) noexcept
+    {
+        BOOST_ASSERT(index < count);
+        return detail::any_ref_access::make(entries[index].ops, entries[index].data);
+    }
+
+    /// \returns Reference to the element at `index`.
+    /// \pre `index < this->size()`
+    any_cref operator[](std::size_t index) const noexcept
+    {
+        BOOST_ASSERT(index < count);
+        return detail::any_ref_access::make(entries[index].ops, static_cast<const void*>(entries[index].data));
+    }
+
+    /// \returns Count of elements.
+    std::size_t size() const noexcept { return count; }
+
+    /// \returns `true` if there are no elements.
+    bool empty() const noexcept { return !count; }
+
+    /// Exchanges the content of `*this` and `rhs`.
+    /// \throws Nothing.
+    void swap(any_block& rhs) noexcept
+    {
+        std::swap(raw, rhs.raw);
+        std::swap(entries, rhs.entries);
+        std::swap(count, rhs.count);
+    }
+
+private:
+    /// @cond
+    // Owns a new block and the values of entries [0, constructed)
+    struct block_guard {
+        block_guard(std::size_t bytes, std::size_t alignment)
+          : raw(::operator new(bytes + detail::extra_alignment_space(alignment)))
+          , base(static_cast<unsigned char*>(detail::align_address(raw, alignment)))
+          , constructed(0)
+        {}
+
+        ~block_guard()
+        {
+            any_block::destroy(entries(), constructed);
+            ::operator delete(raw);
+        }
+
+        detail::block_entry* entries() const noexcept
+        {
+            return reinterpret_cast<detail::block_entry*>(base);
+        }
+
+        void* raw;
+        unsigned char* base;
+        std::size_t constructed;
+    };
+
+    static void destroy(detail::block_entry* values, std::size_t n) noexcept
+    {
+        while (n) {
+            --n;
+            if (values[n].ops) {
+                values[n].ops->destroy(values[n].data);
+            }
+        }
+    }
+
+    // Calls `next()` `n` times to get the sources for the size computation,
+    // then `n` times again on the original `next` to copy the values.
+    // The entries are placed first, the values follow them in order.
+    template <class Sources>
+    void build(std::size_t n, Sources next)
+    {
+        if (!n) {
+            return;
+        }
+
+        std::size_t bytes = n * sizeof(detail::block_entry);
+        std::size_t alignment = alignof(detail::block_entry);
+        Sources sizing = next;
+        for (std::size_t i = 0; i < n; ++i) {
+            const detail::block_entry source = sizing();
+            if (source.ops) {
+                bytes = detail::align_offset(bytes, source.ops->alignment) + source.ops->size;
+                if (alignment < source.ops->alignment) {
+                    alignment = source.ops->alignment;
+                }
+            }
+        }
+
+        block_guard guard(bytes, alignment);
+        std::size_t offset = n * sizeof(detail::block_entry);
+        for (; guard.constructed != n; ++guard.constructed) {
+            const detail::block_entry source = next();
+            detail::block_entry& entry = *::new (guard.entries() + guard.constructed) detail::block_entry{nullptr, nullptr};
+            if (!source.ops) {
+                continue;
+            }
+
+            BOOST_ASSERT(source.ops->copy);
+            offset = detail::align_offset(offset, source.ops->alignment);
+            void* const place = guard.base + offset;
+            source.ops->copy(place, source.data);
+            entry = detail::block_entry{source.ops, place};
+            offset += source.ops->size;
+        }
+
+        raw = guard.raw;
+        entries = guard.entries();
+        count = n;
+        guard.raw = nullptr;
+        guard.constructed = 0;
+    }
+
+    void* raw;
+    detail::block_entry* entries;
+    std::size_t count;
+    /// @endcond
+};
+
+/// Exchanges the content of `lhs` and `rhs`.
+/// \throws Nothing.
+inline void swap(any_block& lhs, any_block& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+BOOST_ANY_END_MODULE_EXPORT
+
+} // namespace anys
+
+} // namespace boost
+
+#endif  // #if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+#endif // #ifndef BOOST_ANYS_ANY_BLOCK_HPP_INCLUDED
@@ -0,0 +1,192 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/any for Documentation.
+
+#ifndef BOOST_ANYS_ANY_CAST_RANGE_HPP_INCLUDED
+#define BOOST_ANYS_ANY_CAST_RANGE_HPP_INCLUDED
+
+#include <boost/any/detail/config.hpp>
+
+#if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+/// \file boost/any/any_cast_range.hpp
+/// \brief \copybrief boost::anys::any_cast_range
+
+#ifndef BOOST_ANY_INTERFACE_UNIT
+#include <boost/config.hpp>
+#ifdef BOOST_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <boost/type_index.hpp>
+#endif  // #ifndef BOOST_ANY_INTERFACE_UNIT
+
+#include <boost/any.hpp>
+#include <boost/any/basic_any.hpp>
+#include <boost/any/unique_any.hpp>
+#include <boost/any/detail/placeholder.hpp>
+
+namespace boost {
+
+namespace anys {
+
+BOOST_ANY_BEGIN_MODULE_EXPORT
+
+/// \brief Result of boost::anys::any_cast_range.
+template <class InputIterator, class OutputIterator>
+struct any_cast_range_result {
+    /// Position of the first element that does not hold the requested type,
+    /// the end of the input if all the elements hold it.
+    InputIterator in;
+
+    /// Position after the last written pointer.
+    OutputIterator out;
+};
+
+BOOST_ANY_END_MODULE_EXPORT
+
+/// @cond
+namespace detail {
+
+    // Pointer to `ValueType` with the constness of the element
+    template <class Iterator, class ValueType>
+    using cast_range_pointer = typename std::conditional<
+        std::is_const<typename std::remove_reference<decltype(*std::declval<Iterator>())>::type>::value,
+        const ValueType,
+        ValueType
+    >::type*;
+
+    // The manager is the type identity of basic_any, so the type check is a
+    // single compare of pointers per element
+    template <class ValueType, class Iterator, class OutputIterator, std::size_t Size, std::size_t Alignment>
+    any_cast_range_result<Iterator, OutputIterator> any_cast_range_impl(
+        Iterator first, Iterator last, OutputIterator out, const basic_any<Size, Alignment>*)
+    {
+        using type = typename std::remove_cv<ValueType>::type;
+        using pointer = detail::cast_range_pointer<Iterator, ValueType>;
+        const auto manager = basic_any_access::identity_of<type, Size, Alignment>();
+
+        for (; first != last; ++first, ++out) {
+            const basic_any<Size, Alignment>& operand = *first;
+            if (basic_any_access::identity(operand) != manager) {
+                break;
+            }
+            *out = static_cast<pointer>(
+                basic_any_access::get<type>(const_cast<basic_any<Size, Alignment>&>(operand))
+            );
+        }
+        return {first, out};
+    }
+
+    // Node based anys have no type identity word, the address of the
+    // type_info of the holder is used instead. Types are compared only on
+    // a change of that address, so a run of elements of the same type costs
+    // a single type comparison.
+    template <class ValueType, class Any, class Iterator, class OutputIterator>
+    any_cast_range_result<Iterator, OutputIterator> any_cast_range_nodes(
+        Iterator first, Iterator last, OutputIterator out)
+    {
+        using type = typename std::remove_cv<ValueType>::type;
+        using pointer = detail::cast_range_pointer<Iterator, ValueType>;
+        const boost::typeindex::type_index expected = boost::typeindex::type_id<type>();
+        const boost::typeindex::type_info* run = nullptr;
+
+        for (; first != last; ++first, ++out) {
+            const Any& operand = *first;
+            const placeholder* content = placeholder_access::content(operand);
+            if (!content) {
+                break;
+            }
+
+            const boost::typeindex::type_info* current = &content->type();
+            if (current != run) {
+                if (boost::typeindex::type_index(*current) != expected) {
+                    break;
+                }
+                run = current;
+            }
+            *out = static_cast<pointer>(boost::unsafe_any_cast<type>(const_cast<Any*>(std::addressof(operand))));
+        }
+        return {first, out};
+    }
+
+    template <class ValueType, class Iterator, class OutputIterator>
+    any_cast_range_result<Iterator, OutputIterator> any_cast_range_impl(
+        Iterator first, Iterator last, OutputIterator out, const boost::any*)
+    {
+        return detail::any_cast_range_nodes<ValueType, boost::any>(first, last, out);
+    }
+
+    template <class ValueType, class Iterator, class OutputIterator>
+    any_cast_range_result<Iterator, OutputIterator> any_cast_range_impl(
+        Iterator first, Iterator last, OutputIterator out, const unique_any*)
+    {
+        return detail::any_cast_range_nodes<ValueType, unique_any>(first, last, out);
+    }
+
+} // namespace detail
+/// @endcond
+
+BOOST_ANY_BEGIN_MODULE_EXPORT
+
+/// Writes a pointer to the `ValueType` stored in each element of
+/// [`first`, `last`) to `out`, stopping at the first element that does not
+/// hold a `ValueType`.
+///
+/// Unlike the boost::any_cast per element, the stored type is checked only
+/// once per run of elements with the same type and nothing is thrown:
+/// \code
+/// std::vector<int*> ints(batch.size());
+/// auto result = boost::anys::any_cast_range<int>(batch.begin(), batch.end(), ints.begin());
+/// if (result.in != batch.end()) {
+///     report_mismatch(result.in - batch.begin());
+/// }
+/// \endcode
+///
+/// Written pointers are `const ValueType*` if the elements are constant.
+///
+/// `InputIterator` shall dereference to boost::anys::basic_any, boost::any or
+/// boost::anys::unique_any.
+///
+/// \returns The position of the first mismatching element, or `last`, and
+/// the position after the last written pointer.
+template <class ValueType, class InputIterator, class OutputIterator>
+any_cast_range_result<InputIterator, OutputIterator> any_cast_range(
+    InputIterator first, InputIterator last, OutputIterator out)
+{
+    static_assert(
+        !std::is_reference<ValueType>::value,
+        "boost::anys::any_cast_range writes pointers, ValueType shall not be a reference"
+    );
+    if (first == last) {
+        return {first, out};
+    }
+    return detail::any_cast_range_impl<ValueType>(first, last, out, std::addressof(*first));
+}
+
+/// Same as `boost::anys::any_cast_range<ValueType>(std::begin(range), std::end(range), out)`.
+template <class ValueType, class Range, class OutputIterator>
+auto any_cast_range(Range&& range, OutputIterator out)
+    -> any_cast_range_result<decltype(std::begin(range)), OutputIterator>
+{
+    return anys::any_cast_range<ValueType>(std::begin(range), std::end(range), out);
+}
+
+BOOST_ANY_END_MODULE_EXPORT
+
+} // namespace anys
+
+} // namespace boost
+
+#endif  // #if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+#endif // #ifndef BOOST_ANYS_ANY_CAST_RANGE_HPP_INCLUDED
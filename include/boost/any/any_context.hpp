@@ -0,0 +1,283 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/any for Documentation.
+
+#ifndef BOOST_ANYS_ANY_CONTEXT_HPP_INCLUDED
+#define BOOST_ANYS_ANY_CONTEXT_HPP_INCLUDED
+
+#include <boost/any/detail/config.hpp>
+
+#if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+/// \file boost/any/any_context.hpp
+/// \brief \copybrief boost::anys::basic_any_context
+
+#ifndef BOOST_ANY_INTERFACE_UNIT
+#include <boost/config.hpp>
+#ifdef BOOST_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/type_index.hpp>
+#endif  // #ifndef BOOST_ANY_INTERFACE_UNIT
+
+#include <boost/any/basic_any.hpp>
+
+namespace boost {
+
+namespace anys {
+
+/// @cond
+namespace detail {
+
+    // Each shared library with hidden inline functions has its own counter
+    inline std::size_t next_context_slot() noexcept
+    {
+        static std::atomic<std::size_t> counter{0};
+        return counter.fetch_add(1, std::memory_order_relaxed);
+    }
+
+} // namespace detail
+/// @endcond
+
+BOOST_ANY_BEGIN_MODULE_EXPORT
+
+/// \brief Key of a `T` value in boost::anys::basic_any_context.
+///
+/// Each key object takes its own slot in all the contexts, so the keys are
+/// meant to be static objects:
+/// \code
+/// static const boost::anys::context_key<trace_id> trace_key;
+/// \endcode
+template <class T>
+class context_key {
+    static_assert(
+        std::is_same<T, typename std::decay<T>::type>::value,
+        "boost::anys::context_key value types shall be decayed"
+    );
+
+public:
+    /// Takes a new slot.
+    /// \throws Nothing.
+    context_key() noexcept
+      : slot(detail::next_context_slot())
+    {}
+
+    context_key(const context_key&) = delete;
+    context_key& operator=(const context_key&) = delete;
+
+    /// \returns Index of the slot of the key.
+    std::size_t index() const noexcept { return slot; }
+
+private:
+    /// @cond
+    const std::size_t slot;
+    /// @endcond
+};
+
+/// \brief Request scoped values, like trace identifiers and deadlines,
+/// that are cheap to pass to the child tasks.
+///
+/// Values are boost::anys::basic_any<OptimizeForSize, OptimizeForAlignment>
+/// kept in a dense array indexed by the slot of their
+/// boost::anys::context_key, so a lookup is an array access and a
+/// comparison of the manager pointers instead of the type_info. Copies share
+/// the array and copy it on the first modification, so fork() is a
+/// reference count increment. Each value is shared by its own pointer, so
+/// that copy takes the pointers and never copies the values:
+/// \code
+/// static const boost::anys::context_key<deadline> deadline_key;
+///
+/// boost::anys::any_context context;
+/// context.set(deadline_key, now() + 5s);
+/// spawn([ctx = context.fork()]() {
+///     if (const deadline* d = ctx.get(deadline_key)) { ... }
+/// });
+/// \endcode
+///
+/// Different contexts that share the array may be used from different
+/// threads concurrently. A single context is not safe to modify
+/// concurrently.
+///
+/// Slots are assigned by each module separately if the shared libraries do
+/// not export the inline functions, as with hidden visibility or on Windows,
+/// so keys of different modules may get the same slot. A context shall not
+/// be shared between such modules. Lookups fall back to a checked cast if the
+/// stored value comes from another module, and debug builds assert if its
+/// type differs from the type of the key.
+template <std::size_t OptimizeForSize = 4 * sizeof(void*), std::size_t OptimizeForAlignment = alignof(void*)>
+class basic_any_context {
+public:
+    using value_type = basic_any<OptimizeForSize, OptimizeForAlignment>;
+
+    /// \post There are no values in `*this`.
+    basic_any_context() noexcept = default;
+
+    /// Shares the values of `other`.
+    /// \throws Nothing.
+    basic_any_context(const basic_any_context& other) noexcept = default;
+
+    /// Takes the values of `other`, leaving it without values.
+    /// \throws Nothing.
+    basic_any_context(basic_any_context&& other) noexcept = default;
+
+    /// Shares the values of `rhs`.
+    /// \throws Nothing.
+    basic_any_context& operator=(const basic_any_context& rhs) noexcept = default;
+
+    /// Takes the values of `rhs`, leaving it without values.
+    /// \throws Nothing.
+    basic_any_context& operator=(basic_any_context&& rhs) noexcept = default;
+
+    /// \returns Context that shares the values of `*this` until one of
+    /// them is modified.
+    /// \throws Nothing.
+    basic_any_context fork() const noexcept
+    {
+        return *this;
+    }
+
+    /// \returns Pointer to the value of `key`, nullptr if there is none.
+    template <class T>
+    const T* get(const context_key<T>& key) const noexcept
+    {
+        const std::size_t slot = key.index();
+        if (!values || slot >= values->size()) {
+            return nullptr;
+        }
+
+        const value_type* value = (*values)[slot].get();
+        if (!value) {
+            return nullptr;
+        }
+        if (detail::basic_any_access::identity(*value) == detail::basic_any_access::identity_of<T, OptimizeForSize, OptimizeForAlignment>()) {
+            return detail::basic_any_access::get<T>(*value);
+        }
+
+        // Value from another module, or a key of another module got the
+        // same slot
+        BOOST_ASSERT_MSG(
+            value->type() == boost::typeindex::type_id<T>(),
+            "boost::anys::any_context shared between modules with different key slots"
+        );
+        return anys::any_cast<T>(value);
+    }
+
+    /// \returns `true` if there is a value for `key`.
+    template <class T>
+    bool contains(const context_key<T>& key) const noexcept
+    {
+        return get(key) != nullptr;
+    }
+
+    /// Makes a `T` from `args` as the value of `key`. Contexts that shared
+    /// the values with `*this` are not affected.
+    /// \throws std::bad_alloc or any exceptions arising from the
+    /// constructor of `T`. Strong exception guarantee.
+    template <class T, class... Args>
+    void emplace(const context_key<T>& key, Args&&... args)
+    {
+        std::shared_ptr<value_type> stored = std::make_shared<value_type>();
+        detail::basic_any_access::emplace<T>(*stored, std::forward<Args>(args)...);
+        writable(key.index() + 1)[key.index()] = std::move(stored);
+    }
+
+    /// Sets the value of `key` to `value`. Contexts that shared the values
+    /// with `*this` are not affected.
+    /// \throws std::bad_alloc or any exceptions arising from the move
+    /// constructor of `T`. Strong exception guarantee.
+    template <class T>
+    void set(const context_key<T>& key, typename std::decay<T>::type value)
+    {
+        emplace(key, std::move(value));
+    }
+
+    /// Removes the value of `key`. Contexts that shared the values with
+    /// `*this` are not affected.
+    /// \returns `true` if there was a value.
+    /// \throws std::bad_alloc. Strong exception guarantee.
+    template <class T>
+    bool erase(const context_key<T>& key)
+    {
+        if (!contains(key)) {
+            return false;
+        }
+        writable(0)[key.index()].reset();
+        return true;
+    }
+
+    /// \returns `true` if `*this` and `other` share the values.
+    bool shares_with(const basic_any_context& other) const noexcept
+    {
+        return values && values == other.values;
+    }
+
+    /// Exchanges the content of `*this` and `rhs`.
+    /// \throws Nothing.
+    void swap(basic_any_context& rhs) noexcept
+    {
+        values.swap(rhs.values);
+    }
+
+private:
+    /// @cond
+    // Values are immutable once stored, so the arrays of different
+    // contexts may point to the same values
+    using storage = std::vector<std::shared_ptr<const value_type>>;
+
+    // Array that is owned by `*this` only, with at least `size` slots.
+    // Copying it copies the pointers only.
+    storage& writable(std::size_t size)
+    {
+        if (!values) {
+            values = std::make_shared<storage>();
+        } else if (values.use_count() != 1) {
+            values = std::make_shared<storage>(*values);
+        } else {
+            // Other owners released the array, their reads happen before
+            // the modifications
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+
+        if (values->size() < size) {
+            values->resize(size);
+        }
+        return *values;
+    }
+
+    std::shared_ptr<storage> values;
+    /// @endcond
+};
+
+/// Exchanges the content of `lhs` and `rhs`.
+/// \throws Nothing.
+template <std::size_t OptimizeForSize, std::size_t OptimizeForAlignment>
+void swap(basic_any_context<OptimizeForSize, OptimizeForAlignment>& lhs, basic_any_context<OptimizeForSize, OptimizeForAlignment>& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+/// boost::anys::basic_any_context with the default buffer for four pointers.
+using any_context = basic_any_context<>;
+
+BOOST_ANY_END_MODULE_EXPORT
+
+} // namespace anys
+
+} // namespace boost
+
+#endif  // #if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+#endif // #ifndef BOOST_ANYS_ANY_CONTEXT_HPP_INCLUDED
@@ -0,0 +1,411 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/any for Documentation.
+
+#ifndef BOOST_ANYS_ANY_DICT_HPP_INCLUDED
+#define BOOST_ANYS_ANY_DICT_HPP_INCLUDED
+
+#include <boost/any/detail/config.hpp>
+
+#if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+/// \file boost/any/any_dict.hpp
+/// \brief \copybrief boost::anys::basic_any_dict
+
+#ifndef BOOST_ANY_INTERFACE_UNIT
+#include <boost/config.hpp>
+#ifdef BOOST_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifndef BOOST_NO_CXX17_HDR_STRING_VIEW
+#include <string_view>
+#endif
+#endif  // #ifndef BOOST_ANY_INTERFACE_UNIT
+
+#include <boost/any/basic_any.hpp>
+
+namespace boost {
+
+namespace anys {
+
+/// @cond
+namespace detail {
+
+    // Characters of a key, whatever string type the caller has
+    struct dict_key {
+        const char* data;
+        std::size_t size;
+
+        bool operator==(const std::string& key) const noexcept
+        {
+            return key.size() == size && !std::memcmp(key.data(), data, size);
+        }
+    };
+
+    inline dict_key dict_key_of(const std::string& key) noexcept
+    {
+        return {key.data(), key.size()};
+    }
+
+    inline dict_key dict_key_of(const char* key) noexcept
+    {
+        return {key, std::strlen(key)};
+    }
+
+#ifndef BOOST_NO_CXX17_HDR_STRING_VIEW
+    inline dict_key dict_key_of(std::string_view key) noexcept
+    {
+        return {key.data(), key.size()};
+    }
+#endif
+
+    // FNV-1a, the same for all the key types
+    inline std::size_t dict_hash(dict_key key) noexcept
+    {
+        std::size_t hash = static_cast<std::size_t>(14695981039346656037ULL);
+        for (std::size_t i = 0; i < key.size; ++i) {
+            hash ^= static_cast<unsigned char>(key.data[i]);
+            hash *= static_cast<std::size_t>(1099511628211ULL);
+        }
+        return hash;
+    }
+
+} // namespace detail
+/// @endcond
+
+BOOST_ANY_BEGIN_MODULE_EXPORT
+
+/// \brief Flat map from `std::string` to
+/// boost::anys::basic_any<OptimizeForSize, OptimizeForAlignment> for the
+/// small sets of attributes.
+///
+/// Keys and values are stored right in the slots of a single array, so a
+/// value that fits into the basic_any buffer costs no allocation besides
+/// the array, and a lookup does not chase pointers. Up to 8 entries are
+/// kept densely and looked up with a linear scan without hashing; larger
+/// dictionaries become an open addressing hash table with linear probing.
+///
+/// Lookups accept `std::string`, `const char*` and `std::string_view`
+/// without making a `std::string`:
+/// \code
+/// boost::anys::any_dict attributes;
+/// attributes.insert_or_assign("width", 640);
+/// if (const int* width = attributes.get<int>("width")) {
+///     resize(*width);
+/// }
+/// \endcode
+template <std::size_t OptimizeForSize = 4 * sizeof(void*), std::size_t OptimizeForAlignment = alignof(void*)>
+class basic_any_dict {
+public:
+    using value_type = basic_any<OptimizeForSize, OptimizeForAlignment>;
+
+    /// Count of entries that are looked up with a linear scan.
+    static constexpr std::size_t linear_limit = 8;
+
+    /// \post this->empty() is true.
+    basic_any_dict() noexcept
+      : mask(0)
+      , count(0)
+    {}
+
+    /// \returns Count of entries.
+    std::size_t size() const noexcept { return count; }
+
+    /// \returns `true` if there are no entries.
+    bool empty() const noexcept { return !count; }
+
+    /// Sets the value of `key` to `value`.
+    /// \returns `true` if the key was inserted, `false` if it was assigned.
+    /// \throws std::bad_alloc or any exceptions arising from the copy or
+    /// move constructor of the stored type. Strong exception guarantee.
+    template <class ValueType>
+    bool insert_or_assign(std::string key, ValueType&& value)
+    {
+        value_type stored(std::forward<ValueType>(value));
+        return place(std::move(key), stored);
+    }
+
+    /// Makes a `ValueType` from `args` as the value of `key`.
+    /// \returns Reference to the new value.
+    /// \throws std::bad_alloc or any exceptions arising from the
+    /// constructor of `ValueType`. Strong exception guarantee.
+    template <class ValueType, class... Args>
+    ValueType& emplace(std::string key, Args&&... args)
+    {
+        value_type stored;
+        detail::basic_any_access::emplace<ValueType>(stored, std::forward<Args>(args)...);
+        const std::size_t hash = needs_hash(count + 1) ? detail::dict_hash(detail::dict_key_of(key)) : 0;
+        slot& s = slots[locate_for_insert(std::move(key), hash)];
+        s.value = std::move(stored);
+        return *detail::basic_any_access::get<ValueType>(s.value);
+    }
+
+    /// \returns Pointer to the value of `key`, nullptr if there is no such
+    /// key.
+    template <class Key>
+    value_type* find(const Key& key) noexcept
+    {
+        slot* s = find_slot(detail::dict_key_of(key));
+        return s ? &s->value : nullptr;
+    }
+
+    /// \returns Pointer to the value of `key`, nullptr if there is no such
+    /// key.
+    template <class Key>
+    const value_type* find(const Key& key) const noexcept
+    {
+        return const_cast<basic_any_dict*>(this)->find(key);
+    }
+
+    /// \returns `true` if there is a value for `key`.
+    template <class Key>
+    bool contains(const Key& key) const noexcept
+    {
+        return find(key) != nullptr;
+    }
+
+    /// \returns Pointer to the value of `key` if it is a `ValueType`,
+    /// nullptr otherwise.
+    template <class ValueType, class Key>
+    ValueType* get(const Key& key) noexcept
+    {
+        value_type* value = find(key);
+        return value ? boost::any_cast<ValueType>(value) : nullptr;
+    }
+
+    /// \returns Pointer to the value of `key` if it is a `ValueType`,
+    /// nullptr otherwise.
+    template <class ValueType, class Key>
+    const ValueType* get(const Key& key) const noexcept
+    {
+        return const_cast<basic_any_dict*>(this)->template get<ValueType>(key);
+    }
+
+    /// Removes the value of `key`.
+    /// \returns `true` if the key was removed.
+    template <class Key>
+    bool erase(const Key& key) noexcept
+    {
+        slot* s = find_slot(detail::dict_key_of(key));
+        if (!s) {
+            return false;
+        }
+
+        if (!mask) {
+            // Dense array, the last entry fills the hole
+            slot& last = slots.back();
+            if (s != &last) {
+                *s = std::move(last);
+            }
+            slots.pop_back();
+        } else {
+            erase_hashed(static_cast<std::size_t>(s - slots.data()));
+        }
+        --count;
+        return true;
+    }
+
+    /// Calls `f(const std::string& key, value_type& value)` for each entry.
+    template <class F>
+    void for_each(F&& f)
+    {
+        for (slot& s : slots) {
+            if (s.used) {
+                f(static_cast<const std::string&>(s.key), s.value);
+            }
+        }
+    }
+
+    /// Calls `f(const std::string& key, const value_type& value)` for each
+    /// entry.
+    template <class F>
+    void for_each(F&& f) const
+    {
+        for (const slot& s : slots) {
+            if (s.used) {
+                f(s.key, s.value);
+            }
+        }
+    }
+
+    /// Removes all the entries and frees the memory.
+    void clear() noexcept
+    {
+        std::vector<slot>().swap(slots);
+        mask = 0;
+        count = 0;
+    }
+
+    /// Exchanges the content of `*this` and `rhs`.
+    /// \throws Nothing.
+    void swap(basic_any_dict& rhs) noexcept
+    {
+        slots.swap(rhs.slots);
+        std::swap(mask, rhs.mask);
+        std::swap(count, rhs.count);
+    }
+
+private:
+    /// @cond
+    struct slot {
+        std::string key;
+        std::size_t hash = 0;
+        bool used = false;
+        value_type value;
+    };
+
+    bool needs_hash(std::size_t new_count) const noexcept
+    {
+        return mask || new_count > linear_limit;
+    }
+
+    slot* find_slot(detail::dict_key key) noexcept
+    {
+        if (!mask) {
+            for (slot& s : slots) {
+                if (key == s.key) {
+                    return &s;
+                }
+            }
+            return nullptr;
+        }
+
+        const std::size_t hash = detail::dict_hash(key);
+        for (std::size_t i = hash & mask; slots[i].used; i = (i + 1) & mask) {
+            if (slots[i].hash == hash && key == slots[i].key) {
+                return &slots[i];
+            }
+        }
+        return nullptr;
+    }
+
+    bool place(std::string&& key, value_type& value)
+    {
+        const std::size_t old_count = count;
+        const std::size_t hash = needs_hash(count + 1) ? detail::dict_hash(detail::dict_key_of(key)) : 0;
+        slots[locate_for_insert(std::move(key), hash)].value = std::move(value);
+        return count != old_count;
+    }
+
+    // Index of the slot of `key`, a new slot is made if there is no such
+    // key. Everything that may throw happens before the key is moved.
+    std::size_t locate_for_insert(std::string&& key, std::size_t hash)
+    {
+        if (slot* s = find_slot(detail::dict_key_of(key))) {
+            return static_cast<std::size_t>(s - slots.data());
+        }
+
+        if (!mask && count < linear_limit) {
+            slots.reserve(linear_limit);
+            slots.emplace_back();
+            slot& s = slots.back();
+            s.key = std::move(key);
+            s.used = true;
+            ++count;
+            return slots.size() - 1;
+        }
+
+        if ((count + 1) * 4 > (mask + 1) * 3) {
+            rehash(mask ? (mask + 1) * 2 : linear_limit * 4);
+        }
+
+        std::size_t i = hash & mask;
+        while (slots[i].used) {
+            i = (i + 1) & mask;
+        }
+        slots[i].key = std::move(key);
+        slots[i].hash = hash;
+        slots[i].used = true;
+        ++count;
+        return i;
+    }
+
+    void rehash(std::size_t capacity)
+    {
+        std::vector<slot> table(capacity);
+
+        // Nothing throws below
+        const std::size_t new_mask = capacity - 1;
+        for (slot& s : slots) {
+            if (!s.used) {
+                continue;
+            }
+            if (!mask) {
+                s.hash = detail::dict_hash(detail::dict_key_of(s.key));
+            }
+            std::size_t i = s.hash & new_mask;
+            while (table[i].used) {
+                i = (i + 1) & new_mask;
+            }
+            table[i] = std::move(s);
+        }
+        slots.swap(table);
+        mask = new_mask;
+    }
+
+    // Backward shift deletion keeps the probe sequences without tombstones
+    void erase_hashed(std::size_t hole) noexcept
+    {
+        std::size_t j = hole;
+        for (;;) {
+            j = (j + 1) & mask;
+            if (!slots[j].used) {
+                break;
+            }
+
+            // Entry stays if its home is cyclically in (hole, j]
+            const std::size_t home = slots[j].hash & mask;
+            const bool stays = (hole <= j)
+                ? (hole < home && home <= j)
+                : (hole < home || home <= j);
+            if (!stays) {
+                slots[hole] = std::move(slots[j]);
+                hole = j;
+            }
+        }
+
+        slot& s = slots[hole];
+        s.key.clear();
+        s.hash = 0;
+        s.used = false;
+        detail::basic_any_access::reset(s.value);
+    }
+
+    std::vector<slot> slots;
+    std::size_t mask;
+    std::size_t count;
+    /// @endcond
+};
+
+/// Exchanges the content of `lhs` and `rhs`.
+/// \throws Nothing.
+template <std::size_t OptimizeForSize, std::size_t OptimizeForAlignment>
+void swap(basic_any_dict<OptimizeForSize, OptimizeForAlignment>& lhs, basic_any_dict<OptimizeForSize, OptimizeForAlignment>& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+/// boost::anys::basic_any_dict with the default buffer for four pointers.
+using any_dict = basic_any_dict<>;
+
+BOOST_ANY_END_MODULE_EXPORT
+
+} // namespace anys
+
+} // namespace boost
+
+#endif  // #if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+#endif // #ifndef BOOST_ANYS_ANY_DICT_HPP_INCLUDED
@@ -0,0 +1,410 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/any for Documentation.
+
+#ifndef BOOST_ANYS_ANY_QUEUE_HPP_INCLUDED
+#define BOOST_ANYS_ANY_QUEUE_HPP_INCLUDED
+
+#include <boost/any/detail/config.hpp>
+
+#if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+/// \file boost/any/any_queue.hpp
+/// \brief \copybrief boost::anys::spsc_any_queue
+
+#ifndef BOOST_ANY_INTERFACE_UNIT
+#include <boost/config.hpp>
+#ifdef BOOST_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#endif  // #ifndef BOOST_ANY_INTERFACE_UNIT
+
+#include <boost/any/basic_any.hpp>
+
+namespace boost {
+
+namespace anys {
+
+/// @cond
+namespace detail {
+
+    // Positions written by different threads are kept this far apart to
+    // avoid false sharing
+    constexpr std::size_t queue_padding = 64;
+
+    // Starts and fills a cache line of its own, so the neighbouring members
+    // that are read by all the threads do not share it with the value
+    template <class T>
+    struct alignas(queue_padding) padded {
+        T value;
+    };
+
+    static_assert(sizeof(padded<std::size_t>) == queue_padding, "Padded positions shall take a whole cache line");
+
+    inline std::size_t queue_capacity(std::size_t capacity) noexcept
+    {
+        std::size_t result = 2;
+        while (result < capacity) {
+            result *= 2;
+        }
+        return result;
+    }
+
+} // namespace detail
+/// @endcond
+
+BOOST_ANY_BEGIN_MODULE_EXPORT
+
+/// \brief Bounded single producer single consumer queue of
+/// boost::anys::basic_any<OptimizeForSize, OptimizeForAlignment> messages.
+///
+/// Messages are constructed right in the slots of the ring buffer and are
+/// visited in place by the consumer, so passing a message that fits into
+/// the basic_any buffer does not allocate:
+/// \code
+/// boost::anys::spsc_any_queue<32, 8> queue(1024);
+///
+/// // Producer thread
+/// queue.try_emplace<std::pair<int, double>>(1, 2.0);
+///
+/// // Consumer thread
+/// queue.try_consume([](boost::anys::basic_any<32, 8>& message) {
+///     handle(boost::any_cast<std::pair<int, double>&>(message));
+/// });
+/// \endcode
+///
+/// Producer and consumer operations never block or take locks. At most
+/// one thread may produce and at most one thread may consume at a time.
+template <std::size_t OptimizeForSize = sizeof(void*), std::size_t OptimizeForAlignment = alignof(void*)>
+class spsc_any_queue {
+public:
+    using value_type = basic_any<OptimizeForSize, OptimizeForAlignment>;
+
+    /// Makes a queue for at least `capacity` messages. The capacity is
+    /// rounded up to a power of two.
+    /// \throws std::bad_alloc
+    explicit spsc_any_queue(std::size_t capacity)
+      : mask(detail::queue_capacity(capacity) - 1)
+      , slots(new value_type[mask + 1])
+    {
+        head.value.store(0, std::memory_order_relaxed);
+        tail.value.store(0, std::memory_order_relaxed);
+        cached_head.value = 0;
+        cached_tail.value = 0;
+    }
+
+    spsc_any_queue(const spsc_any_queue&) = delete;
+    spsc_any_queue& operator=(const spsc_any_queue&) = delete;
+
+    /// Constructs a `ValueType` from `args` in the next free slot.
+    /// Producer operation.
+    /// \returns `false` if the queue is full, `args` are not used in that case.
+    /// \throws std::bad_alloc or any exceptions arising from the constructor
+    /// of `ValueType`. The queue is not modified if an exception is thrown.
+    template <class ValueType, class... Args>
+    bool try_emplace(Args&&... args)
+    {
+        const std::size_t t = tail.value.load(std::memory_order_relaxed);
+        if (t - cached_head.value > mask) {
+            cached_head.value = head.value.load(std::memory_order_acquire);
+            if (t - cached_head.value > mask) {
+                return false;
+            }
+        }
+
+        detail::basic_any_access::emplace<typename std::decay<ValueType>::type>(
+            slots[t & mask], std::forward<Args>(args)...
+        );
+        tail.value.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Moves `value` into the next free slot. Producer operation.
+    /// \returns `false` if the queue is full, `value` is not modified in
+    /// that case.
+    /// \throws Nothing.
+    bool try_push(value_type&& value) noexcept
+    {
+        const std::size_t t = tail.value.load(std::memory_order_relaxed);
+        if (t - cached_head.value > mask) {
+            cached_head.value = head.value.load(std::memory_order_acquire);
+            if (t - cached_head.value > mask) {
+                return false;
+            }
+        }
+
+        slots[t & mask] = std::move(value);
+        tail.value.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Calls `visitor(value_type&)` for the oldest message in place and
+    /// removes it. The message is removed even if `visitor` throws.
+    /// Consumer operation.
+    /// \returns `false` if the queue is empty.
+    template <class Visitor>
+    bool try_consume(Visitor&& visitor)
+    {
+        const std::size_t h = head.value.load(std::memory_order_relaxed);
+        if (h == cached_tail.value) {
+            cached_tail.value = tail.value.load(std::memory_order_acquire);
+            if (h == cached_tail.value) {
+                return false;
+            }
+        }
+
+        const consume_guard guard{*this, h};
+        visitor(slots[h & mask]);
+        return true;
+    }
+
+    /// Moves the oldest message into `value`. Consumer operation.
+    /// \returns `false` if the queue is empty.
+    /// \throws Nothing.
+    bool try_pop(value_type& value) noexcept
+    {
+        return try_consume([&value](value_type& message) noexcept {
+            value = std::move(message);
+        });
+    }
+
+    /// \returns `true` if there were no messages at the moment of the call.
+    bool empty() const noexcept
+    {
+        return head.value.load(std::memory_order_acquire) == tail.value.load(std::memory_order_acquire);
+    }
+
+    /// \returns Maximal count of messages in the queue.
+    std::size_t capacity() const noexcept { return mask + 1; }
+
+private:
+    /// @cond
+    // Destroys the consumed message and frees the slot even if the
+    // visitor throws
+    struct consume_guard {
+        spsc_any_queue& queue;
+        std::size_t position;
+
+        ~consume_guard()
+        {
+            detail::basic_any_access::reset(queue.slots[position & queue.mask]);
+            queue.head.value.store(position + 1, std::memory_order_release);
+        }
+    };
+
+    const std::size_t mask;
+    std::unique_ptr<value_type[]> slots;
+
+    // Written by the consumer
+    detail::padded<std::atomic<std::size_t>> head;
+    detail::padded<std::size_t> cached_tail;
+
+    // Written by the producer
+    detail::padded<std::atomic<std::size_t>> tail;
+    detail::padded<std::size_t> cached_head;
+    /// @endcond
+};
+
+/// \brief Bounded multiple producers multiple consumers queue of
+/// boost::anys::basic_any<OptimizeForSize, OptimizeForAlignment> messages.
+///
+/// Same interface as boost::anys::spsc_any_queue, but any count of threads
+/// may produce and consume concurrently. Each slot carries a sequence
+/// number, so producers and consumers claim slots with a single compare
+/// and swap on a shared position and never wait for each other, unless the
+/// queue is full or empty.
+template <std::size_t OptimizeForSize = sizeof(void*), std::size_t OptimizeForAlignment = alignof(void*)>
+class mpmc_any_queue {
+public:
+    using value_type = basic_any<OptimizeForSize, OptimizeForAlignment>;
+
+    /// Makes a queue for at least `capacity` messages. The capacity is
+    /// rounded up to a power of two.
+    /// \throws std::bad_alloc
+    explicit mpmc_any_queue(std::size_t capacity)
+      : mask(detail::queue_capacity(capacity) - 1)
+      , cells(new cell[mask + 1])
+    {
+        for (std::size_t i = 0; i <= mask; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+            cells[i].abandoned = false;
+        }
+        enqueue_position.value.store(0, std::memory_order_relaxed);
+        dequeue_position.value.store(0, std::memory_order_relaxed);
+    }
+
+    mpmc_any_queue(const mpmc_any_queue&) = delete;
+    mpmc_any_queue& operator=(const mpmc_any_queue&) = delete;
+
+    /// Constructs a `ValueType` from `args` in the next free slot.
+    /// \returns `false` if the queue is full, `args` are not used in that case.
+    /// \throws std::bad_alloc or any exceptions arising from the constructor
+    /// of `ValueType`. No message is added if an exception is thrown.
+    template <class ValueType, class... Args>
+    bool try_emplace(Args&&... args)
+    {
+        cell* const c = claim_for_write();
+        if (!c) {
+            return false;
+        }
+
+        // The claimed slot is skipped by consumers if construction throws
+        publish_guard guard{*c, true};
+        detail::basic_any_access::emplace<typename std::decay<ValueType>::type>(
+            c->value, std::forward<Args>(args)...
+        );
+        guard.abandoned = false;
+        return true;
+    }
+
+    /// Moves `value` into the next free slot.
+    /// \returns `false` if the queue is full, `value` is not modified in
+    /// that case.
+    /// \throws Nothing.
+    bool try_push(value_type&& value) noexcept
+    {
+        cell* const c = claim_for_write();
+        if (!c) {
+            return false;
+        }
+
+        c->value = std::move(value);
+        c->abandoned = false;
+        c->sequence.store(c->position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Calls `visitor(value_type&)` for the oldest message in place and
+    /// removes it. The message is removed even if `visitor` throws.
+    /// \returns `false` if the queue is empty.
+    template <class Visitor>
+    bool try_consume(Visitor&& visitor)
+    {
+        for (;;) {
+            cell* const c = claim_for_read();
+            if (!c) {
+                return false;
+            }
+
+            const consume_guard guard{*c, mask + 1};
+            if (!c->abandoned) {
+                visitor(c->value);
+                return true;
+            }
+        }
+    }
+
+    /// Moves the oldest message into `value`.
+    /// \returns `false` if the queue is empty.
+    /// \throws Nothing.
+    bool try_pop(value_type& value) noexcept
+    {
+        return try_consume([&value](value_type& message) noexcept {
+            value = std::move(message);
+        });
+    }
+
+    /// \returns Maximal count of messages in the queue.
+    std::size_t capacity() const noexcept { return mask + 1; }
+
+private:
+    /// @cond
+    struct cell {
+        std::atomic<std::size_t> sequence;
+        std::size_t position;
+        bool abandoned;
+        value_type value;
+    };
+
+    // Makes the claimed cell visible to consumers
+    struct publish_guard {
+        cell& c;
+        bool abandoned;
+
+        ~publish_guard()
+        {
+            c.abandoned = abandoned;
+            c.sequence.store(c.position + 1, std::memory_order_release);
+        }
+    };
+
+    // Destroys the consumed message and frees the cell for the next round
+    // even if the visitor throws
+    struct consume_guard {
+        cell& c;
+        std::size_t capacity;
+
+        ~consume_guard()
+        {
+            detail::basic_any_access::reset(c.value);
+            c.sequence.store(c.position + capacity, std::memory_order_release);
+        }
+    };
+
+    // Vyukov's bounded queue: a cell is free for the position `p` if its
+    // sequence equals `p` and is ready for reading if it equals `p + 1`
+    cell* claim_for_write() noexcept
+    {
+        std::size_t p = enqueue_position.value.load(std::memory_order_relaxed);
+        for (;;) {
+            cell& c = cells[p & mask];
+            const std::size_t sequence = c.sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence - p);
+            if (diff == 0) {
+                if (enqueue_position.value.compare_exchange_weak(p, p + 1, std::memory_order_relaxed)) {
+                    c.position = p;
+                    return &c;
+                }
+            } else if (diff < 0) {
+                return nullptr;
+            } else {
+                p = enqueue_position.value.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    cell* claim_for_read() noexcept
+    {
+        std::size_t p = dequeue_position.value.load(std::memory_order_relaxed);
+        for (;;) {
+            cell& c = cells[p & mask];
+            const std::size_t sequence = c.sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence - (p + 1));
+            if (diff == 0) {
+                if (dequeue_position.value.compare_exchange_weak(p, p + 1, std::memory_order_relaxed)) {
+                    return &c;
+                }
+            } else if (diff < 0) {
+                return nullptr;
+            } else {
+                p = dequeue_position.value.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    const std::size_t mask;
+    std::unique_ptr<cell[]> cells;
+    detail::padded<std::atomic<std::size_t>> enqueue_position;
+    detail::padded<std::atomic<std::size_t>> dequeue_position;
+    /// @endcond
+};
+
+BOOST_ANY_END_MODULE_EXPORT
+
+} // namespace anys
+
+} // namespace boost
+
+#endif  // #if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+#endif // #ifndef BOOST_ANYS_ANY_QUEUE_HPP_INCLUDED
@@ -0,0 +1,367 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/any for Documentation.
+
+#ifndef BOOST_ANYS_ANY_RECORD_HPP_INCLUDED
+#define BOOST_ANYS_ANY_RECORD_HPP_INCLUDED
+
+#include <boost/any/detail/config.hpp>
+
+#if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+/// \file boost/any/any_record.hpp
+/// \brief \copybrief boost::anys::any_record
+
+#ifndef BOOST_ANY_INTERFACE_UNIT
+#include <boost/config.hpp>
+#ifdef BOOST_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/type_index.hpp>
+#endif  // #ifndef BOOST_ANY_INTERFACE_UNIT
+
+#include <boost/any/any_ref.hpp>
+#include <boost/any/bad_any_cast.hpp>
+#include <boost/any/basic_any.hpp>
+#include <boost/any/detail/erased_array.hpp>
+#include <boost/any/detail/value_ops.hpp>
+
+namespace boost {
+
+namespace anys {
+
+BOOST_ANY_BEGIN_MODULE_EXPORT
+
+/// \brief Runtime description of the fields of boost::anys::any_record.
+///
+/// Each field has a type and a default value, that is copied into the field
+/// on construction of a record. Offsets of the fields are computed on
+/// addition, so the field access in a record is an offset arithmetic.
+///
+/// The schema shall outlive the records that use it and shall not be
+/// modified while such records exist.
+class record_schema {
+public:
+    /// \post this->field_count() == 0
+    record_schema() = default;
+
+    /// Adds a field of the type stored in `prototype`, the `prototype` value
+    /// becomes the default value of the field.
+    /// Requires `BOOST_ANY_USE_HOLDER_VALUE_OPS`, see boost::anys::basic_any.
+    /// \returns Index of the new field.
+    /// \throws boost::bad_any_cast if `prototype` is empty, std::bad_alloc or
+    /// any exceptions arising from the copy constructor of the stored type.
+    /// Strong exception guarantee.
+    template <std::size_t OptimizeForSize, std::size_t OptimizeForAlignment>
+    std::size_t add_field(const basic_any<OptimizeForSize, OptimizeForAlignment>& prototype)
+    {
+        const detail::value_ops* ops = detail::basic_any_access::ops(prototype);
+        if (!ops) {
+            detail::throw_bad_any_cast();
+        }
+
+        basic_any<OptimizeForSize, OptimizeForAlignment> tmp(prototype);
+        return add_field_impl(detail::erased_value(*ops, detail::basic_any_access::address(tmp)));
+    }
+
+    /// Adds a field of `std::decay_t<ValueType>` with `default_value` as the
+    /// default value.
+    /// \returns Index of the new field.
+    /// \throws std::bad_alloc or any exceptions arising from the copy or move
+    /// constructor of `ValueType`. Strong exception guarantee.
+    template <class ValueType>
+    typename std::enable_if<!anys::detail::is_basic_any<typename std::decay<ValueType>::type>::value, std::size_t>::type
+    add_field(ValueType&& default_value)
+    {
+        using type = typename std::decay<ValueType>::type;
+        static_assert(
+            !anys::detail::is_some_any<type>::value,
+            "boost::anys::record_schema::add_field(T) shall not be used with any types other than "
+            "boost::anys::basic_any"
+        );
+        static_assert(
+            std::is_copy_constructible<type>::value,
+            "boost::anys::any_record requires copy constructible types"
+        );
+        type value(std::forward<ValueType>(default_value));
+        return add_field_impl(detail::erased_value(
+            detail::value_ops_of<type>::value, std::addressof(value)
+        ));
+    }
+
+    /// \returns Count of the fields.
+    std::size_t field_count() const noexcept { return fields.size(); }
+
+    /// \returns The type of the field at `index`.
+    const boost::typeindex::type_info& field_type(std::size_t index) const noexcept
+    {
+        BOOST_ASSERT(index < fields.size());
+        return fields[index].prototype.ops()->type();
+    }
+
+    /// \returns Offset of the field at `index` from the start of the record
+    /// storage.
+    std::size_t field_offset(std::size_t index) const noexcept
+    {
+        BOOST_ASSERT(index < fields.size());
+        return fields[index].offset;
+    }
+
+    /// \returns Size in bytes of the storage of a record.
+    std::size_t record_size() const noexcept { return size; }
+
+    /// \returns Alignment of the storage of a record.
+    std::size_t record_alignment() const noexcept { return alignment; }
+
+private:
+    /// @cond
+    friend class any_record;
+
+    struct field {
+        detail::erased_value prototype;
+        std::size_t offset;
+    };
+
+    std::size_t add_field_impl(detail::erased_value&& prototype)
+    {
+        const detail::value_ops& ops = *prototype.ops();
+        const std::size_t offset = (size + ops.alignment - 1) / ops.alignment * ops.alignment;
+        fields.push_back(field{std::move(prototype), offset});
+        size = offset + ops.size;
+        if (alignment < ops.alignment) {
+            alignment = ops.alignment;
+        }
+        return fields.size() - 1;
+    }
+
+    std::vector<field> fields;
+    std::size_t size = 0;
+    std::size_t alignment = 1;
+    /// @endcond
+};
+
+/// \brief Record with fields of types that are known only at runtime, all the
+/// fields are stored in a single allocation.
+///
+/// Unlike a `std::vector<boost::any>` per record, there is one allocation per
+/// record and the field access is an offset arithmetic with one type check:
+/// \code
+/// boost::anys::record_schema schema;
+/// const auto id = schema.add_field(std::uint64_t{0});
+/// const auto name = schema.add_field(boost::anys::basic_any<>(std::string()));
+///
+/// boost::anys::any_record record(schema);
+/// record.get<std::uint64_t>(id) = 42;
+/// record.get<std::string>(name) = "answer";
+/// assert(boost::any_cast<std::string&>(record.field(name)) == "answer");
+/// \endcode
+class any_record {
+public:
+    /// Constructs the fields of `schema` from their default values.
+    /// \throws std::bad_alloc or any exceptions arising from the copy
+    /// constructors of the field types.
+    explicit any_record(const record_schema& schema)
+      : schema_(&schema)
+      , raw(nullptr)
+      , data(nullptr)
+    {
+        storage_guard guard(schema);
+        for (; guard.constructed != schema.fields.size(); ++guard.constructed) {
+            const detail::erased_value& prototype = schema.fields[guard.constructed].prototype;
+            prototype.ops()->copy(guard.at(guard.constructed), prototype.data());
+        }
+        take(guard);
+    }
+
+    /// Copies the fields of `other`.
+    /// \throws std::bad_alloc or any exceptions arising from the copy
+    /// constructors of the field types.
+    any_record(const any_record& other)
+      : schema_(other.schema_)
+      , raw(nullptr)
+      , data(nullptr)
+    {
+        BOOST_ASSERT_MSG(other.data, "Copy of a moved out boost::anys::any_record");
+        storage_guard guard(*schema_);
+        for (; guard.constructed != schema_->fields.size(); ++guard.constructed) {
+            schema_->fields[guard.constructed].prototype.ops()->copy(
+                guard.at(guard.constructed), other.at(guard.constructed)
+            );
+        }
+        take(guard);
+    }
+
+    /// Takes the storage of `other`. Only assignment and destruction are
+    /// allowed for `other` after that.
+    /// \throws Nothing.
+    any_record(any_record&& other) noexcept
+      : schema_(other.schema_)
+      , raw(other.raw)
+      , data(other.data)
+    {
+        other.raw = nullptr;
+        other.data = nullptr;
+    }
+
+    /// Copies `rhs`, discarding previous content.
+    /// \throws std::bad_alloc or any exceptions arising from the copy
+    /// constructors of the field types. Strong exception guarantee.
+    any_record& operator=(const any_record& rhs)
+    {
+        any_record(rhs).swap(*this);
+        return *this;
+    }
+
+    /// Moves `rhs` into `*this`, discarding previous content.
+    /// \throws Nothing.
+    any_record& operator=(any_record&& rhs) noexcept
+    {
+        any_record(std::move(rhs)).swap(*this);
+        return *this;
+    }
+
+    ~any_record() noexcept
+    {
+        if (data) {
+            destroy_fields(schema_->fields.size());
+        }
+        ::operator delete(raw);
+    }
+
+    /// \returns Reference to the field at `index`.
+    /// \throws boost::bad_any_cast if the field type is not `ValueType`.
+    template <class ValueType>
+    ValueType& get(std::size_t index)
+    {
+        BOOST_ASSERT(index < schema_->fields.size());
+        if (!detail::is_value_ops_of<typename std::remove_cv<ValueType>::type>(schema_->fields[index].prototype.ops())) {
+            detail::throw_bad_any_cast();
+        }
+        return *static_cast<ValueType*>(at(index));
+    }
+
+    /// \returns Reference to the field at `index`.
+    /// \throws boost::bad_any_cast if the field type is not `ValueType`.
+    template <class ValueType>
+    const ValueType& get(std::size_t index) const
+    {
+        return const_cast<any_record&>(*this).get<const ValueType>(index);
+    }
+
+    /// \returns Reference to the field at `index`.
+    any_ref field(std::size_t index) noexcept
+    {
+        BOOST_ASSERT(index < schema_->fields.size());
+        return detail::any_ref_access::make(schema_->fields[index].prototype.ops(), at(index));
+    }
+
+    /// \returns Reference to the field at `index`.
+    any_cref field(std::size_t index) const noexcept
+    {
+        return const_cast<any_record&>(*this).field(index);
+    }
+
+    /// \returns Count of the fields.
+    std::size_t size() const noexcept { return schema_->field_count(); }
+
+    /// \returns The schema of the record.
+    const record_schema& schema() const noexcept { return *schema_; }
+
+    /// Exchanges the content of `*this` and `rhs`.
+    /// \throws Nothing.
+    void swap(any_record& rhs) noexcept
+    {
+        std::swap(schema_, rhs.schema_);
+        std::swap(raw, rhs.raw);
+        std::swap(data, rhs.data);
+    }
+
+private:
+    /// @cond
+    // Owns a new storage and the fields in [0, constructed) of it
+    struct storage_guard {
+        explicit storage_guard(const record_schema& record_schema)
+          : schema(record_schema)
+          , raw(::operator new(
+                record_schema.size + detail::extra_alignment_space(record_schema.alignment)
+            ))
+          , data(detail::align_address(raw, record_schema.alignment))
+          , constructed(0)
+        {}
+
+        ~storage_guard()
+        {
+            while (constructed) {
+                --constructed;
+                schema.fields[constructed].prototype.ops()->destroy(at(constructed));
+            }
+            ::operator delete(raw);
+        }
+
+        void* at(std::size_t index) const noexcept
+        {
+            return static_cast<unsigned char*>(data) + schema.fields[index].offset;
+        }
+
+        const record_schema& schema;
+        void* raw;
+        void* data;
+        std::size_t constructed;
+    };
+
+    void take(storage_guard& guard) noexcept
+    {
+        raw = guard.raw;
+        data = guard.data;
+        guard.raw = nullptr;
+        guard.constructed = 0;
+    }
+
+    void* at(std::size_t index) const noexcept
+    {
+        BOOST_ASSERT_MSG(data, "Access to a moved out boost::anys::any_record");
+        return static_cast<unsigned char*>(data) + schema_->fields[index].offset;
+    }
+
+    void destroy_fields(std::size_t count) noexcept
+    {
+        while (count) {
+            --count;
+            schema_->fields[count].prototype.ops()->destroy(at(count));
+        }
+    }
+
+    const record_schema* schema_;
+    void* raw;
+    void* data;
+    /// @endcond
+};
+
+/// Exchanges the content of `lhs` and `rhs`.
+/// \throws Nothing.
+inline void swap(any_record& lhs, any_record& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+BOOST_ANY_END_MODULE_EXPORT
+
+} // namespace anys
+
+} // namespace boost
+
+#endif  // #if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+#endif // #ifndef BOOST_ANYS_ANY_RECORD_HPP_INCLUDED
@@ -0,0 +1,288 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/any for Documentation.
+
+#ifndef BOOST_ANYS_ANY_REF_HPP_INCLUDED
+#define BOOST_ANYS_ANY_REF_HPP_INCLUDED
+
+#include <boost/any/detail/config.hpp>
+
+#if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+/// \file boost/any/any_ref.hpp
+/// \brief Non-owning views to a value of a type known only at runtime.
+
+#ifndef BOOST_ANY_INTERFACE_UNIT
+#include <boost/config.hpp>
+#ifdef BOOST_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include <memory>  // for std::addressof
+#include <type_traits>
+
+#include <boost/type_index.hpp>
+#endif  // #ifndef BOOST_ANY_INTERFACE_UNIT
+
+#include <boost/any/bad_any_cast.hpp>
+#include <boost/any/fwd.hpp>
+#include <boost/any/detail/value_ops.hpp>
+
+namespace boost {
+
+namespace anys {
+
+/// @cond
+namespace detail {
+    struct any_ref_access;
+} // namespace detail
+/// @endcond
+
+BOOST_ANY_BEGIN_MODULE_EXPORT
+
+/// \brief Non-owning reference to a mutable value of any type, or to nothing.
+///
+/// The containers of this library that keep values of different types in
+/// their own storage return boost::anys::any_ref to provide
+/// boost::any_cast compatible access to their elements without creating
+/// an owning any.
+///
+/// Copying the boost::anys::any_ref copies the reference, not the value.
+class any_ref {
+public:
+    /// \post this->empty() is true.
+    constexpr any_ref() noexcept
+      : ops(nullptr)
+      , ptr(nullptr)
+    {}
+
+    /// Makes a reference to `value`.
+    /// \post this->type() is `ValueType`.
+    template <class ValueType>
+    explicit any_ref(ValueType& value, typename std::enable_if<
+        !std::is_same<typename std::remove_cv<ValueType>::type, any_ref>::value
+        && !std::is_const<ValueType>::value
+    >::type* = nullptr) noexcept
+      : ops(&detail::value_ops_of<ValueType>::value)
+      , ptr(std::addressof(value))
+    {}
+
+    /// \returns `true` if instance does not refer to a value, otherwise `false`.
+    bool empty() const noexcept { return !ptr; }
+
+    /// \returns the `typeid` of the referenced value if the instance
+    /// is not empty, otherwise `typeid(void)`.
+    const boost::typeindex::type_info& type() const noexcept
+    {
+        return ops ? ops->type() : boost::typeindex::type_id<void>().type_info();
+    }
+
+private:
+    /// @cond
+    friend class any_cref;
+    friend struct detail::any_ref_access;
+
+    any_ref(const detail::value_ops* value_ops, void* value) noexcept
+      : ops(value_ops)
+      , ptr(value)
+    {}
+
+    const detail::value_ops* ops;
+    void* ptr;
+    /// @endcond
+};
+
+/// \brief Non-owning reference to a constant value of any type, or to nothing.
+///
+/// \copydetails boost::anys::any_ref
+class any_cref {
+public:
+    /// \post this->empty() is true.
+    constexpr any_cref() noexcept
+      : ops(nullptr)
+      , ptr(nullptr)
+    {}
+
+    /// Makes a reference to `value`.
+    /// \post this->type() is `ValueType`.
+    template <class ValueType>
+    explicit any_cref(const ValueType& value, typename std::enable_if<
+        !std::is_same<ValueType, any_cref>::value
+        && !std::is_same<ValueType, any_ref>::value
+    >::type* = nullptr) noexcept
+      : ops(&detail::value_ops_of<ValueType>::value)
+      , ptr(std::addressof(value))
+    {}
+
+    /// Makes a reference to the value referenced by `other`.
+    any_cref(any_ref other) noexcept
+      : ops(other.ops)
+      , ptr(other.ptr)
+    {}
+
+    /// \returns `true` if instance does not refer to a value, otherwise `false`.
+    bool empty() const noexcept { return !ptr; }
+
+    /// \returns the `typeid` of the referenced value if the instance
+    /// is not empty, otherwise `typeid(void)`.
+    const boost::typeindex::type_info& type() const noexcept
+    {
+        return ops ? ops->type() : boost::typeindex::type_id<void>().type_info();
+    }
+
+private:
+    /// @cond
+    friend struct detail::any_ref_access;
+
+    any_cref(const detail::value_ops* value_ops, const void* value) noexcept
+      : ops(value_ops)
+      , ptr(value)
+    {}
+
+    const detail::value_ops* ops;
+    const void* ptr;
+    /// @endcond
+};
+
+BOOST_ANY_END_MODULE_EXPORT
+
+/// @cond
+namespace detail {
+
+    struct any_ref_access {
+        static any_ref make(const value_ops* ops, void* value) noexcept
+        {
+            return any_ref(ops, value);
+        }
+
+        static any_cref make(const value_ops* ops, const void* value) noexcept
+        {
+            return any_cref(ops, value);
+        }
+
+        template <class Ref>
+        static const value_ops* ops(const Ref& ref) noexcept
+        {
+            return ref.ops;
+        }
+
+        template <class Ref>
+        static auto data(const Ref& ref) noexcept -> decltype(ref.ptr)
+        {
+            return ref.ptr;
+        }
+    };
+
+} // namespace detail
+/// @endcond
+
+BOOST_ANY_BEGIN_MODULE_EXPORT
+
+/// @cond
+template<typename ValueType>
+inline ValueType* unsafe_any_cast(any_ref* operand) noexcept
+{
+    return static_cast<ValueType*>(detail::any_ref_access::data(*operand));
+}
+
+template<typename ValueType>
+inline const ValueType* unsafe_any_cast(const any_ref* operand) noexcept
+{
+    return static_cast<const ValueType*>(detail::any_ref_access::data(*operand));
+}
+
+template<typename ValueType>
+inline const ValueType* unsafe_any_cast(const any_cref* operand) noexcept
+{
+    return static_cast<const ValueType*>(detail::any_ref_access::data(*operand));
+}
+/// @endcond
+
+/// \returns Pointer to a `ValueType` referenced by `operand`, nullptr if
+/// `operand` does not refer to the specified `ValueType`.
+template<typename ValueType>
+ValueType* any_cast(any_ref* operand) noexcept
+{
+    using type = typename std::remove_cv<ValueType>::type;
+    return operand && detail::is_value_ops_of<type>(detail::any_ref_access::ops(*operand))
+        ? anys::unsafe_any_cast<type>(operand)
+        : nullptr;
+}
+
+/// \returns Const pointer to a `ValueType` referenced by `operand`, nullptr
+/// if `operand` does not refer to the specified `ValueType`.
+template<typename ValueType>
+inline const ValueType* any_cast(const any_ref* operand) noexcept
+{
+    return anys::any_cast<ValueType>(const_cast<any_ref*>(operand));
+}
+
+/// \returns Const pointer to a `ValueType` referenced by `operand`, nullptr
+/// if `operand` does not refer to the specified `ValueType`.
+template<typename ValueType>
+const ValueType* any_cast(const any_cref* operand) noexcept
+{
+    using type = typename std::remove_cv<ValueType>::type;
+    return operand && detail::is_value_ops_of<type>(detail::any_ref_access::ops(*operand))
+        ? anys::unsafe_any_cast<type>(operand)
+        : nullptr;
+}
+
+/// \returns `ValueType` referenced by `operand`.
+/// \throws boost::bad_any_cast if `operand` does not refer to the specified
+/// `ValueType`.
+template<typename ValueType>
+ValueType any_cast(any_ref operand)
+{
+    using nonref = typename std::remove_reference<ValueType>::type;
+
+    nonref* result = anys::any_cast<nonref>(std::addressof(operand));
+    if (!result)
+        detail::throw_bad_any_cast();
+
+    return static_cast<typename std::conditional<
+        std::is_reference<ValueType>::value,
+        ValueType,
+        typename std::add_lvalue_reference<ValueType>::type
+    >::type>(*result);
+}
+
+/// \returns `ValueType` referenced by `operand`.
+/// \throws boost::bad_any_cast if `operand` does not refer to the specified
+/// `ValueType`.
+template<typename ValueType>
+ValueType any_cast(any_cref operand)
+{
+    using nonref = typename std::remove_reference<ValueType>::type;
+    static_assert(
+        !std::is_reference<ValueType>::value || std::is_const<nonref>::value,
+        "boost::any_cast shall not be used for getting nonconst references to constant values"
+    );
+
+    const nonref* result = anys::any_cast<nonref>(std::addressof(operand));
+    if (!result)
+        detail::throw_bad_any_cast();
+
+    return *result;
+}
+
+BOOST_ANY_END_MODULE_EXPORT
+
+} // namespace anys
+
+BOOST_ANY_BEGIN_MODULE_EXPORT
+
+using boost::anys::any_cast;
+using boost::anys::unsafe_any_cast;
+
+BOOST_ANY_END_MODULE_EXPORT
+
+} // namespace boost
+
+#endif  // #if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+#endif // #ifndef BOOST_ANYS_ANY_REF_HPP_INCLUDED
@@ -0,0 +1,312 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/any for Documentation.
+
+#ifndef BOOST_ANYS_ANY_SEGMENTS_HPP_INCLUDED
+#define BOOST_ANYS_ANY_SEGMENTS_HPP_INCLUDED
+
+#include <boost/any/detail/config.hpp>
+
+#if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+/// \file boost/any/any_segments.hpp
+/// \brief \copybrief boost::anys::any_segments
+
+#ifndef BOOST_ANY_INTERFACE_UNIT
+#include <boost/config.hpp>
+#ifdef BOOST_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include <cstddef>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/assert.hpp>
+#endif  // #ifndef BOOST_ANY_INTERFACE_UNIT
+
+#include <boost/any/any_ref.hpp>
+#include <boost/any/basic_any.hpp>
+#include <boost/any/typed_span.hpp>
+#include <boost/any/detail/erased_array.hpp>
+#include <boost/any/detail/value_ops.hpp>
+
+namespace boost {
+
+namespace anys {
+
+BOOST_ANY_BEGIN_MODULE_EXPORT
+
+/// \brief Collection of values of different types, where the values of
+/// each type are stored contiguously in their own segment.
+///
+/// Segments are keyed by the type identity of boost::anys::basic_any, so
+/// a boost::anys::basic_any can be inserted without knowing the stored type.
+/// Processing the values segment by segment makes each loop monomorphic:
+/// \code
+/// boost::anys::any_segments events;
+/// events.insert(click_event{...});
+/// events.insert(std::move(some_basic_any));
+///
+/// for (click_event& e : events.segment<click_event>()) {
+///     // Tight loop over a plain array
+/// }
+/// \endcode
+///
+/// The order of values is kept within each segment, segments are visited in
+/// the order of their creation.
+///
+/// Insertion may relocate the values of the same type, invalidating
+/// pointers, references and spans to them. Values of other types are not
+/// affected.
+class any_segments {
+public:
+    /// \post this->empty() is true.
+    any_segments() = default;
+
+    /// Copies the segments of `other`.
+    /// \throws std::bad_alloc or any exceptions arising from the copy
+    /// constructors of the stored types.
+    any_segments(const any_segments&) = default;
+
+    /// Moves the segments of `other` into `*this`.
+    /// \throws Nothing.
+    any_segments(any_segments&& other) noexcept
+      : segments(std::move(other.segments))
+      , index(std::move(other.index))
+      , count(other.count)
+    {
+        other.count = 0;
+    }
+
+    /// Copies `rhs`, discarding previous content.
+    /// \throws std::bad_alloc or any exceptions arising from the copy
+    /// constructors of the stored types. Strong exception guarantee.
+    any_segments& operator=(const any_segments& rhs)
+    {
+        any_segments(rhs).swap(*this);
+        return *this;
+    }
+
+    /// Moves `rhs` into `*this`, discarding previous content.
+    /// \throws Nothing.
+    any_segments& operator=(any_segments&& rhs) noexcept
+    {
+        any_segments(std::move(rhs)).swap(*this);
+        return *this;
+    }
+
+    /// Copies or moves `value` to the end of the segment for `ValueType`.
+    /// \throws std::bad_alloc or any exceptions arising from the copy or move
+    /// constructor of `ValueType`. Strong exception guarantee.
+    template <class ValueType>
+    typename std::decay<ValueType>::type& insert(ValueType&& value)
+    {
+        using type = typename std::decay<ValueType>::type;
+        static_assert(
+            !anys::detail::is_some_any<type>::value,
+            "boost::anys::any_segments::insert(T&&) shall not be used with any types, "
+            "use the boost::anys::basic_any overload"
+        );
+        static_assert(
+            std::is_copy_constructible<type>::value,
+            "boost::anys::any_segments requires copy constructible types"
+        );
+
+        detail::erased_array& segment = segment_for(detail::value_ops_of<type>::value);
+        type* result = static_cast<type*>(segment.construct_back([&value](void* place) {
+            ::new (place) type(std::forward<ValueType>(value));
+        }));
+        ++count;
+        return *result;
+    }
+
+    /// Moves the content of `value` to the end of the segment for its stored
+    /// type, leaving the `value` empty. Does nothing if `value` is empty.
+    /// Requires `BOOST_ANY_USE_HOLDER_VALUE_OPS`, see boost::anys::basic_any.
+    /// \throws std::bad_alloc or any exceptions arising from the move
+    /// constructor of the stored type. Strong exception guarantee.
+    template <std::size_t OptimizeForSize, std::size_t OptimizeForAlignment>
+    void insert(basic_any<OptimizeForSize, OptimizeForAlignment>&& value)
+    {
+        const detail::value_ops* ops = detail::basic_any_access::ops(value);
+        if (!ops) {
+            return;
+        }
+
+        segment_for(*ops).move_back(detail::basic_any_access::address(value));
+        ++count;
+        detail::basic_any_access::reset(value);
+    }
+
+    /// Copies the content of `value` to the end of the segment for its stored
+    /// type. Does nothing if `value` is empty.
+    /// Requires `BOOST_ANY_USE_HOLDER_VALUE_OPS`, see boost::anys::basic_any.
+    /// \throws std::bad_alloc or any exceptions arising from the copy
+    /// constructor of the stored type. Strong exception guarantee.
+    template <std::size_t OptimizeForSize, std::size_t OptimizeForAlignment>
+    void insert(const basic_any<OptimizeForSize, OptimizeForAlignment>& value)
+    {
+        const detail::value_ops* ops = detail::basic_any_access::ops(value);
+        if (!ops) {
+            return;
+        }
+
+        segment_for(*ops).copy_back(
+            detail::basic_any_access::address(const_cast<basic_any<OptimizeForSize, OptimizeForAlignment>&>(value))
+        );
+        ++count;
+    }
+
+    /// \returns View to all the values of type `ValueType`, empty view if
+    /// there are none.
+    template <class ValueType>
+    typed_span<ValueType> segment() noexcept
+    {
+        const detail::erased_array* s = find(detail::value_ops_of<ValueType>::value);
+        return s
+            ? typed_span<ValueType>(static_cast<ValueType*>(s->data()), s->size())
+            : typed_span<ValueType>();
+    }
+
+    /// \returns View to all the values of type `ValueType`, empty view if
+    /// there are none.
+    template <class ValueType>
+    typed_span<const ValueType> segment() const noexcept
+    {
+        const detail::erased_array* s = find(detail::value_ops_of<ValueType>::value);
+        return s
+            ? typed_span<const ValueType>(static_cast<const ValueType*>(s->data()), s->size())
+            : typed_span<const ValueType>();
+    }
+
+    /// Calls `f(boost::anys::any_ref)` for each value, segment by segment.
+    template <class F>
+    void for_each(F&& f)
+    {
+        for (detail::erased_array& s : segments) {
+            for (std::size_t i = 0; i < s.size(); ++i) {
+                f(detail::any_ref_access::make(&s.ops(), s.at(i)));
+            }
+        }
+    }
+
+    /// Calls `f(boost::anys::any_cref)` for each value, segment by segment.
+    template <class F>
+    void for_each(F&& f) const
+    {
+        for (const detail::erased_array& s : segments) {
+            for (std::size_t i = 0; i < s.size(); ++i) {
+                f(detail::any_ref_access::make(&s.ops(), static_cast<const void*>(s.at(i))));
+            }
+        }
+    }
+
+    /// Calls `f(ValueType&)` for each value of each of the `ValueTypes`,
+    /// segment by segment. Each segment is processed by its own loop without
+    /// type erasure.
+    template <class... ValueTypes, class F>
+    typename std::enable_if<sizeof...(ValueTypes) != 0>::type for_each(F&& f)
+    {
+        const int expand[] = {0, (any_segments::for_each_value(segment<ValueTypes>(), f), 0)...};
+        (void)expand;
+    }
+
+    /// Calls `f(const ValueType&)` for each value of each of the
+    /// `ValueTypes`, segment by segment. Each segment is processed by its own
+    /// loop without type erasure.
+    template <class... ValueTypes, class F>
+    typename std::enable_if<sizeof...(ValueTypes) != 0>::type for_each(F&& f) const
+    {
+        const int expand[] = {0, (any_segments::for_each_value(segment<ValueTypes>(), f), 0)...};
+        (void)expand;
+    }
+
+    /// \returns Count of values in all the segments.
+    std::size_t size() const noexcept { return count; }
+
+    /// \returns `true` if there are no values.
+    bool empty() const noexcept { return !count; }
+
+    /// \returns Count of the segments, including the emptied ones.
+    std::size_t segment_count() const noexcept { return segments.size(); }
+
+    /// Destroys all the values. Keeps the segments memory for reuse.
+    void clear() noexcept
+    {
+        for (detail::erased_array& s : segments) {
+            s.clear();
+        }
+        count = 0;
+    }
+
+    /// Exchanges the content of `*this` and `rhs`.
+    /// \throws Nothing.
+    void swap(any_segments& rhs) noexcept
+    {
+        segments.swap(rhs.segments);
+        index.swap(rhs.index);
+        std::swap(count, rhs.count);
+    }
+
+private:
+    /// @cond
+    template <class Span, class F>
+    static void for_each_value(Span values, F& f)
+    {
+        for (auto& value : values) {
+            f(value);
+        }
+    }
+
+    const detail::erased_array* find(const detail::value_ops& ops) const noexcept
+    {
+        const auto it = index.find(&ops);
+        return it == index.end() ? nullptr : &segments[it->second];
+    }
+
+    detail::erased_array& segment_for(const detail::value_ops& ops)
+    {
+        const auto it = index.find(&ops);
+        if (it != index.end()) {
+            return segments[it->second];
+        }
+
+        segments.emplace_back(ops);
+        struct rollback {
+            std::vector<detail::erased_array>* segments;
+            ~rollback() { if (segments) segments->pop_back(); }
+        } guard{&segments};
+        index.emplace(&ops, segments.size() - 1);
+        guard.segments = nullptr;
+        return segments.back();
+    }
+
+    std::vector<detail::erased_array> segments;
+    std::unordered_map<const detail::value_ops*, std::size_t> index;
+    std::size_t count = 0;
+    /// @endcond
+};
+
+/// Exchanges the content of `lhs` and `rhs`.
+/// \throws Nothing.
+inline void swap(any_segments& lhs, any_segments& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+BOOST_ANY_END_MODULE_EXPORT
+
+} // namespace anys
+
+} // namespace boost
+
+#endif  // #if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+#endif // #ifndef BOOST_ANYS_ANY_SEGMENTS_HPP_INCLUDED
@@ -0,0 +1,395 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/any for Documentation.
+
+#ifndef BOOST_ANYS_ANY_TABLE_HPP_INCLUDED
+#define BOOST_ANYS_ANY_TABLE_HPP_INCLUDED
+
+#include <boost/any/detail/config.hpp>
+
+#if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+/// \file boost/any/any_table.hpp
+/// \brief \copybrief boost::anys::any_table
+
+#ifndef BOOST_ANY_INTERFACE_UNIT
+#include <boost/config.hpp>
+#ifdef BOOST_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/type_index.hpp>
+#endif  // #ifndef BOOST_ANY_INTERFACE_UNIT
+
+#include <boost/any/any_ref.hpp>
+#include <boost/any/bad_any_cast.hpp>
+#include <boost/any/basic_any.hpp>
+#include <boost/any/typed_span.hpp>
+#include <boost/any/detail/erased_array.hpp>
+#include <boost/any/detail/value_ops.hpp>
+
+namespace boost {
+
+namespace anys {
+
+/// @cond
+namespace detail {
+
+    // Row of boost::anys::any_table, `Ref` is any_ref or any_cref
+    template <class Table, class Ref>
+    class table_row {
+    public:
+        table_row(Table& table, std::size_t row) noexcept
+          : table_(&table)
+          , row_(row)
+        {}
+
+        Ref operator[](std::size_t column) const noexcept
+        {
+            return table_->cell(row_, column);
+        }
+
+        std::size_t size() const noexcept { return table_->column_count(); }
+        std::size_t index() const noexcept { return row_; }
+
+    private:
+        Table* table_;
+        std::size_t row_;
+    };
+
+} // namespace detail
+/// @endcond
+
+BOOST_ANY_BEGIN_MODULE_EXPORT
+
+/// \brief Table with columns of types that are known only at runtime, each
+/// column is stored as a contiguous array of its values.
+///
+/// Unlike rows of anys, a cell takes exactly `sizeof(T)` bytes, there is no
+/// allocation per cell and a scan over a column is a walk over a plain
+/// array:
+/// \code
+/// boost::anys::any_table table;
+/// const auto price = table.add_column(boost::anys::basic_any<>(0.0));
+/// const auto name = table.add_column(boost::anys::basic_any<>(std::string()));
+/// table.emplace_row(9.99, std::string("apple"));
+/// table.emplace_row(0.5, std::string("nut"));
+///
+/// double total = 0;
+/// for (double p : table.column<double>(price)) {
+///     total += p;
+/// }
+///
+/// auto row = table.row(1);
+/// assert(boost::any_cast<std::string&>(row[name]) == "nut");
+/// \endcode
+///
+/// Adding rows may relocate the values of the columns, invalidating
+/// pointers, references and spans to them.
+class any_table {
+public:
+    /// View to a row, the cells are accessed as boost::anys::any_ref.
+    using row_reference = detail::table_row<any_table, any_ref>;
+
+    /// View to a row, the cells are accessed as boost::anys::any_cref.
+    using const_row_reference = detail::table_row<const any_table, any_cref>;
+
+    /// \post this->column_count() == 0 && this->row_count() == 0
+    any_table() = default;
+
+    /// Copies the columns of `other`.
+    /// \throws std::bad_alloc or any exceptions arising from the copy
+    /// constructors of the stored types.
+    any_table(const any_table&) = default;
+
+    /// Moves the columns of `other` into `*this`, leaving `other` without
+    /// columns.
+    /// \throws Nothing.
+    any_table(any_table&& other) noexcept
+      : columns(std::move(other.columns))
+      , rows(other.rows)
+    {
+        other.columns.clear();
+        other.rows = 0;
+    }
+
+    /// Copies `rhs`, discarding previous content.
+    /// \throws std::bad_alloc or any exceptions arising from the copy
+    /// constructors of the stored types. Strong exception guarantee.
+    any_table& operator=(const any_table& rhs)
+    {
+        any_table(rhs).swap(*this);
+        return *this;
+    }
+
+    /// Moves `rhs` into `*this`, discarding previous content.
+    /// \throws Nothing.
+    any_table& operator=(any_table&& rhs) noexcept
+    {
+        any_table(std::move(rhs)).swap(*this);
+        return *this;
+    }
+
+    /// Adds a column of the type stored in `prototype`. Existing rows and the
+    /// rows added by push_row() get a copy of the `prototype` value.
+    /// Requires `BOOST_ANY_USE_HOLDER_VALUE_OPS`, see boost::anys::basic_any.
+    /// \returns Index of the new column.
+    /// \throws boost::bad_any_cast if `prototype` is empty, std::bad_alloc or
+    /// any exceptions arising from the copy constructor of the stored type.
+    /// Strong exception guarantee.
+    template <std::size_t OptimizeForSize, std::size_t OptimizeForAlignment>
+    std::size_t add_column(const basic_any<OptimizeForSize, OptimizeForAlignment>& prototype)
+    {
+        const detail::value_ops* ops = detail::basic_any_access::ops(prototype);
+        if (!ops) {
+            detail::throw_bad_any_cast();
+        }
+
+        basic_any<OptimizeForSize, OptimizeForAlignment> tmp(prototype);
+        return add_column_impl(detail::erased_value(*ops, detail::basic_any_access::address(tmp)));
+    }
+
+    /// Adds a column of `std::decay_t<ValueType>`. Existing rows and the rows
+    /// added by push_row() get a copy of `default_value`.
+    /// \returns Index of the new column.
+    /// \throws std::bad_alloc or any exceptions arising from the copy
+    /// constructor of the `ValueType`. Strong exception guarantee.
+    template <class ValueType>
+    typename std::enable_if<!anys::detail::is_basic_any<typename std::decay<ValueType>::type>::value, std::size_t>::type
+    add_column(ValueType&& default_value)
+    {
+        using type = typename std::decay<ValueType>::type;
+        static_assert(
+            !anys::detail::is_some_any<type>::value,
+            "boost::anys::any_table::add_column(T) shall not be used with any types other than "
+            "boost::anys::basic_any"
+        );
+        static_assert(
+            std::is_copy_constructible<type>::value,
+            "boost::anys::any_table requires copy constructible types"
+        );
+        type value(std::forward<ValueType>(default_value));
+        return add_column_impl(detail::erased_value(
+            detail::value_ops_of<type>::value, std::addressof(value)
+        ));
+    }
+
+    /// Adds a row with copies of the column defaults.
+    /// \throws std::bad_alloc or any exceptions arising from the copy
+    /// constructors of the column types. Strong exception guarantee.
+    void push_row()
+    {
+        row_guard guard{*this, 0};
+        for (; guard.added != columns.size(); ++guard.added) {
+            column_data& c = columns[guard.added];
+            c.values.copy_back(c.prototype.data());
+        }
+        guard.added = 0;
+        ++rows;
+    }
+
+    /// Adds a row of `values`, one per column.
+    /// \throws std::invalid_argument if the count of `values` differs from
+    /// the column count, boost::bad_any_cast if the type of a value differs
+    /// from the type of its column, std::bad_alloc or any exceptions arising
+    /// from the constructors of the column types. Strong exception guarantee.
+    template <class... Values>
+    void emplace_row(Values&&... values)
+    {
+        if (sizeof...(Values) != columns.size()) {
+            boost::throw_exception(std::invalid_argument(
+                "boost::anys::any_table::emplace_row: count of values differs from the count of columns"
+            ));
+        }
+
+        row_guard guard{*this, 0};
+        emplace_cells(guard, std::forward<Values>(values)...);
+        guard.added = 0;
+        ++rows;
+    }
+
+    /// Removes the last row.
+    /// \pre `this->row_count() != 0`
+    void pop_row() noexcept
+    {
+        BOOST_ASSERT(rows);
+        for (column_data& c : columns) {
+            c.values.pop_back();
+        }
+        --rows;
+    }
+
+    /// Removes all the rows, keeps the columns.
+    void clear_rows() noexcept
+    {
+        for (column_data& c : columns) {
+            c.values.clear();
+        }
+        rows = 0;
+    }
+
+    /// Makes sure that `count` rows fit without reallocations.
+    /// \throws std::bad_alloc or any exceptions arising from the move
+    /// constructors of the column types.
+    void reserve_rows(std::size_t count)
+    {
+        for (column_data& c : columns) {
+            c.values.reserve(count);
+        }
+    }
+
+    /// \returns View to all the values of the column at `index`.
+    /// \throws boost::bad_any_cast if the column type is not `ValueType`.
+    template <class ValueType>
+    typed_span<ValueType> column(std::size_t index)
+    {
+        BOOST_ASSERT(index < columns.size());
+        const detail::erased_array& values = columns[index].values;
+        if (!detail::is_value_ops_of<typename std::remove_cv<ValueType>::type>(&values.ops())) {
+            detail::throw_bad_any_cast();
+        }
+        return typed_span<ValueType>(static_cast<ValueType*>(values.data()), rows);
+    }
+
+    /// \returns View to all the values of the column at `index`.
+    /// \throws boost::bad_any_cast if the column type is not `ValueType`.
+    template <class ValueType>
+    typed_span<const ValueType> column(std::size_t index) const
+    {
+        return const_cast<any_table&>(*this).column<ValueType>(index);
+    }
+
+    /// \returns The type of the column at `index`.
+    const boost::typeindex::type_info& column_type(std::size_t index) const noexcept
+    {
+        BOOST_ASSERT(index < columns.size());
+        return columns[index].values.ops().type();
+    }
+
+    /// \returns Reference to the value at `row` in `column`.
+    any_ref cell(std::size_t row, std::size_t column) noexcept
+    {
+        BOOST_ASSERT(row < rows);
+        BOOST_ASSERT(column < columns.size());
+        const detail::erased_array& values = columns[column].values;
+        return detail::any_ref_access::make(&values.ops(), values.at(row));
+    }
+
+    /// \returns Reference to the value at `row` in `column`.
+    any_cref cell(std::size_t row, std::size_t column) const noexcept
+    {
+        return const_cast<any_table&>(*this).cell(row, column);
+    }
+
+    /// \returns View to the row at `index`.
+    row_reference row(std::size_t index) noexcept
+    {
+        BOOST_ASSERT(index < rows);
+        return row_reference(*this, index);
+    }
+
+    /// \returns View to the row at `index`.
+    const_row_reference row(std::size_t index) const noexcept
+    {
+        BOOST_ASSERT(index < rows);
+        return const_row_reference(*this, index);
+    }
+
+    /// \returns Count of the columns.
+    std::size_t column_count() const noexcept { return columns.size(); }
+
+    /// \returns Count of the rows.
+    std::size_t row_count() const noexcept { return rows; }
+
+    /// Exchanges the content of `*this` and `rhs`.
+    /// \throws Nothing.
+    void swap(any_table& rhs) noexcept
+    {
+        columns.swap(rhs.columns);
+        std::swap(rows, rhs.rows);
+    }
+
+private:
+    /// @cond
+    struct column_data {
+        detail::erased_array values;
+        detail::erased_value prototype;
+    };
+
+    // Removes the last value from the first `added` columns
+    struct row_guard {
+        any_table& table;
+        std::size_t added;
+
+        ~row_guard()
+        {
+            while (added) {
+                --added;
+                table.columns[added].values.pop_back();
+            }
+        }
+    };
+
+    std::size_t add_column_impl(detail::erased_value&& prototype)
+    {
+        column_data c{detail::erased_array(*prototype.ops()), std::move(prototype)};
+        c.values.reserve(rows);
+        for (std::size_t i = 0; i < rows; ++i) {
+            c.values.copy_back(c.prototype.data());
+        }
+        columns.push_back(std::move(c));
+        return columns.size() - 1;
+    }
+
+    static void emplace_cells(row_guard&) noexcept {}
+
+    template <class Value, class... Values>
+    void emplace_cells(row_guard& guard, Value&& value, Values&&... values)
+    {
+        using type = typename std::decay<Value>::type;
+        detail::erased_array& c = columns[guard.added].values;
+        if (!detail::is_value_ops_of<type>(&c.ops())) {
+            detail::throw_bad_any_cast();
+        }
+        c.construct_back([&value](void* place) {
+            ::new (place) type(std::forward<Value>(value));
+        });
+        ++guard.added;
+        emplace_cells(guard, std::forward<Values>(values)...);
+    }
+
+    std::vector<column_data> columns;
+    std::size_t rows = 0;
+    /// @endcond
+};
+
+/// Exchanges the content of `lhs` and `rhs`.
+/// \throws Nothing.
+inline void swap(any_table& lhs, any_table& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+BOOST_ANY_END_MODULE_EXPORT
+
+} // namespace anys
+
+} // namespace boost
+
+#endif  // #if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+#endif // #ifndef BOOST_ANYS_ANY_TABLE_HPP_INCLUDED
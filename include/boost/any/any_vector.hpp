@@ -0,0 +1,566 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/any for Documentation.
+
+#ifndef BOOST_ANYS_ANY_VECTOR_HPP_INCLUDED
+#define BOOST_ANYS_ANY_VECTOR_HPP_INCLUDED
+
+#include <boost/any/detail/config.hpp>
+
+#if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+/// \file boost/any/any_vector.hpp
+/// \brief \copybrief boost::anys::any_vector
+
+#ifndef BOOST_ANY_INTERFACE_UNIT
+#include <boost/config.hpp>
+#ifdef BOOST_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <boost/assert.hpp>
+#endif  // #ifndef BOOST_ANY_INTERFACE_UNIT
+
+#include <boost/any/any_ref.hpp>
+#include <boost/any/detail/value_ops.hpp>
+
+namespace boost {
+
+namespace anys {
+
+/// @cond
+namespace detail {
+
+    // Header of each element in boost::anys::any_vector. The value follows
+    // the header, aligned to its alignment. `next` is the distance in bytes
+    // from this header to the header of the next element.
+    struct packed_header {
+        const value_ops* ops;
+        std::size_t next;
+    };
+
+    constexpr std::size_t packed_align_up(std::size_t value, std::size_t alignment) noexcept
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    constexpr std::size_t packed_value_offset(std::size_t header_offset, std::size_t alignment) noexcept
+    {
+        return detail::packed_align_up(header_offset + sizeof(packed_header), alignment) - header_offset;
+    }
+
+    constexpr std::size_t packed_record_size(std::size_t header_offset, const value_ops& ops) noexcept
+    {
+        return detail::packed_align_up(
+            detail::packed_value_offset(header_offset, ops.alignment) + ops.size,
+            alignof(packed_header)
+        );
+    }
+
+    template <class Ref, class Byte>
+    class packed_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Ref;
+        using difference_type = std::ptrdiff_t;
+        using reference = Ref;
+        using pointer = void;
+
+        packed_iterator() noexcept : pos(nullptr) {}
+
+        explicit packed_iterator(Byte* position) noexcept : pos(position) {}
+
+        template <class OtherRef, class OtherByte>
+        packed_iterator(const packed_iterator<OtherRef, OtherByte>& other, typename std::enable_if<
+            std::is_convertible<OtherByte*, Byte*>::value
+        >::type* = nullptr) noexcept
+          : pos(other.position())
+        {}
+
+        Ref operator*() const noexcept
+        {
+            const value_ops* ops = header().ops;
+            return any_ref_access::make(ops, pos + packed_value_offset(offset(), ops->alignment));
+        }
+
+        packed_iterator& operator++() noexcept
+        {
+            pos += header().next;
+            return *this;
+        }
+
+        packed_iterator operator++(int) noexcept
+        {
+            packed_iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        Byte* position() const noexcept { return pos; }
+
+        friend bool operator==(const packed_iterator& lhs, const packed_iterator& rhs) noexcept
+        {
+            return lhs.pos == rhs.pos;
+        }
+
+        friend bool operator!=(const packed_iterator& lhs, const packed_iterator& rhs) noexcept
+        {
+            return lhs.pos != rhs.pos;
+        }
+
+    private:
+        const packed_header& header() const noexcept
+        {
+            return *reinterpret_cast<const packed_header*>(pos);
+        }
+
+        // The storage is aligned to the alignment of any supported type,
+        // so the address modulo alignment is enough to lay out an element.
+        std::size_t offset() const noexcept
+        {
+            return reinterpret_cast<std::uintptr_t>(pos) % alignof(std::max_align_t);
+        }
+
+        Byte* pos;
+    };
+
+} // namespace detail
+/// @endcond
+
+BOOST_ANY_BEGIN_MODULE_EXPORT
+
+/// \brief Sequence of values of different types, packed one after another
+/// into a single contiguous buffer.
+///
+/// Each element is a small header with the type identity and the distance
+/// to the next element, followed by the value itself. Unlike
+/// `std::vector<boost::any>` there is no allocation per element and the
+/// iteration is a linear walk over memory. Unlike
+/// `std::vector<boost::anys::basic_any<Size, Align>>` the small elements
+/// occupy only the space they need.
+///
+/// The elements are accessed via boost::anys::any_ref and
+/// boost::anys::any_cref, that work with boost::any_cast:
+/// \code
+/// boost::anys::any_vector v;
+/// v.push_back(42);
+/// v.push_back(std::string("hello"));
+/// for (boost::anys::any_ref element : v) {
+///     if (auto* s = boost::any_cast<std::string>(&element)) {
+///         // ...
+///     }
+/// }
+/// \endcode
+///
+/// Stored types shall be copy constructible, nothrow move constructible and
+/// shall not be over-aligned.
+/// Insertion may relocate elements, invalidating all the iterators and
+/// references.
+class any_vector {
+public:
+    /// Forward iterator over the elements, dereferences to boost::anys::any_ref.
+    using iterator = detail::packed_iterator<any_ref, unsigned char>;
+
+    /// Forward iterator over the elements, dereferences to boost::anys::any_cref.
+    using const_iterator = detail::packed_iterator<any_cref, const unsigned char>;
+
+    using size_type = std::size_t;
+
+    /// \post this->empty() is true.
+    any_vector() noexcept
+      : storage(nullptr)
+      , used(0)
+      , capacity(0)
+      , count(0)
+    {}
+
+    /// Copies all the elements of `other` into a single new buffer.
+    /// \throws std::bad_alloc or any exceptions arising from the copy
+    /// constructors of the stored types.
+    any_vector(const any_vector& other)
+      : any_vector()
+    {
+        if (!other.used) {
+            return;
+        }
+
+        buffer_guard guard{any_vector::allocate(other.used), 0};
+        while (guard.constructed != other.used) {
+            const std::size_t offset = guard.constructed;
+            const detail::packed_header& h = other.header(offset);
+            h.ops->copy(guard.data + offset + value_offset(offset, *h.ops), other.value(offset));
+            ::new (guard.data + offset) detail::packed_header(h);
+            guard.constructed += h.next;
+        }
+
+        storage = guard.release();
+        used = other.used;
+        capacity = other.used;
+        count = other.count;
+    }
+
+    /// Moves the elements of `other` into `*this`, leaving `other` empty.
+    /// \throws Nothing.
+    any_vector(any_vector&& other) noexcept
+      : storage(other.storage)
+      , used(other.used)
+      , capacity(other.capacity)
+      , count(other.count)
+    {
+        other.storage = nullptr;
+        other.used = 0;
+        other.capacity = 0;
+        other.count = 0;
+    }
+
+    /// Copies `rhs`, discarding previous content.
+    /// \throws std::bad_alloc or any exceptions arising from the copy
+    /// constructors of the stored types. Strong exception guarantee.
+    any_vector& operator=(const any_vector& rhs)
+    {
+        any_vector(rhs).swap(*this);
+        return *this;
+    }
+
+    /// Moves `rhs` into `*this`, discarding previous content.
+    /// \throws Nothing.
+    any_vector& operator=(any_vector&& rhs) noexcept
+    {
+        any_vector(std::move(rhs)).swap(*this);
+        return *this;
+    }
+
+    /// Destroys all the elements and releases the buffer.
+    ~any_vector() noexcept
+    {
+        clear();
+        any_vector::deallocate(storage);
+    }
+
+    /// Constructs a `ValueType` from `args` at the end of the sequence.
+    /// \returns Reference to the new element.
+    /// \throws std::bad_alloc or any exceptions arising from the constructor
+    /// of `ValueType`. Strong exception guarantee.
+    template <class ValueType, class... Args>
+    ValueType& emplace_back(Args&&... args)
+    {
+        static_assert(
+            !std::is_reference<ValueType>::value && !std::is_const<ValueType>::value,
+            "boost::anys::any_vector stores non-const values"
+        );
+        static_assert(
+            std::is_copy_constructible<ValueType>::value,
+            "boost::anys::any_vector requires copy constructible types"
+        );
+        static_assert(
+            std::is_nothrow_move_constructible<ValueType>::value,
+            "boost::anys::any_vector requires nothrow move constructible types"
+        );
+        static_assert(
+            alignof(ValueType) <= alignof(std::max_align_t),
+            "boost::anys::any_vector does not support over-aligned types"
+        );
+
+        const detail::value_ops& ops = detail::value_ops_of<ValueType>::value;
+        const std::size_t record = detail::packed_record_size(used % alignof(std::max_align_t), ops);
+        if (capacity - used < record) {
+            grow(record);
+        }
+
+        unsigned char* const position = storage + used;
+        ValueType* result = ::new (position + value_offset(used, ops)) ValueType(std::forward<Args>(args)...);
+        ::new (position) detail::packed_header{&ops, record};
+        used += record;
+        ++count;
+        return *result;
+    }
+
+    /// Copies or moves `value` to the end of the sequence.
+    /// \throws std::bad_alloc or any exceptions arising from the copy or move
+    /// constructor of `ValueType`. Strong exception guarantee.
+    template <class ValueType>
+    void push_back(ValueType&& value)
+    {
+        emplace_back<typename std::decay<ValueType>::type>(std::forward<ValueType>(value));
+    }
+
+    /// \returns Iterator to the first element.
+    iterator begin() noexcept { return iterator(storage); }
+
+    /// \returns Iterator past the last element.
+    iterator end() noexcept { return iterator(storage + used); }
+
+    /// \returns Iterator to the first element.
+    const_iterator begin() const noexcept { return const_iterator(storage); }
+
+    /// \returns Iterator past the last element.
+    const_iterator end() const noexcept { return const_iterator(storage + used); }
+
+    /// \returns Iterator to the first element.
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    /// \returns Iterator past the last element.
+    const_iterator cend() const noexcept { return end(); }
+
+    /// \returns Reference to the first element.
+    /// \pre `!this->empty()`
+    any_ref front() noexcept
+    {
+        BOOST_ASSERT(!empty());
+        return *begin();
+    }
+
+    /// \returns Reference to the first element.
+    /// \pre `!this->empty()`
+    any_cref front() const noexcept
+    {
+        BOOST_ASSERT(!empty());
+        return *begin();
+    }
+
+    /// Destroys the element at `pos` and moves the following elements to
+    /// close the gap.
+    /// \returns Iterator to the element that followed the erased one.
+    /// \throws std::bad_alloc if a temporary buffer for relocating an element
+    /// could not be allocated.
+    iterator erase(const_iterator pos)
+    {
+        BOOST_ASSERT(pos != cend());
+        const_iterator next = pos;
+        return erase(pos, ++next);
+    }
+
+    /// Destroys the elements in range [first, last) and moves the following
+    /// elements to close the gap.
+    /// \returns Iterator to the element that followed the last erased one.
+    /// \throws std::bad_alloc if a temporary buffer for relocating an element
+    /// could not be allocated.
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        const std::size_t from = static_cast<std::size_t>(first.position() - storage);
+        const std::size_t to = static_cast<std::size_t>(last.position() - storage);
+        BOOST_ASSERT(from <= to && to <= used);
+        if (from == to) {
+            return iterator(storage + from);
+        }
+
+        // Tail elements are relocated one by one, each one may need a
+        // different padding at the new position. Overlapping non trivial
+        // values go through a temporary buffer that is allocated before any
+        // modification.
+        std::size_t scratch_size = 0;
+        for (std::size_t dest = from, source = to; source != used; source += header(source).next) {
+            const detail::value_ops& ops = *header(source).ops;
+            if (!ops.trivially_relocatable && any_vector::overlaps(dest, source, ops)) {
+                scratch_size = (std::max)(scratch_size, ops.size);
+            }
+            dest += detail::packed_record_size(dest % alignof(std::max_align_t), ops);
+        }
+        std::unique_ptr<std::max_align_t[]> scratch(scratch_size ? new std::max_align_t[
+            (scratch_size + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t)
+        ] : nullptr);
+
+        count -= any_vector::destroy_range(storage, from, to);
+
+        std::size_t dest = from;
+        for (std::size_t source = to; source != used;) {
+            const detail::packed_header h = header(source);
+            const std::size_t record = detail::packed_record_size(dest % alignof(std::max_align_t), *h.ops);
+            void* const old_value = value(source);
+            void* const new_value = storage + dest + value_offset(dest, *h.ops);
+
+            if (h.ops->trivially_relocatable) {
+                std::memmove(new_value, old_value, h.ops->size);
+            } else if (!any_vector::overlaps(dest, source, *h.ops)) {
+                h.ops->relocate(new_value, old_value);
+            } else {
+                h.ops->relocate(scratch.get(), old_value);
+                h.ops->relocate(new_value, scratch.get());
+            }
+
+            ::new (storage + dest) detail::packed_header{h.ops, record};
+            dest += record;
+            source += h.next;
+        }
+        used = dest;
+        return iterator(storage + from);
+    }
+
+    /// Destroys all the elements. Keeps the buffer for reuse.
+    void clear() noexcept
+    {
+        any_vector::destroy_range(storage, 0, used);
+        used = 0;
+        count = 0;
+    }
+
+    /// Makes sure that at least `bytes` bytes of elements with headers fit
+    /// into the buffer without reallocations.
+    /// \throws std::bad_alloc.
+    void reserve_bytes(std::size_t bytes)
+    {
+        if (capacity < bytes) {
+            reallocate(bytes);
+        }
+    }
+
+    /// \returns Count of elements.
+    size_type size() const noexcept { return count; }
+
+    /// \returns `true` if there are no elements.
+    bool empty() const noexcept { return !count; }
+
+    /// \returns Count of bytes occupied by elements with their headers.
+    std::size_t size_bytes() const noexcept { return used; }
+
+    /// \returns Size of the buffer in bytes.
+    std::size_t capacity_bytes() const noexcept { return capacity; }
+
+    /// Exchanges the content of `*this` and `rhs`.
+    /// \throws Nothing.
+    void swap(any_vector& rhs) noexcept
+    {
+        std::swap(storage, rhs.storage);
+        std::swap(used, rhs.used);
+        std::swap(capacity, rhs.capacity);
+        std::swap(count, rhs.count);
+    }
+
+private:
+    /// @cond
+    // Owns the new buffer and the elements in [0, constructed) bytes of it
+    struct buffer_guard {
+        unsigned char* data;
+        std::size_t constructed;
+
+        ~buffer_guard()
+        {
+            if (data) {
+                any_vector::destroy_range(data, 0, constructed);
+                any_vector::deallocate(data);
+            }
+        }
+
+        unsigned char* release() noexcept
+        {
+            unsigned char* result = data;
+            data = nullptr;
+            return result;
+        }
+    };
+
+    static unsigned char* allocate(std::size_t bytes)
+    {
+        return reinterpret_cast<unsigned char*>(new std::max_align_t[
+            (bytes + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t)
+        ]);
+    }
+
+    static void deallocate(unsigned char* data) noexcept
+    {
+        delete[] reinterpret_cast<std::max_align_t*>(data);
+    }
+
+    static std::size_t value_offset(std::size_t header_offset, const detail::value_ops& ops) noexcept
+    {
+        return detail::packed_value_offset(header_offset % alignof(std::max_align_t), ops.alignment);
+    }
+
+    // Returns true if the value of the element at `source` overlaps with
+    // itself relocated to the element at `dest`.
+    static bool overlaps(std::size_t dest, std::size_t source, const detail::value_ops& ops) noexcept
+    {
+        return dest + value_offset(dest, ops) + ops.size > source + value_offset(source, ops);
+    }
+
+    // Returns the count of the destroyed elements
+    static std::size_t destroy_range(unsigned char* data, std::size_t from, std::size_t to) noexcept
+    {
+        std::size_t destroyed = 0;
+        while (from != to) {
+            const detail::packed_header& h = *reinterpret_cast<const detail::packed_header*>(data + from);
+            h.ops->destroy(data + from + value_offset(from, *h.ops));
+            from += h.next;
+            ++destroyed;
+        }
+        return destroyed;
+    }
+
+    const detail::packed_header& header(std::size_t offset) const noexcept
+    {
+        return *reinterpret_cast<const detail::packed_header*>(storage + offset);
+    }
+
+    void* value(std::size_t offset) const noexcept
+    {
+        return storage + offset + value_offset(offset, *header(offset).ops);
+    }
+
+    BOOST_NOINLINE void grow(std::size_t additional)
+    {
+        std::size_t new_capacity = capacity ? capacity * 2 : 64;
+        while (new_capacity - used < additional) {
+            new_capacity *= 2;
+        }
+        reallocate(new_capacity);
+    }
+
+    void reallocate(std::size_t new_capacity)
+    {
+        buffer_guard guard{any_vector::allocate(new_capacity), 0};
+
+        // The new buffer has the same alignment, so the layout is the same
+        for (std::size_t offset = 0; offset != used; offset += header(offset).next) {
+            const detail::packed_header& h = header(offset);
+            void* const new_value = guard.data + offset + value_offset(offset, *h.ops);
+            if (h.ops->trivially_relocatable) {
+                std::memcpy(new_value, value(offset), h.ops->size);
+            } else {
+                h.ops->move(new_value, value(offset));
+            }
+            ::new (guard.data + offset) detail::packed_header(h);
+        }
+
+        any_vector::destroy_range(storage, 0, used);
+        any_vector::deallocate(storage);
+        storage = guard.release();
+        capacity = new_capacity;
+    }
+
+    unsigned char* storage;
+    std::size_t used;
+    std::size_t capacity;
+    std::size_t count;
+    /// @endcond
+};
+
+/// Exchanges the content of `lhs` and `rhs`.
+/// \throws Nothing.
+inline void swap(any_vector& lhs, any_vector& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+BOOST_ANY_END_MODULE_EXPORT
+
+} // namespace anys
+
+} // namespace boost
+
+#endif  // #if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+#endif // #ifndef BOOST_ANYS_ANY_VECTOR_HPP_INCLUDED
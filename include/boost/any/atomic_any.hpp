@@ -0,0 +1,461 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/any for Documentation.
+
+#ifndef BOOST_ANYS_ATOMIC_ANY_HPP_INCLUDED
+#define BOOST_ANYS_ATOMIC_ANY_HPP_INCLUDED
+
+#include <boost/any/detail/config.hpp>
+
+#if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+/// \file boost/any/atomic_any.hpp
+/// \brief \copybrief boost::anys::atomic_any
+
+#ifndef BOOST_ANY_INTERFACE_UNIT
+#include <boost/config.hpp>
+#ifdef BOOST_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+#include <boost/assert.hpp>
+#endif  // #ifndef BOOST_ANY_INTERFACE_UNIT
+
+#include <boost/any.hpp>
+#include <boost/any/detail/hazard_pointer.hpp>
+
+namespace boost {
+
+namespace anys {
+
+/// @cond
+namespace detail {
+
+    // Immutable published value. The atomic_any that publishes the node and
+    // each snapshot own a reference.
+    struct snapshot_node: hazard_retirable {
+        explicit snapshot_node(boost::any&& v) noexcept
+          : refs(1)
+          , value(std::move(v))
+        {
+            destroy = &snapshot_node::destroy_node;
+            next_retired = nullptr;
+        }
+
+        static void destroy_node(hazard_retirable* node) noexcept
+        {
+            delete static_cast<snapshot_node*>(node);
+        }
+
+        static void add_ref(snapshot_node* node) noexcept
+        {
+            if (node) {
+                node->refs.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        // Readers may still hold a hazard pointer on a node without
+        // references, so the node is retired instead of deleted
+        static void release(snapshot_node* node) noexcept
+        {
+            if (node && node->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                hazard_domain::instance().retire(node);
+            }
+        }
+
+        std::atomic<std::size_t> refs;
+        boost::any value;
+    };
+
+    inline const boost::any& empty_snapshot_value() noexcept
+    {
+        static const boost::any value;
+        return value;
+    }
+
+    struct snapshot_access;
+
+} // namespace detail
+/// @endcond
+
+BOOST_ANY_BEGIN_MODULE_EXPORT
+
+class atomic_any;
+
+/// \brief Shared read only reference to the value that was stored in
+/// boost::anys::atomic_any at the moment of the load.
+///
+/// The value stays alive while at least one snapshot references it, even if
+/// boost::anys::atomic_any was given a new value.
+class any_snapshot {
+public:
+    /// \post this->get().empty() is true.
+    any_snapshot() noexcept
+      : node(nullptr)
+    {}
+
+    /// Shares the value of `other`.
+    /// \throws Nothing.
+    any_snapshot(const any_snapshot& other) noexcept
+      : node(other.node)
+    {
+        detail::snapshot_node::add_ref(node);
+    }
+
+    /// Takes the value of `other`, leaving it empty.
+    /// \throws Nothing.
+    any_snapshot(any_snapshot&& other) noexcept
+      : node(other.node)
+    {
+        other.node = nullptr;
+    }
+
+    /// Shares the value of `rhs`, releasing previous one.
+    /// \throws Nothing.
+    any_snapshot& operator=(const any_snapshot& rhs) noexcept
+    {
+        any_snapshot(rhs).swap(*this);
+        return *this;
+    }
+
+    /// Takes the value of `rhs`, releasing previous one.
+    /// \throws Nothing.
+    any_snapshot& operator=(any_snapshot&& rhs) noexcept
+    {
+        any_snapshot(std::move(rhs)).swap(*this);
+        return *this;
+    }
+
+    ~any_snapshot() noexcept
+    {
+        detail::snapshot_node::release(node);
+    }
+
+    /// \returns The referenced value or an empty boost::any.
+    const boost::any& get() const noexcept
+    {
+        return node ? node->value : detail::empty_snapshot_value();
+    }
+
+    /// \returns this->get()
+    const boost::any& operator*() const noexcept { return get(); }
+
+    /// \returns std::addressof(this->get())
+    const boost::any* operator->() const noexcept { return &get(); }
+
+    /// Exchanges the content of `*this` and `rhs`.
+    /// \throws Nothing.
+    void swap(any_snapshot& rhs) noexcept
+    {
+        std::swap(node, rhs.node);
+    }
+
+    /// \returns `true` if both snapshots reference the same stored value.
+    friend bool operator==(const any_snapshot& lhs, const any_snapshot& rhs) noexcept
+    {
+        return lhs.node == rhs.node;
+    }
+
+    /// \returns `!(lhs == rhs)`
+    friend bool operator!=(const any_snapshot& lhs, const any_snapshot& rhs) noexcept
+    {
+        return lhs.node != rhs.node;
+    }
+
+private:
+    /// @cond
+    friend class atomic_any;
+    friend struct detail::snapshot_access;
+
+    explicit any_snapshot(detail::snapshot_node* n) noexcept
+      : node(n)
+    {}
+
+    detail::snapshot_node* node;
+    /// @endcond
+};
+
+/// Exchanges the content of `lhs` and `rhs`.
+/// \throws Nothing.
+inline void swap(any_snapshot& lhs, any_snapshot& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+/// \brief boost::anys::any_snapshot with a checked `ValueType`.
+///
+/// Keeps the value alive as boost::anys::any_snapshot does and gives
+/// direct access to it without boost::any_cast on each use.
+template <class ValueType>
+class typed_snapshot {
+public:
+    /// \post `!*this`
+    typed_snapshot() noexcept
+      : value(nullptr)
+    {}
+
+    /// Takes `source` if it references a `ValueType`, otherwise makes an
+    /// empty typed_snapshot.
+    /// \throws Nothing.
+    explicit typed_snapshot(any_snapshot source) noexcept
+      : holder(std::move(source))
+      , value(boost::any_cast<ValueType>(&holder.get()))
+    {
+        if (!value) {
+            holder = any_snapshot();
+        }
+    }
+
+    typed_snapshot(const typed_snapshot&) = default;
+
+    /// Takes the value of `other`, leaving it empty.
+    /// \throws Nothing.
+    typed_snapshot(typed_snapshot&& other) noexcept
+      : holder(std::move(other.holder))
+      , value(other.value)
+    {
+        other.value = nullptr;
+    }
+
+    /// Shares or takes the value of `rhs`, releasing previous one.
+    /// \throws Nothing.
+    typed_snapshot& operator=(typed_snapshot rhs) noexcept
+    {
+        rhs.swap(*this);
+        return *this;
+    }
+
+    /// \returns Pointer to the referenced value or nullptr.
+    const ValueType* get() const noexcept { return value; }
+
+    /// \pre `*this` references a value.
+    const ValueType& operator*() const noexcept
+    {
+        BOOST_ASSERT(value);
+        return *value;
+    }
+
+    /// \pre `*this` references a value.
+    const ValueType* operator->() const noexcept
+    {
+        BOOST_ASSERT(value);
+        return value;
+    }
+
+    /// \returns `true` if `*this` references a value.
+    explicit operator bool() const noexcept { return value != nullptr; }
+
+    /// \returns Untyped snapshot of the same value.
+    const any_snapshot& snapshot() const noexcept { return holder; }
+
+    /// Exchanges the content of `*this` and `rhs`.
+    /// \throws Nothing.
+    void swap(typed_snapshot& rhs) noexcept
+    {
+        holder.swap(rhs.holder);
+        std::swap(value, rhs.value);
+    }
+
+private:
+    /// @cond
+    any_snapshot holder;
+    const ValueType* value;
+    /// @endcond
+};
+
+/// Exchanges the content of `lhs` and `rhs`.
+/// \throws Nothing.
+template <class ValueType>
+void swap(typed_snapshot<ValueType>& lhs, typed_snapshot<ValueType>& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+/// \brief Holder of a boost::any, that could be read and replaced
+/// concurrently without locks.
+///
+/// Designed for the values that are read often and replaced rarely, like
+/// configuration. Readers get a boost::anys::any_snapshot that keeps the
+/// value alive; a writer publishes a new value with a single atomic
+/// operation:
+/// \code
+/// boost::anys::atomic_any config{load_config()};
+///
+/// // Reader threads
+/// const boost::anys::any_snapshot current = config.load();
+/// const auto& c = boost::any_cast<const config_type&>(*current);
+///
+/// // Writer thread
+/// config.store(load_config());
+/// \endcode
+///
+/// Values are reclaimed via hazard pointers: the thread that releases the
+/// last reference to a value frees it as soon as no reader is in the middle
+/// of acquiring it. A value that was being read at that moment is freed by
+/// a later release of any value or by boost::anys::reclaim_retired(). Neither load() nor the release of a snapshot take a
+/// lock, but both modify the reference count of the value, so the readers
+/// write the same cache line. visit() writes no shared memory except the
+/// hazard pointer of the calling thread.
+class atomic_any {
+public:
+    /// \post this->load()->empty() is true.
+    atomic_any() noexcept
+      : current(nullptr)
+    {}
+
+    /// Stores `value`.
+    /// \throws std::bad_alloc
+    explicit atomic_any(boost::any value)
+      : current(new detail::snapshot_node(std::move(value)))
+    {}
+
+    atomic_any(const atomic_any&) = delete;
+    atomic_any& operator=(const atomic_any&) = delete;
+
+    /// Releases the stored value. Snapshots keep it alive.
+    ~atomic_any() noexcept
+    {
+        detail::snapshot_node::release(current.load(std::memory_order_acquire));
+    }
+
+    /// \returns Snapshot of the stored value.
+    /// \throws std::bad_alloc on the first call from a thread if the memory
+    /// for its hazard pointer could not be allocated.
+    any_snapshot load() const
+    {
+        detail::hazard_record& record = detail::hazard_domain::this_thread_record();
+        for (;;) {
+            detail::snapshot_node* const node = detail::hazard_domain::protect(current, record);
+            if (!node) {
+                detail::hazard_domain::clear(record);
+                return any_snapshot();
+            }
+
+            // The node can not be freed while protected, but the last
+            // reference could be already released by a concurrent writer
+            std::size_t refs = node->refs.load(std::memory_order_relaxed);
+            while (refs && !node->refs.compare_exchange_weak(refs, refs + 1, std::memory_order_acq_rel)) {}
+            detail::hazard_domain::clear(record);
+            if (refs) {
+                return any_snapshot(node);
+            }
+        }
+    }
+
+    /// Calls `f(const boost::any&)` with the stored value while the value is
+    /// protected by the hazard pointer of the calling thread. Unlike load(),
+    /// does not touch the reference count of the value.
+    ///
+    /// `f` shall not use boost::anys::atomic_any or
+    /// boost::anys::concurrent_any_map: the calling thread has a single
+    /// hazard pointer. The reference passed to `f` is valid only during the
+    /// call.
+    /// \returns The result of `f`.
+    /// \throws std::bad_alloc on the first call from a thread if the memory
+    /// for its hazard pointer could not be allocated, or any exceptions
+    /// arising from `f`.
+    template <class F>
+    auto visit(F&& f) const -> decltype(std::forward<F>(f)(std::declval<const boost::any&>()))
+    {
+        detail::hazard_guard guard{detail::hazard_domain::this_thread_record()};
+        const detail::snapshot_node* const node = detail::hazard_domain::protect(current, guard.record);
+
+        // Retired nodes are not freed while protected
+        return std::forward<F>(f)(node ? node->value : detail::empty_snapshot_value());
+    }
+
+    /// Replaces the stored value with `value`.
+    /// \throws std::bad_alloc. Value is not changed if an exception is
+    /// thrown.
+    void store(boost::any value)
+    {
+        exchange(std::move(value));
+    }
+
+    /// Replaces the stored value with `value`.
+    /// \returns Snapshot of the previous value.
+    /// \throws std::bad_alloc. Value is not changed if an exception is
+    /// thrown.
+    any_snapshot exchange(boost::any value)
+    {
+        detail::snapshot_node* const node = new detail::snapshot_node(std::move(value));
+        return any_snapshot(current.exchange(node, std::memory_order_acq_rel));
+    }
+
+    /// Replaces the stored value with `desired` if the stored value is the
+    /// one referenced by `expected`. Otherwise, sets `expected` to the
+    /// snapshot of the stored value and leaves `desired` untouched.
+    ///
+    /// Values are compared by identity, not by content, so the operation
+    /// does not suffer from ABA while `expected` is alive.
+    /// \returns `true` if the value was replaced.
+    /// \throws std::bad_alloc. Value is not changed if an exception is
+    /// thrown.
+    bool compare_exchange(any_snapshot& expected, boost::any&& desired)
+    {
+        detail::snapshot_node* const node = new detail::snapshot_node(std::move(desired));
+        detail::snapshot_node* old = expected.node;
+        if (current.compare_exchange_strong(old, node, std::memory_order_acq_rel)) {
+            // Reference of the atomic_any is now owned by no one
+            detail::snapshot_node::release(old);
+            return true;
+        }
+
+        desired = std::move(node->value);
+        delete node;
+        expected = load();
+        return false;
+    }
+
+    /// \returns `true`, the operations do not use locks.
+    static constexpr bool is_lock_free() noexcept { return true; }
+
+private:
+    /// @cond
+    std::atomic<detail::snapshot_node*> current;
+    /// @endcond
+};
+
+/// Frees the values released by boost::anys::atomic_any and the
+/// replaced tables of boost::anys::concurrent_any_map that were being read
+/// at the moment of their release and are not read any more. Such values
+/// are otherwise freed only by a later release, so call it after the last
+/// modification, for example at shutdown or in tests.
+/// \throws Nothing.
+inline void reclaim_retired() noexcept
+{
+    detail::hazard_domain::instance().scan();
+}
+
+BOOST_ANY_END_MODULE_EXPORT
+
+/// @cond
+namespace detail {
+
+    // Lets the containers of snapshot nodes hand out snapshots
+    struct snapshot_access {
+        // Takes the reference that the caller owns
+        static any_snapshot adopt(snapshot_node* node) noexcept
+        {
+            return any_snapshot(node);
+        }
+    };
+
+} // namespace detail
+/// @endcond
+
+} // namespace anys
+
+} // namespace boost
+
+#endif  // #if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+#endif // #ifndef BOOST_ANYS_ATOMIC_ANY_HPP_INCLUDED
@@ -24,8 +24,18 @@
 #endif
 
 #include <stdexcept>
+
+#include <boost/throw_exception.hpp>
 #endif  // #ifndef BOOST_ANY_INTERFACE_UNIT
 
+/// @cond
+#if defined(__GNUC__) || defined(__clang__)
+#   define BOOST_ANY_COLD __attribute__((__cold__))
+#else
+#   define BOOST_ANY_COLD
+#endif
+/// @endcond
+
 namespace boost {
 
 BOOST_ANY_BEGIN_MODULE_EXPORT
@@ -49,6 +59,20 @@ public:
 
 BOOST_ANY_END_MODULE_EXPORT
 
+/// @cond
+namespace anys { namespace detail {
+
+    // Failed casts are expected to be rare, so the throwing code is kept
+    // out of the callers to keep the successful path small.
+    BOOST_NORETURN BOOST_NOINLINE BOOST_ANY_COLD
+    inline void throw_bad_any_cast()
+    {
+        boost::throw_exception(bad_any_cast());
+    }
+
+}} // namespace anys::detail
+/// @endcond
+
 } // namespace boost
 
 #endif  // #if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
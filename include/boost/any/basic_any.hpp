@@ -33,11 +33,22 @@
 
 #include <boost/any/bad_any_cast.hpp>
 #include <boost/any/fwd.hpp>
+#include <boost/any/detail/allocation.hpp>
+#ifdef BOOST_ANY_USE_HOLDER_VALUE_OPS
+#include <boost/any/detail/value_ops.hpp>
+#endif
 
 namespace boost {
 
 namespace anys {
 
+/// @cond
+namespace detail {
+    struct basic_any_access;
+    struct value_ops;
+} // namespace detail
+/// @endcond
+
 BOOST_ANY_BEGIN_MODULE_EXPORT
 
     /// \brief A class with customizable Small Object Optimization whose
@@ -59,6 +70,13 @@ BOOST_ANY_BEGIN_MODULE_EXPORT
     /// equal to the `OptimizeForSize` and `OptimizeForAlignment` values.
     ///
     /// Otherwise just use boost::any.
+    ///
+    /// The containers that take the values out of boost::anys::basic_any,
+    /// like boost::anys::any_segments, require `BOOST_ANY_USE_HOLDER_VALUE_OPS`
+    /// to be defined: the managers then report the operations on the stored
+    /// value, at the cost of instantiating them for every stored type. The
+    /// macro shall be defined consistently in all the translation units of
+    /// the program.
     template <std::size_t OptimizeForSize, std::size_t OptimizeForAlignment>
     class basic_any
     {
@@ -75,7 +93,13 @@ BOOST_ANY_BEGIN_MODULE_EXPORT
             Copy,
             AnyCast,
             UnsafeCast,
-            Typeinfo
+            Typeinfo,
+            Ops = 6,
+            // Opt-in operations have fixed values, so the macros add
+            // operations and never renumber the existing ones
+#if defined(BOOST_ANY_USE_POLYMORPHIC_CAST) && !defined(BOOST_NO_EXCEPTIONS)
+            ThrowAddress = 7
+#endif
         };
 
         template <typename ValueType>
@@ -119,6 +143,18 @@ BOOST_ANY_BEGIN_MODULE_EXPORT
                     return reinterpret_cast<typename std::remove_cv<ValueType>::type *>(&left.content.small_value);
                 case Typeinfo:
                     return const_cast<void*>(static_cast<const void*>(&boost::typeindex::type_id<ValueType>().type_info()));
+#if defined(BOOST_ANY_USE_POLYMORPHIC_CAST) && !defined(BOOST_NO_EXCEPTIONS)
+                case ThrowAddress:
+                    BOOST_ASSERT(!left.empty());
+                    throw reinterpret_cast<ValueType*>(&left.content.small_value);
+#endif
+#ifdef BOOST_ANY_USE_HOLDER_VALUE_OPS
+                case Ops:
+                    return const_cast<void*>(static_cast<const void*>(&detail::value_ops_of<ValueType>::value));
+#else
+                case Ops:
+                    break;
+#endif
             }
 
             return 0;
@@ -131,7 +167,7 @@ BOOST_ANY_BEGIN_MODULE_EXPORT
             {
                 case Destroy:
                     BOOST_ASSERT(!left.empty());
-                    delete static_cast<ValueType*>(left.content.large_value);
+                    detail::delete_value(static_cast<ValueType*>(left.content.large_value));
                     break;
                 case Move:
                     BOOST_ASSERT(left.empty());
@@ -148,7 +184,7 @@ BOOST_ANY_BEGIN_MODULE_EXPORT
                     BOOST_ASSERT(right);
                     BOOST_ASSERT(!right->empty());
                     BOOST_ASSERT(right->type() == boost::typeindex::type_id<ValueType>());
-                    left.content.large_value = new ValueType(*static_cast<const ValueType*>(right->content.large_value));
+                    left.content.large_value = detail::new_value<ValueType>(*static_cast<const ValueType*>(right->content.large_value));
                     left.man = right->man;
                     break;
                 case AnyCast:
@@ -161,6 +197,18 @@ BOOST_ANY_BEGIN_MODULE_EXPORT
                     return reinterpret_cast<typename std::remove_cv<ValueType>::type *>(left.content.large_value);
                 case Typeinfo:
                     return const_cast<void*>(static_cast<const void*>(&boost::typeindex::type_id<ValueType>().type_info()));
+#if defined(BOOST_ANY_USE_POLYMORPHIC_CAST) && !defined(BOOST_NO_EXCEPTIONS)
+                case ThrowAddress:
+                    BOOST_ASSERT(!left.empty());
+                    throw static_cast<ValueType*>(left.content.large_value);
+#endif
+#ifdef BOOST_ANY_USE_HOLDER_VALUE_OPS
+                case Ops:
+                    return const_cast<void*>(static_cast<const void*>(&detail::value_ops_of<ValueType>::value));
+#else
+                case Ops:
+                    break;
+#endif
             }
 
             return 0;
@@ -178,7 +226,7 @@ BOOST_ANY_BEGIN_MODULE_EXPORT
             using DecayedType = typename std::decay<const ValueType>::type;
 
             any.man = &small_manager<DecayedType>;
-            new (&any.content.small_value) ValueType(value);
+            new (&any.content.small_value) DecayedType(value);
         }
 
         template <typename ValueType>
@@ -187,7 +235,7 @@ BOOST_ANY_BEGIN_MODULE_EXPORT
             using DecayedType = typename std::decay<const ValueType>::type;
 
             any.man = &large_manager<DecayedType>;
-            any.content.large_value = new DecayedType(value);
+            any.content.large_value = detail::new_value<DecayedType>(value);
         }
 
         template <typename ValueType>
@@ -203,7 +251,7 @@ BOOST_ANY_BEGIN_MODULE_EXPORT
         {
             using DecayedType = typename std::decay<const ValueType>::type;
             any.man = &large_manager<DecayedType>;
-            any.content.large_value = new DecayedType(std::forward<ValueType>(value));
+            any.content.large_value = detail::new_value<DecayedType>(std::forward<ValueType>(value));
         }
         /// @endcond
 
@@ -241,7 +289,7 @@ BOOST_ANY_BEGIN_MODULE_EXPORT
                 !anys::detail::is_basic_any<ValueType>::value,
                 "boost::anys::basic_any<A, B> shall not be constructed from boost::anys::basic_any<C, D>"
             );
-            create(*this, value, is_small_object<ValueType>());
+            create(*this, value, is_small_object<typename std::decay<const ValueType>::type>());
         }
 
         /// Copy constructor that copies content of
@@ -440,6 +488,8 @@ BOOST_ANY_BEGIN_MODULE_EXPORT
         template<typename ValueType, std::size_t Size, std::size_t Alignment>
         friend ValueType * unsafe_any_cast(basic_any<Size, Alignment> *) noexcept;
 
+        friend struct detail::basic_any_access;
+
         typedef void*(*manager)(operation op, basic_any& left, const basic_any* right, const boost::typeindex::type_info* info);
 
         manager man;
@@ -451,6 +501,154 @@ BOOST_ANY_BEGIN_MODULE_EXPORT
         /// @endcond
     };
 
+/// @cond
+BOOST_ANY_END_MODULE_EXPORT
+
+namespace detail {
+
+    // Access to the internals of basic_any for the library facilities that
+    // work with the manager pointer as with the identity of the stored type.
+    struct basic_any_access {
+        // Manager that basic_any<Size, Alignment> uses for `ValueType`.
+        template <class ValueType, std::size_t Size, std::size_t Alignment>
+        static typename basic_any<Size, Alignment>::manager identity_of() noexcept
+        {
+            return basic_any_access::identity_of_impl<ValueType, Size, Alignment>(
+                typename basic_any<Size, Alignment>::template is_small_object<ValueType>()
+            );
+        }
+
+        template <std::size_t Size, std::size_t Alignment>
+        static typename basic_any<Size, Alignment>::manager identity(const basic_any<Size, Alignment>& operand) noexcept
+        {
+            return operand.man;
+        }
+
+        // Pointer to the stored `ValueType` without calling the manager.
+        // The caller is responsible for checking the identity.
+        template <class ValueType, std::size_t Size, std::size_t Alignment>
+        static ValueType* get(basic_any<Size, Alignment>& operand) noexcept
+        {
+            BOOST_ASSERT(operand.man == (basic_any_access::identity_of<typename std::remove_cv<ValueType>::type, Size, Alignment>()));
+            return basic_any_access::get_impl<ValueType>(operand,
+                typename basic_any<Size, Alignment>::template is_small_object<typename std::remove_cv<ValueType>::type>()
+            );
+        }
+
+        template <class ValueType, std::size_t Size, std::size_t Alignment>
+        static const ValueType* get(const basic_any<Size, Alignment>& operand) noexcept
+        {
+            return basic_any_access::get<const ValueType>(const_cast<basic_any<Size, Alignment>&>(operand));
+        }
+
+        // Pointer to the stored value, nullptr if `operand` is empty.
+        template <std::size_t Size, std::size_t Alignment>
+        static void* address(basic_any<Size, Alignment>& operand) noexcept
+        {
+            return operand.man ? operand.man(basic_any<Size, Alignment>::UnsafeCast, operand, 0, 0) : 0;
+        }
+
+#if defined(BOOST_ANY_USE_POLYMORPHIC_CAST) && !defined(BOOST_NO_EXCEPTIONS)
+        // Throws the pointer to the stored value, see placeholder::throw_address().
+        template <std::size_t Size, std::size_t Alignment>
+        static void throw_address(basic_any<Size, Alignment>& operand)
+        {
+            BOOST_ASSERT(operand.man);
+            operand.man(basic_any<Size, Alignment>::ThrowAddress, operand, 0, 0);
+        }
+#endif
+
+        // Operations on the stored type, nullptr if `operand` is empty.
+        // Opt-in, as the managers instantiate value_ops_of for each stored
+        // type to provide them.
+        template <std::size_t Size, std::size_t Alignment>
+        static const value_ops* ops(const basic_any<Size, Alignment>& operand) noexcept
+        {
+#ifdef BOOST_ANY_USE_HOLDER_VALUE_OPS
+            return operand.man
+                ? static_cast<const value_ops*>(operand.man(basic_any<Size, Alignment>::Ops, const_cast<basic_any<Size, Alignment>&>(operand), 0, 0))
+                : nullptr;
+#else
+            static_assert(
+                Size == 0,
+                "boost::anys containers require BOOST_ANY_USE_HOLDER_VALUE_OPS to take the values of boost::anys::basic_any"
+            );
+            (void)operand;
+            return nullptr;
+#endif
+        }
+
+        // Constructs `ValueType` from `args` right in the empty `operand`.
+        // `operand` stays empty if an exception is thrown.
+        template <class ValueType, std::size_t Size, std::size_t Alignment, class... Args>
+        static void emplace(basic_any<Size, Alignment>& operand, Args&&... args)
+        {
+            static_assert(
+                std::is_same<ValueType, typename std::decay<ValueType>::type>::value,
+                "boost::anys::basic_any stores only decayed types"
+            );
+            BOOST_ASSERT(!operand.man);
+            basic_any_access::emplace_impl<ValueType>(operand,
+                typename basic_any<Size, Alignment>::template is_small_object<ValueType>(),
+                std::forward<Args>(args)...
+            );
+            operand.man = basic_any_access::identity_of<ValueType, Size, Alignment>();
+        }
+
+        // Destroys the content, leaving the `operand` empty.
+        template <std::size_t Size, std::size_t Alignment>
+        static void reset(basic_any<Size, Alignment>& operand) noexcept
+        {
+            if (operand.man)
+            {
+                operand.man(basic_any<Size, Alignment>::Destroy, operand, 0, 0);
+                operand.man = 0;
+            }
+        }
+
+    private:
+        template <class ValueType, std::size_t Size, std::size_t Alignment>
+        static typename basic_any<Size, Alignment>::manager identity_of_impl(std::true_type) noexcept
+        {
+            return &basic_any<Size, Alignment>::template small_manager<ValueType>;
+        }
+
+        template <class ValueType, std::size_t Size, std::size_t Alignment>
+        static typename basic_any<Size, Alignment>::manager identity_of_impl(std::false_type) noexcept
+        {
+            return &basic_any<Size, Alignment>::template large_manager<ValueType>;
+        }
+
+        template <class ValueType, std::size_t Size, std::size_t Alignment, class... Args>
+        static void emplace_impl(basic_any<Size, Alignment>& operand, std::true_type, Args&&... args)
+        {
+            ::new (&operand.content.small_value) ValueType(std::forward<Args>(args)...);
+        }
+
+        template <class ValueType, std::size_t Size, std::size_t Alignment, class... Args>
+        static void emplace_impl(basic_any<Size, Alignment>& operand, std::false_type, Args&&... args)
+        {
+            operand.content.large_value = detail::new_value<ValueType>(std::forward<Args>(args)...);
+        }
+
+        template <class ValueType, std::size_t Size, std::size_t Alignment>
+        static ValueType* get_impl(basic_any<Size, Alignment>& operand, std::true_type) noexcept
+        {
+            return reinterpret_cast<ValueType*>(&operand.content.small_value);
+        }
+
+        template <class ValueType, std::size_t Size, std::size_t Alignment>
+        static ValueType* get_impl(basic_any<Size, Alignment>& operand, std::false_type) noexcept
+        {
+            return static_cast<ValueType*>(operand.content.large_value);
+        }
+    };
+
+} // namespace detail
+
+BOOST_ANY_BEGIN_MODULE_EXPORT
+/// @endcond
+
     /// Exchange of the contents of `lhs` and `rhs`.
     /// \throws Nothing.
     template<std::size_t OptimizeForSize, std::size_t OptimizeForAlignment>
@@ -487,7 +685,7 @@ BOOST_ANY_BEGIN_MODULE_EXPORT
 
         nonref * result = boost::anys::any_cast<nonref>(std::addressof(operand));
         if(!result)
-            boost::throw_exception(bad_any_cast());
+            detail::throw_bad_any_cast();
 
         // Attempt to avoid construction of a temporary object in cases when
         // `ValueType` is not a reference. Example:
@@ -0,0 +1,498 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/any for Documentation.
+
+#ifndef BOOST_ANYS_BASIC_ANY_HINTED_HPP_INCLUDED
+#define BOOST_ANYS_BASIC_ANY_HINTED_HPP_INCLUDED
+
+#include <boost/any/detail/config.hpp>
+
+#if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+/// \file boost/any/basic_any_hinted.hpp
+/// \brief \copybrief boost::anys::basic_any_hinted
+
+#ifndef BOOST_ANY_INTERFACE_UNIT
+#include <boost/config.hpp>
+#ifdef BOOST_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include <memory>  // for std::addressof
+#include <type_traits>
+#include <utility>
+
+#include <boost/type_index.hpp>
+#endif  // #ifndef BOOST_ANY_INTERFACE_UNIT
+
+#include <boost/any/bad_any_cast.hpp>
+#include <boost/any/basic_any.hpp>
+
+namespace boost {
+
+namespace anys {
+
+/// @cond
+namespace detail {
+
+    // 1-based position of `T` in `Hints...`, 0 if `T` is not hinted.
+    template <class T, class... Hints>
+    struct hint_index: std::integral_constant<std::size_t, 0> {};
+
+    template <class T, class... Rest>
+    struct hint_index<T, T, Rest...>: std::integral_constant<std::size_t, 1> {};
+
+    template <class T, class Head, class... Rest>
+    struct hint_index<T, Head, Rest...>: std::integral_constant<
+        std::size_t,
+        hint_index<T, Rest...>::value ? hint_index<T, Rest...>::value + 1 : 0
+    > {};
+
+    struct hinted_access;
+
+} // namespace detail
+/// @endcond
+
+BOOST_ANY_BEGIN_MODULE_EXPORT
+
+    /// \brief A boost::anys::basic_any with a closed set of expected types.
+    ///
+    /// boost::anys::basic_any_hinted behaves as boost::anys::basic_any with
+    /// the same `OptimizeForSize` and `OptimizeForAlignment` and can hold
+    /// instances of any type that satisfies \forcedlink{ValueType}
+    /// requirements.
+    ///
+    /// Each of the `Hints...` types gets a small integer tag that is stored
+    /// inline. boost::any_cast to a hinted type is an integer comparison
+    /// and boost::anys::visit over the hinted types is a jump through a
+    /// table, so the dispatch cost is close to the one of `std::variant`.
+    /// Types that are not hinted are handled as in boost::anys::basic_any.
+    template <std::size_t OptimizeForSize, std::size_t OptimizeForAlignment, class... Hints>
+    class basic_any_hinted
+    {
+        static_assert(sizeof...(Hints) < 255, "Too many hinted types");
+    private:
+        /// @cond
+        using base_type = basic_any<OptimizeForSize, OptimizeForAlignment>;
+
+        template <typename ValueType>
+        struct hint_of : std::integral_constant<unsigned char, static_cast<unsigned char>(
+            detail::hint_index<ValueType, Hints...>::value
+        )>
+        {};
+        /// @endcond
+
+    public: // non-type template parameters accessors
+            static constexpr std::size_t buffer_size = OptimizeForSize;
+            static constexpr std::size_t buffer_align = OptimizeForAlignment;
+
+    public: // structors
+
+        /// \post this->empty() is true.
+        constexpr basic_any_hinted() noexcept
+            : value(), hint(0)
+        {
+        }
+
+        /// Makes a copy of `value`, so
+        /// that the initial content of the new instance is equivalent
+        /// in both type and value to `value`.
+        ///
+        /// Does not dynamically allocate if `ValueType` is nothrow
+        /// move constructible and `sizeof(value) <= OptimizeForSize` and
+        /// `alignof(value) <= OptimizeForAlignment`.
+        ///
+        /// \throws std::bad_alloc or any exceptions arising from the copy
+        /// constructor of the contained type.
+        template<typename ValueType>
+        basic_any_hinted(const ValueType & value)
+            : value(basic_any_hinted::checked_value(value))
+            , hint(hint_of<typename std::decay<const ValueType>::type>::value)
+        {
+        }
+
+        /// Copy constructor that copies content of
+        /// `other` into new instance, so that any content
+        /// is equivalent in both type and value to the content of
+        /// `other`, or empty if `other` is empty.
+        ///
+        /// \throws May fail with a `std::bad_alloc`
+        /// exception or any exceptions arising from the copy
+        /// constructor of the contained type.
+        basic_any_hinted(const basic_any_hinted & other)
+          : value(other.value), hint(other.hint)
+        {
+        }
+
+        /// Move constructor that moves content of
+        /// `other` into new instance and leaves `other` empty.
+        ///
+        /// \post other->empty() is true
+        /// \throws Nothing.
+        basic_any_hinted(basic_any_hinted&& other) noexcept
+          : value(std::move(other.value)), hint(other.hint)
+        {
+            other.hint = 0;
+        }
+
+        /// Forwards `value`, so
+        /// that the initial content of the new instance is equivalent
+        /// in both type and value to `value` before the forward.
+        ///
+        /// Does not dynamically allocate if `ValueType` is nothrow
+        /// move constructible and `sizeof(value) <= OptimizeForSize` and
+        /// `alignof(value) <= OptimizeForAlignment`.
+        ///
+        /// \throws std::bad_alloc or any exceptions arising from the move or
+        /// copy constructor of the contained type.
+        template<typename ValueType>
+        basic_any_hinted(ValueType&& value
+            , typename std::enable_if<!std::is_same<basic_any_hinted&, ValueType>::value >::type* = 0 // disable if value has type `basic_any_hinted&`
+            , typename std::enable_if<!std::is_const<ValueType>::value >::type* = 0) // disable if value has type `const ValueType&&`
+          : value(basic_any_hinted::checked_value(static_cast<ValueType&&>(value)))
+          , hint(hint_of<typename std::decay<ValueType>::type>::value)
+        {
+        }
+
+    public: // modifiers
+
+        /// Exchange of the contents of `*this` and `rhs`.
+        ///
+        /// \returns `*this`
+        /// \throws Nothing.
+        basic_any_hinted & swap(basic_any_hinted & rhs) noexcept
+        {
+            value.swap(rhs.value);
+            std::swap(hint, rhs.hint);
+            return *this;
+        }
+
+        /// Copies content of `rhs` into
+        /// current instance, discarding previous content, so that the
+        /// new content is equivalent in both type and value to the
+        /// content of `rhs`, or empty if `rhs.empty()`.
+        ///
+        /// \throws std::bad_alloc
+        /// or any exceptions arising from the copy constructor of the
+        /// contained type. Assignment satisfies the strong guarantee
+        /// of exception safety.
+        basic_any_hinted & operator=(const basic_any_hinted& rhs)
+        {
+            basic_any_hinted(rhs).swap(*this);
+            return *this;
+        }
+
+        /// Moves content of `rhs` into
+        /// current instance, discarding previous content, so that the
+        /// new content is equivalent in both type and value to the
+        /// content of `rhs` before move, or empty if
+        /// `rhs.empty()`.
+        ///
+        /// \post `rhs->empty()` is true
+        /// \throws Nothing.
+        basic_any_hinted & operator=(basic_any_hinted&& rhs) noexcept
+        {
+            rhs.swap(*this);
+            basic_any_hinted().swap(rhs);
+            return *this;
+        }
+
+        /// Forwards `rhs`,
+        /// discarding previous content, so that the new content of is
+        /// equivalent in both type and value to
+        /// `rhs` before forward.
+        ///
+        /// \throws std::bad_alloc
+        /// or any exceptions arising from the move or copy constructor of the
+        /// contained type. Assignment satisfies the strong guarantee
+        /// of exception safety.
+        template <class ValueType>
+        basic_any_hinted & operator=(ValueType&& rhs)
+        {
+            using DecayedType = typename std::decay<ValueType>::type;
+            static_assert(
+                !std::is_same<DecayedType, boost::any>::value,
+                "boost::any shall not be assigned into boost::anys::basic_any_hinted"
+            );
+            static_assert(
+                !anys::detail::is_basic_any<DecayedType>::value || std::is_same<DecayedType, basic_any_hinted>::value,
+                "other boost::anys::basic_any shall not be assigned into boost::anys::basic_any_hinted"
+            );
+            basic_any_hinted(std::forward<ValueType>(rhs)).swap(*this);
+            return *this;
+        }
+
+    public: // queries
+
+        /// \returns `true` if instance is empty, otherwise `false`.
+        /// \throws Nothing.
+        bool empty() const noexcept
+        {
+            return value.empty();
+        }
+
+        /// \post this->empty() is true
+        void clear() noexcept
+        {
+            basic_any_hinted().swap(*this);
+        }
+
+        /// \returns the `typeid` of the
+        /// contained value if instance is non-empty, otherwise
+        /// `typeid(void)`.
+        ///
+        /// Useful for querying against types known either at compile time or
+        /// only at runtime.
+        const boost::typeindex::type_info& type() const noexcept
+        {
+            return value.type();
+        }
+
+        /// \returns 1-based position of the contained type in `Hints...`,
+        /// or 0 if the instance is empty or contains a type that is not hinted.
+        std::size_t hint_index() const noexcept
+        {
+            return hint;
+        }
+
+    private: // representation
+        /// @cond
+        template <typename ValueType>
+        static ValueType&& checked_value(ValueType&& value) noexcept
+        {
+            using DecayedType = typename std::decay<ValueType>::type;
+            static_assert(
+                !std::is_same<DecayedType, boost::any>::value,
+                "boost::anys::basic_any_hinted shall not be constructed from boost::any"
+            );
+            static_assert(
+                !anys::detail::is_basic_any<DecayedType>::value,
+                "boost::anys::basic_any_hinted shall not be constructed from other boost::anys::basic_any"
+            );
+            return static_cast<ValueType&&>(value);
+        }
+
+        friend struct detail::hinted_access;
+
+        // Storage and managers are the ones of basic_any, the hint only
+        // selects the fast paths
+        base_type value;
+        unsigned char hint;
+        /// @endcond
+    };
+
+/// @cond
+BOOST_ANY_END_MODULE_EXPORT
+
+namespace detail {
+
+    struct hinted_access {
+        template <std::size_t Size, std::size_t Alignment, class... Hints>
+        static basic_any<Size, Alignment>& base(basic_any_hinted<Size, Alignment, Hints...>& operand) noexcept
+        {
+            return operand.value;
+        }
+
+        template <class ValueType, std::size_t Size, std::size_t Alignment, class... Hints>
+        static ValueType* get(basic_any_hinted<Size, Alignment, Hints...>& operand) noexcept
+        {
+            return basic_any_access::get<ValueType>(operand.value);
+        }
+
+        template <class ValueType, std::size_t Size, std::size_t Alignment, class... Hints>
+        static ValueType* cast(basic_any_hinted<Size, Alignment, Hints...>& operand, std::true_type) noexcept
+        {
+            using any_type = basic_any_hinted<Size, Alignment, Hints...>;
+            using T = typename std::remove_cv<ValueType>::type;
+            return operand.hint == any_type::template hint_of<T>::value ? hinted_access::get<T>(operand) : 0;
+        }
+
+        template <class ValueType, std::size_t Size, std::size_t Alignment, class... Hints>
+        static ValueType* cast(basic_any_hinted<Size, Alignment, Hints...>& operand, std::false_type) noexcept
+        {
+            return anys::any_cast<ValueType>(&operand.value);
+        }
+
+        template <class ValueType, std::size_t Size, std::size_t Alignment, class... Hints>
+        static ValueType* unsafe_cast(basic_any_hinted<Size, Alignment, Hints...>& operand) noexcept
+        {
+            return anys::unsafe_any_cast<ValueType>(&operand.value);
+        }
+
+        template <class R, class T, class Visitor, class Any>
+        static R visit_hinted(Visitor& vis, Any& operand)
+        {
+            return static_cast<Visitor&&>(vis)(*hinted_access::get<T>(const_cast<typename std::remove_const<Any>::type&>(operand)));
+        }
+
+        template <class R, class Visitor, class Any>
+        static R visit_generic(Visitor& vis, Any& operand)
+        {
+            return static_cast<Visitor&&>(vis)(operand);
+        }
+
+        template <class R, class Visitor, class Any, class... Hints>
+        static R visit(Visitor& vis, Any& operand)
+        {
+            using func_t = R(*)(Visitor&, Any&);
+            static const func_t table[] = {
+                &hinted_access::visit_generic<R, Visitor, Any>,
+                &hinted_access::visit_hinted<R, typename std::conditional<std::is_const<Any>::value, const Hints, Hints>::type, Visitor, Any>...
+            };
+            return table[operand.hint](vis, operand);
+        }
+    };
+
+} // namespace detail
+
+BOOST_ANY_BEGIN_MODULE_EXPORT
+/// @endcond
+
+    /// Exchange of the contents of `lhs` and `rhs`.
+    /// \throws Nothing.
+    template<std::size_t OptimizeForSize, std::size_t OptimizeForAlignment, class... Hints>
+    void swap(basic_any_hinted<OptimizeForSize, OptimizeForAlignment, Hints...>& lhs, basic_any_hinted<OptimizeForSize, OptimizeForAlignment, Hints...>& rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
+    /// \returns Pointer to a ValueType stored in `operand`, nullptr if
+    /// `operand` does not contain specified `ValueType`.
+    ///
+    /// For hinted `ValueType` the check is a single integer comparison.
+    template<typename ValueType, std::size_t Size, std::size_t Alignment, class... Hints>
+    ValueType * any_cast(basic_any_hinted<Size, Alignment, Hints...> * operand) noexcept
+    {
+        return operand ? detail::hinted_access::cast<ValueType>(*operand, std::integral_constant<bool,
+                detail::hint_index<typename std::remove_cv<ValueType>::type, Hints...>::value != 0
+            >()) : 0;
+    }
+
+    /// \returns Const pointer to a ValueType stored in `operand`, nullptr if
+    /// `operand` does not contain specified `ValueType`.
+    template<typename ValueType, std::size_t Size, std::size_t Alignment, class... Hints>
+    inline const ValueType * any_cast(const basic_any_hinted<Size, Alignment, Hints...> * operand) noexcept
+    {
+        return boost::anys::any_cast<ValueType>(const_cast<basic_any_hinted<Size, Alignment, Hints...> *>(operand));
+    }
+
+    /// \returns ValueType stored in `operand`
+    /// \throws boost::bad_any_cast if `operand` does not contain
+    /// specified ValueType.
+    template<typename ValueType, std::size_t Size, std::size_t Alignment, class... Hints>
+    ValueType any_cast(basic_any_hinted<Size, Alignment, Hints...> & operand)
+    {
+        using nonref = typename std::remove_reference<ValueType>::type;
+
+        nonref * result = boost::anys::any_cast<nonref>(std::addressof(operand));
+        if(!result)
+            detail::throw_bad_any_cast();
+
+        // Attempt to avoid construction of a temporary object in cases when
+        // `ValueType` is not a reference. Example:
+        // `static_cast<std::string>(*result);`
+        // which is equal to `std::string(*result);`
+        typedef typename std::conditional<
+            std::is_reference<ValueType>::value,
+            ValueType,
+            typename std::add_lvalue_reference<ValueType>::type
+        >::type ref_type;
+
+#ifdef BOOST_MSVC
+#   pragma warning(push)
+#   pragma warning(disable: 4172) // "returning address of local variable or temporary" but *result is not local!
+#endif
+        return static_cast<ref_type>(*result);
+#ifdef BOOST_MSVC
+#   pragma warning(pop)
+#endif
+    }
+
+    /// \returns `ValueType` stored in `operand`
+    /// \throws boost::bad_any_cast if `operand` does not contain
+    /// specified `ValueType`.
+    template<typename ValueType, std::size_t Size, std::size_t Alignment, class... Hints>
+    inline ValueType any_cast(const basic_any_hinted<Size, Alignment, Hints...> & operand)
+    {
+        using nonref = typename std::remove_reference<ValueType>::type;
+        return boost::anys::any_cast<const nonref &>(const_cast<basic_any_hinted<Size, Alignment, Hints...> &>(operand));
+    }
+
+    /// \returns `ValueType` stored in `operand`, leaving the `operand` empty.
+    /// \throws boost::bad_any_cast if `operand` does not contain
+    /// specified `ValueType`.
+    template<typename ValueType, std::size_t Size, std::size_t Alignment, class... Hints>
+    inline ValueType any_cast(basic_any_hinted<Size, Alignment, Hints...>&& operand)
+    {
+        static_assert(
+            std::is_rvalue_reference<ValueType&&>::value /*true if ValueType is rvalue or just a value*/
+            || std::is_const< typename std::remove_reference<ValueType>::type >::value,
+            "boost::any_cast shall not be used for getting nonconst references to temporary objects"
+        );
+        return boost::anys::any_cast<ValueType>(operand);
+    }
+
+    /// Calls `vis(value)` with a reference to the contained value if
+    /// `operand` holds one of the hinted types, and `vis(operand)` otherwise
+    /// (including the case of an empty `operand`).
+    ///
+    /// Dispatch over the hinted types is a single indexed jump.
+    ///
+    /// \returns the result of the `vis` invocation.
+    template<class Visitor, std::size_t Size, std::size_t Alignment, class... Hints>
+    auto visit(Visitor&& vis, basic_any_hinted<Size, Alignment, Hints...>& operand)
+        -> decltype(vis(operand))
+    {
+        using result_t = decltype(vis(operand));
+        return detail::hinted_access::visit<result_t, Visitor, basic_any_hinted<Size, Alignment, Hints...>, Hints...>(vis, operand);
+    }
+
+    /// \copydoc boost::anys::visit(Visitor&&, basic_any_hinted<Size, Alignment, Hints...>&)
+    template<class Visitor, std::size_t Size, std::size_t Alignment, class... Hints>
+    auto visit(Visitor&& vis, const basic_any_hinted<Size, Alignment, Hints...>& operand)
+        -> decltype(vis(operand))
+    {
+        using result_t = decltype(vis(operand));
+        return detail::hinted_access::visit<result_t, Visitor, const basic_any_hinted<Size, Alignment, Hints...>, Hints...>(vis, operand);
+    }
+
+    /// @cond
+
+    // Note: The "unsafe" versions of any_cast are not part of the
+    // public interface and may be removed at any time. They are
+    // required where we know what type is stored in the any and can't
+    // use typeid() comparison, e.g., when our types may travel across
+    // different shared libraries.
+    template<typename ValueType, std::size_t Size, std::size_t Alignment, class... Hints>
+    inline ValueType * unsafe_any_cast(basic_any_hinted<Size, Alignment, Hints...> * operand) noexcept
+    {
+        return detail::hinted_access::unsafe_cast<ValueType>(*operand);
+    }
+
+    template<typename ValueType, std::size_t Size, std::size_t Alignment, class... Hints>
+    inline const ValueType * unsafe_any_cast(const basic_any_hinted<Size, Alignment, Hints...> * operand) noexcept
+    {
+        return boost::anys::unsafe_any_cast<ValueType>(const_cast<basic_any_hinted<Size, Alignment, Hints...> *>(operand));
+    }
+    /// @endcond
+
+BOOST_ANY_END_MODULE_EXPORT
+
+} // namespace anys
+
+BOOST_ANY_BEGIN_MODULE_EXPORT
+
+using boost::anys::any_cast;
+using boost::anys::unsafe_any_cast;
+
+BOOST_ANY_END_MODULE_EXPORT
+
+} // namespace boost
+
+#endif  // #if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+#endif // #ifndef BOOST_ANYS_BASIC_ANY_HINTED_HPP_INCLUDED
@@ -0,0 +1,597 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/any for Documentation.
+
+#ifndef BOOST_ANYS_COMPACT_ANY_HPP_INCLUDED
+#define BOOST_ANYS_COMPACT_ANY_HPP_INCLUDED
+
+#include <boost/any/detail/config.hpp>
+
+#if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+/// \file boost/any/compact_any.hpp
+/// \brief \copybrief boost::anys::compact_any
+
+#ifndef BOOST_ANY_INTERFACE_UNIT
+#include <boost/config.hpp>
+#ifdef BOOST_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>  // for std::addressof
+#include <type_traits>
+#include <utility>
+
+#include <boost/assert.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/type_index.hpp>
+#endif  // #ifndef BOOST_ANY_INTERFACE_UNIT
+
+#include <boost/any/bad_any_cast.hpp>
+#include <boost/any/fwd.hpp>
+#include <boost/any/detail/placeholder.hpp>
+
+/// Maximal count of distinct types that boost::anys::compact_any
+/// stores inline, in the order of their first store. Values of other types
+/// are stored on the heap.
+/// Shall not exceed 32767.
+#ifndef BOOST_ANY_COMPACT_ANY_MAX_INLINE_TYPES
+#   define BOOST_ANY_COMPACT_ANY_MAX_INLINE_TYPES 1024
+#endif
+
+namespace boost {
+
+namespace anys {
+
+/// @cond
+namespace detail {
+
+    static_assert(
+        BOOST_ANY_COMPACT_ANY_MAX_INLINE_TYPES > 0 && BOOST_ANY_COMPACT_ANY_MAX_INLINE_TYPES <= 32767,
+        "BOOST_ANY_COMPACT_ANY_MAX_INLINE_TYPES shall be in range [1, 32767]"
+    );
+
+    // The tag is the lowest 16 bits of the 8 byte word. For heap pointers the
+    // lowest bit is always 0, for inline values it is 1 and the rest 15 bits
+    // keep the index of the type in the compact_registry.
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    constexpr std::size_t compact_tag_offset = 6;
+    constexpr std::size_t compact_payload_begin = 0;
+    constexpr std::size_t compact_payload_end = 6;
+#else
+    constexpr std::size_t compact_tag_offset = 0;
+    constexpr std::size_t compact_payload_begin = 2;
+    constexpr std::size_t compact_payload_end = 8;
+#endif
+
+    template <class T>
+    struct compact_payload_offset: std::integral_constant<std::size_t,
+        (compact_payload_begin + alignof(T) - 1) / alignof(T) * alignof(T)
+    > {};
+
+    template <class T>
+    struct is_compact_inline: std::integral_constant<bool,
+        std::is_trivially_copyable<T>::value &&
+        alignof(T) <= 8 &&
+        compact_payload_offset<T>::value + sizeof(T) <= compact_payload_end
+    > {};
+
+    // Index of `T` in the compact_registry, 0 until the first inline store
+    // of `T` or if the registry is full
+    template <class T>
+    struct compact_type_index {
+        static std::atomic<std::uint16_t> value;
+    };
+
+    template <class T>
+    std::atomic<std::uint16_t> compact_type_index<T>::value{0};
+
+    // Types take indexes only when stored, so casts to other types do not
+    // waste the 15 bit space. Each shared library with hidden symbols has
+    // its own copy of the statics, see boost::anys::compact_any.
+    struct BOOST_SYMBOL_VISIBLE compact_registry {
+        static const boost::typeindex::type_info** table() noexcept {
+            static const boost::typeindex::type_info* types[BOOST_ANY_COMPACT_ANY_MAX_INLINE_TYPES + 1] = {};
+            return types;
+        }
+
+        // Returns 0 if the registry is full.
+        static std::uint16_t add(const boost::typeindex::type_info& info, std::atomic<std::uint16_t>& published) noexcept {
+            static std::atomic<unsigned> counter{0};
+            const unsigned index = counter.fetch_add(1, std::memory_order_relaxed) + 1;
+            if (index > BOOST_ANY_COMPACT_ANY_MAX_INLINE_TYPES) {
+                return 0;
+            }
+
+            table()[index] = &info;
+            published.store(static_cast<std::uint16_t>(index), std::memory_order_release);
+            return static_cast<std::uint16_t>(index);
+        }
+
+        // Registers `T` on the first call
+        template <class T>
+        static std::uint16_t acquire() noexcept {
+            static const std::uint16_t value = compact_registry::add(
+                boost::typeindex::type_id<T>().type_info(), compact_type_index<T>::value
+            );
+            return value;
+        }
+
+        // Returns 0 if `T` was never stored inline
+        template <class T>
+        static std::uint16_t find() noexcept {
+            return compact_type_index<T>::value.load(std::memory_order_acquire);
+        }
+    };
+
+} // namespace detail
+/// @endcond
+
+BOOST_ANY_BEGIN_MODULE_EXPORT
+
+/// \brief An 8 byte class whose instances can hold instances of any
+/// type that satisfies \forcedlink{ValueType} requirements.
+///
+/// Trivially copyable values that fit into 6 bytes (4 bytes for values
+/// with 4 byte alignment) are stored inline along with a 15 bit index of
+/// their type. Other values are allocated on the heap and the pointer to
+/// them is stored in the same 8 bytes.
+///
+/// Use boost::anys::compact_any for huge collections of mostly small values,
+/// where the size of boost::anys::basic_any becomes the bottleneck.
+///
+/// A type takes its index on the first inline store, casts do not take
+/// indexes. The indexes are assigned by each module separately if the shared
+/// libraries do not export the inline functions, as with hidden visibility
+/// of the value types or on Windows. Inline values shall not be passed
+/// between such modules: the same index may mean different types there.
+class compact_any {
+public:
+    /// \post this->empty() is true.
+    constexpr compact_any() noexcept
+      : storage()
+    {
+    }
+
+    /// Makes a copy of `value`, so
+    /// that the initial content of the new instance is equivalent
+    /// in both type and value to `value`.
+    ///
+    /// \throws std::bad_alloc or any exceptions arising from the copy
+    /// constructor of the contained type.
+    template<typename ValueType>
+    compact_any(const ValueType & value)
+      : storage()
+    {
+        static_assert(
+            !anys::detail::is_some_any<ValueType>::value,
+            "boost::anys::compact_any shall not be constructed from other boost::any types"
+        );
+        create(value);
+    }
+
+    /// Copy constructor that copies content of
+    /// `other` into new instance, so that any content
+    /// is equivalent in both type and value to the content of
+    /// `other`, or empty if `other` is empty.
+    ///
+    /// \throws May fail with a `std::bad_alloc`
+    /// exception or any exceptions arising from the copy
+    /// constructor of the contained type.
+    compact_any(const compact_any & other)
+      : storage()
+    {
+        if (other.is_heap()) {
+            set_pointer(other.pointer()->clone());
+        } else {
+            std::memcpy(storage, other.storage, sizeof(storage));
+        }
+    }
+
+    /// Move constructor that moves content of
+    /// `other` into new instance and leaves `other` empty.
+    ///
+    /// \post other->empty() is true
+    /// \throws Nothing.
+    compact_any(compact_any&& other) noexcept
+      : storage()
+    {
+        std::memcpy(storage, other.storage, sizeof(storage));
+        std::memset(other.storage, 0, sizeof(storage));
+    }
+
+    /// Forwards `value`, so
+    /// that the initial content of the new instance is equivalent
+    /// in both type and value to `value` before the forward.
+    ///
+    /// \throws std::bad_alloc or any exceptions arising from the move or
+    /// copy constructor of the contained type.
+    template<typename ValueType>
+    compact_any(ValueType&& value
+        , typename std::enable_if<!std::is_same<compact_any&, ValueType>::value >::type* = 0 // disable if value has type `compact_any&`
+        , typename std::enable_if<!std::is_const<ValueType>::value >::type* = 0) // disable if value has type `const ValueType&&`
+      : storage()
+    {
+        static_assert(
+            !anys::detail::is_some_any<typename std::decay<ValueType>::type>::value,
+            "boost::anys::compact_any shall not be constructed from other boost::any types"
+        );
+        create(std::forward<ValueType>(value));
+    }
+
+    /// Releases any and all resources used in management of instance.
+    ///
+    /// \throws Nothing.
+    ~compact_any() noexcept
+    {
+        if (is_heap()) {
+            delete pointer();
+        }
+    }
+
+public: // modifiers
+
+    /// Exchange of the contents of `*this` and `rhs`.
+    ///
+    /// \returns `*this`
+    /// \throws Nothing.
+    compact_any & swap(compact_any & rhs) noexcept
+    {
+        unsigned char tmp[sizeof(storage)];
+        std::memcpy(tmp, storage, sizeof(storage));
+        std::memcpy(storage, rhs.storage, sizeof(storage));
+        std::memcpy(rhs.storage, tmp, sizeof(storage));
+        return *this;
+    }
+
+    /// Copies content of `rhs` into
+    /// current instance, discarding previous content, so that the
+    /// new content is equivalent in both type and value to the
+    /// content of `rhs`, or empty if `rhs.empty()`.
+    ///
+    /// \throws std::bad_alloc
+    /// or any exceptions arising from the copy constructor of the
+    /// contained type. Assignment satisfies the strong guarantee
+    /// of exception safety.
+    compact_any & operator=(const compact_any& rhs)
+    {
+        compact_any(rhs).swap(*this);
+        return *this;
+    }
+
+    /// Moves content of `rhs` into
+    /// current instance, discarding previous content, so that the
+    /// new content is equivalent in both type and value to the
+    /// content of `rhs` before move, or empty if
+    /// `rhs.empty()`.
+    ///
+    /// \post `rhs->empty()` is true
+    /// \throws Nothing.
+    compact_any & operator=(compact_any&& rhs) noexcept
+    {
+        rhs.swap(*this);
+        compact_any().swap(rhs);
+        return *this;
+    }
+
+    /// Forwards `rhs`,
+    /// discarding previous content, so that the new content of is
+    /// equivalent in both type and value to
+    /// `rhs` before forward.
+    ///
+    /// \throws std::bad_alloc
+    /// or any exceptions arising from the move or copy constructor of the
+    /// contained type. Assignment satisfies the strong guarantee
+    /// of exception safety.
+    template <class ValueType>
+    compact_any & operator=(ValueType&& rhs)
+    {
+        compact_any(std::forward<ValueType>(rhs)).swap(*this);
+        return *this;
+    }
+
+public: // queries
+
+    /// \returns `true` if instance is empty, otherwise `false`.
+    /// \throws Nothing.
+    bool empty() const noexcept
+    {
+        return !word();
+    }
+
+    /// \post this->empty() is true
+    void clear() noexcept
+    {
+        compact_any().swap(*this);
+    }
+
+    /// \returns the `typeid` of the
+    /// contained value if instance is non-empty, otherwise
+    /// `typeid(void)`.
+    ///
+    /// Useful for querying against types known either at compile time or
+    /// only at runtime.
+    const boost::typeindex::type_info& type() const noexcept
+    {
+        const std::uint16_t t = tag();
+        if (t & 1u) {
+            return *detail::compact_registry::table()[t >> 1];
+        }
+
+        return is_heap() ? pointer()->type() : boost::typeindex::type_id<void>().type_info();
+    }
+
+private: // types
+    /// @cond
+    class BOOST_SYMBOL_VISIBLE placeholder: public boost::anys::detail::placeholder
+    {
+    public:
+        virtual placeholder * clone() const = 0;
+    };
+
+    template<typename ValueType>
+    class holder final
+      : public placeholder
+    {
+    public:
+        template <class... Args>
+        holder(Args&&... args)
+          : held(std::forward<Args>(args)...)
+        {
+        }
+
+        const boost::typeindex::type_info& type() const noexcept override
+        {
+            return boost::typeindex::type_id<ValueType>().type_info();
+        }
+
+        placeholder * clone() const override
+        {
+            return new holder(held);
+        }
+
+#if defined(BOOST_ANY_USE_POLYMORPHIC_CAST) && !defined(BOOST_NO_EXCEPTIONS)
+        void throw_address() const override
+        {
+            throw const_cast<ValueType*>(std::addressof(held));
+        }
+#endif
+
+        ValueType held;
+    };
+
+private: // implementation
+    static std::uint16_t make_tag(std::uint16_t index) noexcept
+    {
+        return static_cast<std::uint16_t>((index << 1) | 1u);
+    }
+
+    std::uint64_t word() const noexcept
+    {
+        std::uint64_t w;
+        std::memcpy(&w, storage, sizeof(w));
+        return w;
+    }
+
+    std::uint16_t tag() const noexcept
+    {
+        std::uint16_t t;
+        std::memcpy(&t, storage + detail::compact_tag_offset, sizeof(t));
+        return t;
+    }
+
+    bool is_heap() const noexcept
+    {
+        return !(tag() & 1u) && word();
+    }
+
+    placeholder* pointer() const noexcept
+    {
+        BOOST_ASSERT(is_heap());
+        return reinterpret_cast<placeholder*>(static_cast<std::uintptr_t>(word()));
+    }
+
+    void set_pointer(placeholder* p) noexcept
+    {
+        BOOST_ASSERT(!(reinterpret_cast<std::uintptr_t>(p) & 1u));
+        const std::uint64_t w = reinterpret_cast<std::uintptr_t>(p);
+        std::memcpy(storage, &w, sizeof(w));
+    }
+
+    template <class ValueType>
+    void create(ValueType&& value)
+    {
+        using DecayedType = typename std::decay<ValueType>::type;
+        create_impl<DecayedType>(detail::is_compact_inline<DecayedType>(), std::forward<ValueType>(value));
+    }
+
+    template <class T, class ValueType>
+    void create_impl(std::true_type, ValueType&& value)
+    {
+        const std::uint16_t index = detail::compact_registry::acquire<T>();
+        if (!index) {
+            create_impl<T>(std::false_type(), std::forward<ValueType>(value));
+            return;
+        }
+
+        new (storage + detail::compact_payload_offset<T>::value) T(std::forward<ValueType>(value));
+        const std::uint16_t t = make_tag(index);
+        std::memcpy(storage + detail::compact_tag_offset, &t, sizeof(t));
+    }
+
+    template <class T, class ValueType>
+    void create_impl(std::false_type, ValueType&& value)
+    {
+        set_pointer(new holder<T>(std::forward<ValueType>(value)));
+    }
+
+    template <class T>
+    T* cast(std::true_type) noexcept
+    {
+        const std::uint16_t index = detail::compact_registry::find<T>();
+        if (!index) {
+            return cast<T>(std::false_type());
+        }
+
+        return tag() == make_tag(index)
+            ? reinterpret_cast<T*>(storage + detail::compact_payload_offset<T>::value)
+            : nullptr;
+    }
+
+    template <class T>
+    T* cast(std::false_type) noexcept
+    {
+        return is_heap() && pointer()->type() == boost::typeindex::type_id<T>()
+            ? std::addressof(static_cast<holder<T>*>(pointer())->held)
+            : nullptr;
+    }
+
+    template <class T>
+    T* unsafe_cast(std::true_type) noexcept
+    {
+        return tag() & 1u
+            ? reinterpret_cast<T*>(storage + detail::compact_payload_offset<T>::value)
+            : std::addressof(static_cast<holder<T>*>(pointer())->held);
+    }
+
+    template <class T>
+    T* unsafe_cast(std::false_type) noexcept
+    {
+        return std::addressof(static_cast<holder<T>*>(pointer())->held);
+    }
+
+private: // representation
+    template<typename ValueType>
+    friend ValueType * any_cast(compact_any *) noexcept;
+
+    template<typename ValueType>
+    friend ValueType * unsafe_any_cast(compact_any *) noexcept;
+
+    alignas(8) unsigned char storage[8];
+    /// @endcond
+};
+
+/// Exchange of the contents of `lhs` and `rhs`.
+/// \throws Nothing.
+inline void swap(compact_any & lhs, compact_any & rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+/// @cond
+
+// Note: The "unsafe" versions of any_cast are not part of the
+// public interface and may be removed at any time. They are
+// required where we know what type is stored in the any and can't
+// use typeid() comparison, e.g., when our types may travel across
+// different shared libraries.
+template<typename ValueType>
+inline ValueType * unsafe_any_cast(compact_any * operand) noexcept
+{
+    using T = typename std::remove_cv<ValueType>::type;
+    return operand->unsafe_cast<T>(detail::is_compact_inline<T>());
+}
+
+template<typename ValueType>
+inline const ValueType * unsafe_any_cast(const compact_any * operand) noexcept
+{
+    return anys::unsafe_any_cast<ValueType>(const_cast<compact_any *>(operand));
+}
+/// @endcond
+
+/// \returns Pointer to a ValueType stored in `operand`, nullptr if
+/// `operand` does not contain specified `ValueType`.
+template<typename ValueType>
+ValueType * any_cast(compact_any * operand) noexcept
+{
+    using T = typename std::remove_cv<ValueType>::type;
+    return operand ? operand->cast<T>(detail::is_compact_inline<T>()) : nullptr;
+}
+
+/// \returns Const pointer to a ValueType stored in `operand`, nullptr if
+/// `operand` does not contain specified `ValueType`.
+template<typename ValueType>
+inline const ValueType * any_cast(const compact_any * operand) noexcept
+{
+    return anys::any_cast<ValueType>(const_cast<compact_any *>(operand));
+}
+
+/// \returns ValueType stored in `operand`
+/// \throws boost::bad_any_cast if `operand` does not contain
+/// specified ValueType.
+template<typename ValueType>
+ValueType any_cast(compact_any & operand)
+{
+    using nonref = typename std::remove_reference<ValueType>::type;
+
+    nonref * result = anys::any_cast<nonref>(std::addressof(operand));
+    if(!result)
+        detail::throw_bad_any_cast();
+
+    // Attempt to avoid construction of a temporary object in cases when
+    // `ValueType` is not a reference. Example:
+    // `static_cast<std::string>(*result);`
+    // which is equal to `std::string(*result);`
+    typedef typename std::conditional<
+        std::is_reference<ValueType>::value,
+        ValueType,
+        typename std::add_lvalue_reference<ValueType>::type
+    >::type ref_type;
+
+#ifdef BOOST_MSVC
+#   pragma warning(push)
+#   pragma warning(disable: 4172) // "returning address of local variable or temporary" but *result is not local!
+#endif
+    return static_cast<ref_type>(*result);
+#ifdef BOOST_MSVC
+#   pragma warning(pop)
+#endif
+}
+
+/// \returns `ValueType` stored in `operand`
+/// \throws boost::bad_any_cast if `operand` does not contain
+/// specified `ValueType`.
+template<typename ValueType>
+inline ValueType any_cast(const compact_any & operand)
+{
+    using nonref = typename std::remove_reference<ValueType>::type;
+    return anys::any_cast<const nonref &>(const_cast<compact_any &>(operand));
+}
+
+/// \returns `ValueType` stored in `operand`, leaving the `operand` empty.
+/// \throws boost::bad_any_cast if `operand` does not contain
+/// specified `ValueType`.
+template<typename ValueType>
+inline ValueType any_cast(compact_any&& operand)
+{
+    static_assert(
+        std::is_rvalue_reference<ValueType&&>::value /*true if ValueType is rvalue or just a value*/
+        || std::is_const< typename std::remove_reference<ValueType>::type >::value,
+        "boost::any_cast shall not be used for getting nonconst references to temporary objects"
+    );
+    return anys::any_cast<ValueType>(operand);
+}
+
+BOOST_ANY_END_MODULE_EXPORT
+
+} // namespace anys
+
+BOOST_ANY_BEGIN_MODULE_EXPORT
+
+using boost::anys::any_cast;
+using boost::anys::unsafe_any_cast;
+
+BOOST_ANY_END_MODULE_EXPORT
+
+} // namespace boost
+
+#endif  // #if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+#endif // #ifndef BOOST_ANYS_COMPACT_ANY_HPP_INCLUDED
@@ -0,0 +1,405 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/any for Documentation.
+
+#ifndef BOOST_ANYS_CONCURRENT_ANY_MAP_HPP_INCLUDED
+#define BOOST_ANYS_CONCURRENT_ANY_MAP_HPP_INCLUDED
+
+#include <boost/any/detail/config.hpp>
+
+#if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+/// \file boost/any/concurrent_any_map.hpp
+/// \brief \copybrief boost::anys::concurrent_any_map
+
+#ifndef BOOST_ANY_INTERFACE_UNIT
+#include <boost/config.hpp>
+#ifdef BOOST_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#endif  // #ifndef BOOST_ANY_INTERFACE_UNIT
+
+#include <boost/any.hpp>
+#include <boost/any/atomic_any.hpp>
+#include <boost/any/detail/hazard_pointer.hpp>
+
+namespace boost {
+
+namespace anys {
+
+/// @cond
+namespace detail {
+
+    // Entry of the map. Key and value never change, an assignment makes a
+    // new node, so the tables share the nodes instead of copying the keys.
+    struct map_node: snapshot_node {
+        map_node(std::string&& k, std::size_t h, boost::any&& v) noexcept
+          : snapshot_node(std::move(v))
+          , key(std::move(k))
+          , hash(h)
+        {
+            destroy = &map_node::destroy_map_node;
+        }
+
+        static void destroy_map_node(hazard_retirable* node) noexcept
+        {
+            delete static_cast<map_node*>(node);
+        }
+
+        const std::string key;
+        const std::size_t hash;
+    };
+
+    // Immutable open addressing table of a shard. Owns a reference to each
+    // of its nodes.
+    struct map_table: hazard_retirable {
+        map_table() noexcept
+        {
+            destroy = &map_table::destroy_table;
+            next_retired = nullptr;
+        }
+
+        ~map_table()
+        {
+            for (map_node* node : nodes) {
+                snapshot_node::release(node);
+            }
+        }
+
+        static void destroy_table(hazard_retirable* table) noexcept
+        {
+            delete static_cast<map_table*>(table);
+        }
+
+        // Slot of `key`, or the first empty slot if there is no such key
+        std::size_t probe(const std::string& key, std::size_t hash) const noexcept
+        {
+            const std::size_t mask = index.size() - 1;
+            std::size_t i = hash & mask;
+            while (index[i]) {
+                const map_node* node = nodes[index[i] - 1];
+                if (node->hash == hash && node->key == key) {
+                    break;
+                }
+                i = (i + 1) & mask;
+            }
+            return i;
+        }
+
+        map_node* find(const std::string& key, std::size_t hash) const noexcept
+        {
+            if (index.empty()) {
+                return nullptr;
+            }
+            const std::size_t slot = probe(key, hash);
+            return index[slot] ? nodes[index[slot] - 1] : nullptr;
+        }
+
+        // Takes the nodes of `source`, except `skip`, and `added`
+        void build(const map_table* source, const map_node* skip, std::unique_ptr<map_node> added)
+        {
+            const std::size_t count = (source ? source->nodes.size() : 0) + (added ? 1 : 0);
+            std::size_t capacity = 8;
+            while (capacity < count * 2) {
+                capacity *= 2;
+            }
+            nodes.reserve(count);
+            index.assign(capacity, 0);
+
+            // Nothing throws below
+            if (source) {
+                for (map_node* node : source->nodes) {
+                    if (node != skip) {
+                        snapshot_node::add_ref(node);
+                        nodes.push_back(node);
+                    }
+                }
+            }
+            if (added) {
+                nodes.push_back(added.release());
+            }
+            for (std::size_t i = 0; i < nodes.size(); ++i) {
+                index[probe(nodes[i]->key, nodes[i]->hash)] = i + 1;
+            }
+        }
+
+        std::vector<map_node*> nodes;
+        std::vector<std::size_t> index;
+    };
+
+    struct map_table_deleter {
+        void operator()(map_table* table) const noexcept
+        {
+            delete table;
+        }
+    };
+
+} // namespace detail
+/// @endcond
+
+BOOST_ANY_BEGIN_MODULE_EXPORT
+
+/// \brief Concurrent map from `std::string` to boost::any for the read
+/// mostly data, like process wide properties.
+///
+/// Lookups take no locks. find() and get() increment the reference count
+/// of the found value, so the readers of the same key write the same cache
+/// line. visit() and contains() write no shared memory except the hazard
+/// pointer of the calling thread, so their readers do not contend with each
+/// other:
+/// \code
+/// boost::anys::concurrent_any_map properties;
+/// properties.insert_or_assign("timeout", std::chrono::seconds(5));
+///
+/// // Any thread
+/// if (auto timeout = properties.get<std::chrono::seconds>("timeout")) {
+///     use(*timeout);
+/// }
+///
+/// // Hot path, no reference counting
+/// properties.visit("timeout", [](const boost::any& timeout) {
+///     use(boost::any_cast<std::chrono::seconds>(timeout));
+/// });
+/// \endcode
+///
+/// Keys are spread over shards. Each shard publishes an immutable table
+/// that readers access via hazard pointers; a writer locks the shard,
+/// makes a new table that shares the unchanged entries and replaces the
+/// old table, so a write costs O(size of the shard). Found values are
+/// returned as boost::anys::any_snapshot, without copying the payload.
+/// A replaced table that was being read at the moment of its replacement
+/// is freed by a later write or by boost::anys::reclaim_retired().
+class concurrent_any_map {
+public:
+    /// Makes a map with at least `shards` shards, rounded up to a power of
+    /// two.
+    /// \throws std::bad_alloc
+    explicit concurrent_any_map(std::size_t shards = 64)
+      : mask(shard_count(shards) - 1)
+      , parts(new shard[mask + 1])
+    {}
+
+    concurrent_any_map(const concurrent_any_map&) = delete;
+    concurrent_any_map& operator=(const concurrent_any_map&) = delete;
+
+    ~concurrent_any_map()
+    {
+        for (std::size_t i = 0; i <= mask; ++i) {
+            delete parts[i].table.load(std::memory_order_acquire);
+        }
+    }
+
+    /// \returns Snapshot of the value of `key`, an empty snapshot if there
+    /// is no such key.
+    /// \throws std::bad_alloc on the first call from a thread if the memory
+    /// for its hazard pointer could not be allocated.
+    any_snapshot find(const std::string& key) const
+    {
+        const std::size_t hash = std::hash<std::string>()(key);
+        const shard& s = shard_of(hash);
+
+        detail::hazard_record& record = detail::hazard_domain::this_thread_record();
+        const detail::map_table* table = detail::hazard_domain::protect(s.table, record);
+        detail::map_node* node = table ? table->find(key, table_hash(hash)) : nullptr;
+
+        // The protected table owns a reference, so the node is alive
+        detail::snapshot_node::add_ref(node);
+        detail::hazard_domain::clear(record);
+        return detail::snapshot_access::adopt(node);
+    }
+
+    /// \returns Snapshot of the value of `key` if it is a `ValueType`,
+    /// an empty typed_snapshot otherwise.
+    /// \throws std::bad_alloc on the first call from a thread if the memory
+    /// for its hazard pointer could not be allocated.
+    template <class ValueType>
+    typed_snapshot<ValueType> get(const std::string& key) const
+    {
+        return typed_snapshot<ValueType>(find(key));
+    }
+
+    /// Calls `f(const boost::any&)` with the value of `key` while the value
+    /// is protected by the hazard pointer of the calling thread. Unlike
+    /// find(), does not touch the reference count of the value.
+    ///
+    /// `f` shall not use boost::anys::concurrent_any_map or
+    /// boost::anys::atomic_any: the calling thread has a single hazard
+    /// pointer. The reference passed to `f` is valid only during the call.
+    /// \returns `true` if there is a value for `key` and `f` was called.
+    /// \throws std::bad_alloc on the first call from a thread if the memory
+    /// for its hazard pointer could not be allocated, or any exceptions
+    /// arising from `f`.
+    template <class F>
+    bool visit(const std::string& key, F&& f) const
+    {
+        const std::size_t hash = std::hash<std::string>()(key);
+        const shard& s = shard_of(hash);
+
+        detail::hazard_guard guard{detail::hazard_domain::this_thread_record()};
+        const detail::map_table* table = detail::hazard_domain::protect(s.table, guard.record);
+        const detail::map_node* node = table ? table->find(key, table_hash(hash)) : nullptr;
+        if (!node) {
+            return false;
+        }
+
+        // The protected table owns a reference, so the node is alive
+        std::forward<F>(f)(static_cast<const boost::any&>(node->value));
+        return true;
+    }
+
+    /// \returns `true` if there is a value for `key`.
+    bool contains(const std::string& key) const
+    {
+        return visit(key, [](const boost::any&) {});
+    }
+
+    /// Sets the value of `key` to `value`.
+    /// \returns `true` if the key was inserted, `false` if it was assigned.
+    /// \throws std::bad_alloc. The map is not modified if an exception is
+    /// thrown.
+    bool insert_or_assign(std::string key, boost::any value)
+    {
+        return write(std::move(key), std::move(value), true);
+    }
+
+    /// Inserts `value` for `key` if there is no value for `key`.
+    /// \returns `true` if the key was inserted.
+    /// \throws std::bad_alloc. The map is not modified if an exception is
+    /// thrown.
+    bool insert(std::string key, boost::any value)
+    {
+        return write(std::move(key), std::move(value), false);
+    }
+
+    /// Removes the value of `key`. Snapshots keep the value alive.
+    /// \returns `true` if the key was removed.
+    /// \throws std::bad_alloc. The map is not modified if an exception is
+    /// thrown.
+    bool erase(const std::string& key)
+    {
+        const std::size_t hash = std::hash<std::string>()(key);
+        shard& s = shard_of(hash);
+        std::lock_guard<std::mutex> lock(s.mutex);
+
+        const detail::map_table* old = s.table.load(std::memory_order_relaxed);
+        const detail::map_node* node = old ? old->find(key, table_hash(hash)) : nullptr;
+        if (!node) {
+            return false;
+        }
+
+        std::unique_ptr<detail::map_table, detail::map_table_deleter> table(new detail::map_table);
+        table->build(old, node, nullptr);
+        publish(s, table.release());
+        return true;
+    }
+
+    /// \returns Count of keys. Not a snapshot if the map is modified
+    /// concurrently.
+    std::size_t size() const
+    {
+        detail::hazard_record& record = detail::hazard_domain::this_thread_record();
+        std::size_t result = 0;
+        for (std::size_t i = 0; i <= mask; ++i) {
+            const detail::map_table* table = detail::hazard_domain::protect(parts[i].table, record);
+            result += table ? table->nodes.size() : 0;
+        }
+        detail::hazard_domain::clear(record);
+        return result;
+    }
+
+    /// Removes all the values. Snapshots keep the values alive.
+    /// \throws Nothing.
+    void clear() noexcept
+    {
+        for (std::size_t i = 0; i <= mask; ++i) {
+            std::lock_guard<std::mutex> lock(parts[i].mutex);
+            publish(parts[i], nullptr);
+        }
+    }
+
+private:
+    /// @cond
+    struct shard {
+        shard() noexcept
+          : table(nullptr)
+        {}
+
+        std::atomic<detail::map_table*> table;
+        std::mutex mutex;
+    };
+
+    static std::size_t shard_count(std::size_t shards) noexcept
+    {
+        std::size_t result = 1;
+        while (result < shards) {
+            result *= 2;
+        }
+        return result;
+    }
+
+    // Low bits select the shard, so the tables use the rest
+    std::size_t table_hash(std::size_t hash) const noexcept
+    {
+        return hash / (mask + 1);
+    }
+
+    shard& shard_of(std::size_t hash) const noexcept
+    {
+        return parts[hash & mask];
+    }
+
+    bool write(std::string&& key, boost::any&& value, bool assign)
+    {
+        const std::size_t hash = std::hash<std::string>()(key);
+        shard& s = shard_of(hash);
+        std::lock_guard<std::mutex> lock(s.mutex);
+
+        const detail::map_table* old = s.table.load(std::memory_order_relaxed);
+        const detail::map_node* existing = old ? old->find(key, table_hash(hash)) : nullptr;
+        if (existing && !assign) {
+            return false;
+        }
+
+        std::unique_ptr<detail::map_table, detail::map_table_deleter> table(new detail::map_table);
+        std::unique_ptr<detail::map_node> node(new detail::map_node(std::move(key), table_hash(hash), std::move(value)));
+        table->build(old, existing, std::move(node));
+        publish(s, table.release());
+        return !existing;
+    }
+
+    // Readers may still use the old table, so it is retired
+    static void publish(shard& s, detail::map_table* table) noexcept
+    {
+        detail::map_table* const old = s.table.exchange(table, std::memory_order_acq_rel);
+        if (old) {
+            detail::hazard_domain::instance().retire(old);
+        }
+    }
+
+    const std::size_t mask;
+    std::unique_ptr<shard[]> parts;
+    /// @endcond
+};
+
+BOOST_ANY_END_MODULE_EXPORT
+
+} // namespace anys
+
+} // namespace boost
+
+#endif  // #if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+#endif // #ifndef BOOST_ANYS_CONCURRENT_ANY_MAP_HPP_INCLUDED
@@ -0,0 +1,320 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/any for Documentation.
+
+#ifndef BOOST_ANYS_DEFERRED_DESTROY_HPP_INCLUDED
+#define BOOST_ANYS_DEFERRED_DESTROY_HPP_INCLUDED
+
+#include <boost/any/detail/config.hpp>
+
+#if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+/// \file boost/any/deferred_destroy.hpp
+/// \brief \copybrief boost::anys::deferred_destroy
+
+#ifndef BOOST_ANY_INTERFACE_UNIT
+#include <boost/config.hpp>
+#ifdef BOOST_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#endif  // #ifndef BOOST_ANY_INTERFACE_UNIT
+
+#include <boost/any.hpp>
+#include <boost/any/basic_any.hpp>
+#include <boost/any/basic_any_hinted.hpp>
+#include <boost/any/unique_any.hpp>
+#include <boost/any/detail/allocation.hpp>
+
+namespace boost {
+
+namespace anys {
+
+/// @cond
+namespace detail {
+
+    struct deferred_node {
+        deferred_node* next;
+        void (*destroy)(deferred_node*) noexcept;
+    };
+
+    // Nodes are allocated by the submitting thread and freed by the
+    // reclamation thread. Pooled only if boost::anys::use_pooled_allocation
+    // is specialized for the node.
+    template <class Any>
+    struct deferred_any_node: deferred_node {
+        explicit deferred_any_node(Any&& v) noexcept
+          : value(std::move(v))
+        {
+            next = nullptr;
+            destroy = &deferred_any_node::destroy_node;
+        }
+
+        static void destroy_node(deferred_node* node) noexcept
+        {
+            detail::delete_value(static_cast<deferred_any_node*>(node));
+        }
+
+        Any value;
+    };
+
+    // Single background thread that destroys the submitted values in
+    // batches. The thread is started on the first submission and is joined
+    // at the program exit.
+    class deferred_reclaimer {
+    public:
+        static deferred_reclaimer& instance() noexcept
+        {
+            static deferred_reclaimer reclaimer;
+            return reclaimer;
+        }
+
+        // Returns false if the value could not be queued, the caller shall
+        // destroy it then
+        template <class Any>
+        bool submit(Any& value) noexcept
+        {
+            using node_type = deferred_any_node<Any>;
+
+            deferred_node* node = nullptr;
+#ifndef BOOST_NO_EXCEPTIONS
+            try {
+#endif
+                start();
+                node = detail::new_value<node_type>(std::move(value));
+#ifndef BOOST_NO_EXCEPTIONS
+            } catch (...) {
+                return false;
+            }
+#endif
+
+            submitted.fetch_add(1, std::memory_order_relaxed);
+            // The node may be destroyed as soon as it is published, so the
+            // previous head is kept in a local
+            deferred_node* head = pending.load(std::memory_order_relaxed);
+            do {
+                node->next = head;
+            } while (!pending.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+
+            // The thread may sleep only if the list was empty
+            if (!head) {
+                { std::lock_guard<std::mutex> lock(mutex); }
+                wake.notify_one();
+            }
+            return true;
+        }
+
+        void flush() noexcept
+        {
+            const std::size_t target = submitted.load(std::memory_order_acquire);
+            destroy_batch(pending.exchange(nullptr, std::memory_order_acquire));
+
+            // Values taken by the background thread earlier
+            std::unique_lock<std::mutex> lock(mutex);
+            done.wait(lock, [this, target]() { return destroyed >= target; });
+        }
+
+        ~deferred_reclaimer()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            wake.notify_one();
+            if (worker.joinable()) {
+                worker.join();
+            }
+            destroy_batch(pending.exchange(nullptr, std::memory_order_acquire));
+        }
+
+    private:
+        deferred_reclaimer() noexcept
+          : pending(nullptr)
+          , submitted(0)
+          , started(false)
+          , destroyed(0)
+          , stopping(false)
+        {}
+
+        void start()
+        {
+            if (started.load(std::memory_order_acquire)) {
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!started.load(std::memory_order_relaxed)) {
+                worker = std::thread([this]() { run(); });
+                started.store(true, std::memory_order_release);
+            }
+        }
+
+        void run() noexcept
+        {
+            for (;;) {
+                if (deferred_node* batch = pending.exchange(nullptr, std::memory_order_acquire)) {
+                    destroy_batch(batch);
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [this]() {
+                    return stopping || pending.load(std::memory_order_acquire);
+                });
+                if (stopping) {
+                    return;
+                }
+            }
+        }
+
+        void destroy_batch(deferred_node* batch) noexcept
+        {
+            if (!batch) {
+                return;
+            }
+
+            std::size_t count = 0;
+            while (batch) {
+                deferred_node* const next = batch->next;
+                batch->destroy(batch);
+                batch = next;
+                ++count;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                destroyed += count;
+            }
+            done.notify_all();
+        }
+
+        std::atomic<deferred_node*> pending;
+        std::atomic<std::size_t> submitted;
+        std::atomic<bool> started;
+        std::thread worker;
+
+        // Guarded by the mutex
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable done;
+        std::size_t destroyed;
+        bool stopping;
+    };
+
+    template <class Any>
+    void deferred_destroy_impl(Any& value) noexcept
+    {
+        if (!detail::deferred_reclaimer::instance().submit(value)) {
+            Any().swap(value);
+        }
+    }
+
+    // Values in the buffer of basic_any are cheaper to destroy than to queue
+    template <std::size_t Size, std::size_t Alignment>
+    bool is_in_buffer(basic_any<Size, Alignment>& value) noexcept
+    {
+        const unsigned char* const self = reinterpret_cast<const unsigned char*>(std::addressof(value));
+        const unsigned char* const address = static_cast<const unsigned char*>(basic_any_access::address(value));
+        return address >= self && address < self + sizeof(value);
+    }
+
+    template <std::size_t Size, std::size_t Alignment, class... Hints>
+    bool is_in_buffer(basic_any_hinted<Size, Alignment, Hints...>& value) noexcept
+    {
+        return detail::is_in_buffer(hinted_access::base(value));
+    }
+
+    template <class Any>
+    void deferred_destroy_buffered(Any& value) noexcept
+    {
+        if (value.empty()) {
+            return;
+        }
+        if (detail::is_in_buffer(value)) {
+            value.clear();
+        } else {
+            detail::deferred_destroy_impl(value);
+        }
+    }
+
+} // namespace detail
+/// @endcond
+
+BOOST_ANY_BEGIN_MODULE_EXPORT
+
+/// Moves the value of `value` to a background thread that destroys it,
+/// so the caller does not pay for the destructor of a large payload:
+/// \code
+/// boost::any response = build_response();
+/// send(response);
+/// boost::anys::deferred_destroy(std::move(response));  // returns at once
+/// \endcode
+///
+/// The background thread is started on the first call and destroys the
+/// queued values in batches. If the value could not be queued, for example
+/// because a thread could not be started, it is destroyed by the caller.
+/// Values that boost::anys::basic_any keeps in its buffer are destroyed by
+/// the caller right away, only the heap allocated values are queued.
+/// \post `value.empty()`
+/// \throws Nothing.
+inline void deferred_destroy(boost::any&& value) noexcept
+{
+    if (!value.empty()) {
+        detail::deferred_destroy_impl(value);
+    }
+}
+
+/// \copydoc boost::anys::deferred_destroy(boost::any&&)
+template <std::size_t OptimizeForSize, std::size_t OptimizeForAlignment>
+void deferred_destroy(basic_any<OptimizeForSize, OptimizeForAlignment>&& value) noexcept
+{
+    detail::deferred_destroy_buffered(value);
+}
+
+/// \copydoc boost::anys::deferred_destroy(boost::any&&)
+template <std::size_t OptimizeForSize, std::size_t OptimizeForAlignment, class... Hints>
+void deferred_destroy(basic_any_hinted<OptimizeForSize, OptimizeForAlignment, Hints...>&& value) noexcept
+{
+    detail::deferred_destroy_buffered(value);
+}
+
+/// Moves the value of `value` to a background thread that destroys it.
+/// \post `!value.has_value()`
+/// \throws Nothing.
+inline void deferred_destroy(unique_any&& value) noexcept
+{
+    if (value.has_value()) {
+        detail::deferred_destroy_impl(value);
+    }
+}
+
+/// Destroys all the values passed to boost::anys::deferred_destroy()
+/// before the call, waiting for the background thread if needed. Useful
+/// at shutdown and in tests.
+/// \throws Nothing.
+inline void deferred_flush() noexcept
+{
+    detail::deferred_reclaimer::instance().flush();
+}
+
+BOOST_ANY_END_MODULE_EXPORT
+
+} // namespace anys
+
+} // namespace boost
+
+#endif  // #if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+#endif // #ifndef BOOST_ANYS_DEFERRED_DESTROY_HPP_INCLUDED
@@ -0,0 +1,192 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_ANY_ANYS_DETAIL_ALLOCATION_HPP
+#define BOOST_ANY_ANYS_DETAIL_ALLOCATION_HPP
+
+#include <boost/any/detail/config.hpp>
+
+#if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+#ifndef BOOST_ANY_INTERFACE_UNIT
+#include <boost/config.hpp>
+#ifdef BOOST_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#endif
+
+// Allocation hooks of the anys. The pools themselves are in
+// boost/any/pooled_allocation.hpp, so the users that do not enable them do
+// not include the atomics and the thread local caches.
+
+namespace boost {
+
+namespace anys {
+
+BOOST_ANY_BEGIN_MODULE_EXPORT
+
+/// \brief Customization point that enables the thread local pools for the
+/// heap allocated values of `ValueType`.
+///
+/// By default the holders of boost::any and boost::anys::unique_any and the
+/// values that do not fit into the buffer of boost::anys::basic_any are
+/// allocated via the global `operator new`. If this trait is `true` they
+/// are allocated from the per thread free lists of fixed size classes, so
+/// an allocation or a deallocation on the same thread is a few
+/// instructions. A block freed by another thread is pushed to a lock free
+/// list of the owning thread and is reused by it on the next allocation,
+/// which makes the producer/consumer hand-over cheap as well.
+///
+/// Pools are enabled for all the types if `BOOST_ANY_USE_POOLED_ALLOCATION`
+/// is defined, or for a single type by a specialization:
+/// \code
+/// template <>
+/// struct boost::anys::use_pooled_allocation<message> : std::true_type {};
+/// \endcode
+///
+/// The specializations need boost/any/pooled_allocation.hpp, that defines
+/// the pools. The macro and the specializations shall be the same in all
+/// the translation units. Blocks larger than 256 bytes and over-aligned
+/// blocks are always allocated via the global `operator new`.
+template <class ValueType>
+struct use_pooled_allocation
+#ifdef BOOST_ANY_USE_POOLED_ALLOCATION
+    : std::true_type
+#else
+    : std::false_type
+#endif
+{};
+
+BOOST_ANY_END_MODULE_EXPORT
+
+/// @cond
+namespace detail {
+
+    constexpr std::size_t pool_alignment = alignof(std::max_align_t);
+
+    // Defined in boost/any/pooled_allocation.hpp, that shall be included
+    // where the pools are enabled for a type
+    template <class ValueType>
+    struct pool_allocator;
+
+    // `Block` is the type that is allocated for `ValueType`: the value
+    // itself or a holder of the value.
+    template <class ValueType, class Block = ValueType>
+    struct is_pooled: std::integral_constant<bool,
+        use_pooled_allocation<ValueType>::value && alignof(Block) <= pool_alignment
+    > {};
+
+    template <class ValueType>
+    void* allocate_block_impl(std::size_t size, std::false_type)
+    {
+        return ::operator new(size);
+    }
+
+    template <class ValueType>
+    void* allocate_block_impl(std::size_t size, std::true_type)
+    {
+        return pool_allocator<ValueType>::allocate(size);
+    }
+
+    template <class ValueType, class Block = ValueType>
+    void* allocate_block(std::size_t size)
+    {
+        return detail::allocate_block_impl<ValueType>(size, is_pooled<ValueType, Block>());
+    }
+
+    template <class ValueType>
+    void deallocate_block_impl(void* p, std::false_type) noexcept
+    {
+        ::operator delete(p);
+    }
+
+    template <class ValueType>
+    void deallocate_block_impl(void* p, std::true_type) noexcept
+    {
+        pool_allocator<ValueType>::deallocate(p);
+    }
+
+    template <class ValueType, class Block = ValueType>
+    void deallocate_block(void* p) noexcept
+    {
+        detail::deallocate_block_impl<ValueType>(p, is_pooled<ValueType, Block>());
+    }
+
+    // Frees the block if the constructor throws
+    template <class ValueType>
+    struct block_owner {
+        void* block;
+
+        ~block_owner()
+        {
+            if (block) {
+                pool_allocator<ValueType>::deallocate(block);
+            }
+        }
+    };
+
+    template <class ValueType, class... Args>
+    ValueType* new_value_impl(std::false_type, Args&&... args)
+    {
+        return new ValueType(std::forward<Args>(args)...);
+    }
+
+    template <class ValueType, class... Args>
+    ValueType* new_value_impl(std::true_type, Args&&... args)
+    {
+        block_owner<ValueType> guard{pool_allocator<ValueType>::allocate(sizeof(ValueType))};
+        ValueType* const result = ::new (guard.block) ValueType(std::forward<Args>(args)...);
+        guard.block = nullptr;
+        return result;
+    }
+
+    // Replacement for `new ValueType(args...)` that respects
+    // use_pooled_allocation
+    template <class ValueType, class... Args>
+    ValueType* new_value(Args&&... args)
+    {
+        return detail::new_value_impl<ValueType>(is_pooled<ValueType>(), std::forward<Args>(args)...);
+    }
+
+    template <class ValueType>
+    void delete_value_impl(ValueType* value, std::false_type) noexcept
+    {
+        delete value;
+    }
+
+    template <class ValueType>
+    void delete_value_impl(ValueType* value, std::true_type) noexcept
+    {
+        value->~ValueType();
+        pool_allocator<ValueType>::deallocate(value);
+    }
+
+    // Replacement for `delete value`
+    template <class ValueType>
+    void delete_value(ValueType* value) noexcept
+    {
+        detail::delete_value_impl(value, is_pooled<ValueType>());
+    }
+
+} // namespace detail
+/// @endcond
+
+} // namespace anys
+
+} // namespace boost
+
+#ifdef BOOST_ANY_USE_POOLED_ALLOCATION
+#include <boost/any/pooled_allocation.hpp>
+#endif
+
+#endif  // #if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+#endif  // #ifndef BOOST_ANY_ANYS_DETAIL_ALLOCATION_HPP
@@ -0,0 +1,382 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_ANY_ANYS_DETAIL_ERASED_ARRAY_HPP
+#define BOOST_ANY_ANYS_DETAIL_ERASED_ARRAY_HPP
+
+#include <boost/any/detail/config.hpp>
+
+#if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+#ifndef BOOST_ANY_INTERFACE_UNIT
+#include <boost/config.hpp>
+#ifdef BOOST_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <utility>
+
+#include <boost/assert.hpp>
+#endif
+
+#include <boost/any/detail/value_ops.hpp>
+
+/// @cond
+namespace boost {
+namespace anys {
+namespace detail {
+
+// ::operator new takes care only of the fundamental alignment
+constexpr std::size_t extra_alignment_space(std::size_t alignment) noexcept
+{
+    return alignment > alignof(std::max_align_t) ? alignment : 0;
+}
+
+inline void* align_address(void* raw, std::size_t alignment) noexcept
+{
+    const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(raw);
+    return reinterpret_cast<void*>((address + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1));
+}
+
+// Contiguous array of values of a single type that is known only at
+// runtime. Works as std::vector<T> for the T described by `ops`.
+class erased_array {
+public:
+    // The array without a type, shall be assigned before use
+    erased_array() noexcept
+      : ops_(nullptr)
+      , raw_(nullptr)
+      , data_(nullptr)
+      , size_(0)
+      , capacity_(0)
+    {}
+
+    explicit erased_array(const value_ops& value_ops) noexcept
+      : ops_(&value_ops)
+      , raw_(nullptr)
+      , data_(nullptr)
+      , size_(0)
+      , capacity_(0)
+    {}
+
+    erased_array(const erased_array& other)
+      : erased_array()
+    {
+        ops_ = other.ops_;
+        if (!other.size_) {
+            return;
+        }
+
+        BOOST_ASSERT(ops_->copy);
+        storage_guard guard(*ops_, other.size_);
+        for (; guard.constructed != other.size_; ++guard.constructed) {
+            ops_->copy(guard.at(guard.constructed), other.at(guard.constructed));
+        }
+        take(guard);
+    }
+
+    erased_array(erased_array&& other) noexcept
+      : ops_(other.ops_)
+      , raw_(other.raw_)
+      , data_(other.data_)
+      , size_(other.size_)
+      , capacity_(other.capacity_)
+    {
+        other.raw_ = nullptr;
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.capacity_ = 0;
+    }
+
+    erased_array& operator=(const erased_array& rhs)
+    {
+        erased_array(rhs).swap(*this);
+        return *this;
+    }
+
+    erased_array& operator=(erased_array&& rhs) noexcept
+    {
+        erased_array(std::move(rhs)).swap(*this);
+        return *this;
+    }
+
+    ~erased_array() noexcept
+    {
+        clear();
+        ::operator delete(raw_);
+    }
+
+    const value_ops& ops() const noexcept { BOOST_ASSERT(ops_); return *ops_; }
+    bool has_type() const noexcept { return ops_ != nullptr; }
+    void* data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+    std::size_t capacity() const noexcept { return capacity_; }
+
+    void* at(std::size_t index) const noexcept
+    {
+        BOOST_ASSERT(index < size_);
+        return static_cast<unsigned char*>(data_) + index * ops_->size;
+    }
+
+    // Constructs a new value at the end by calling `construct(void* place)`.
+    // Nothing changes if `construct` throws.
+    template <class Constructor>
+    void* construct_back(Constructor&& construct)
+    {
+        if (size_ == capacity_) {
+            grow(size_ + 1);
+        }
+        void* const place = static_cast<unsigned char*>(data_) + size_ * ops_->size;
+        construct(place);
+        ++size_;
+        return place;
+    }
+
+    void* copy_back(const void* value)
+    {
+        BOOST_ASSERT(ops_->copy);
+        const value_ops& o = *ops_;
+        return construct_back([&o, value](void* place) { o.copy(place, value); });
+    }
+
+    void* move_back(void* value)
+    {
+        const value_ops& o = *ops_;
+        return construct_back([&o, value](void* place) { o.move(place, value); });
+    }
+
+    void reserve(std::size_t count)
+    {
+        if (capacity_ < count) {
+            reallocate(count);
+        }
+    }
+
+    void pop_back() noexcept
+    {
+        BOOST_ASSERT(size_);
+        ops_->destroy(at(size_ - 1));
+        --size_;
+    }
+
+    void clear() noexcept
+    {
+        while (size_) {
+            pop_back();
+        }
+    }
+
+    void swap(erased_array& other) noexcept
+    {
+        std::swap(ops_, other.ops_);
+        std::swap(raw_, other.raw_);
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+    }
+
+private:
+    // Owns a new buffer and the values in [0, constructed) of it
+    struct storage_guard {
+        storage_guard(const value_ops& value_ops, std::size_t count)
+          : ops(value_ops)
+          , raw(::operator new(count * value_ops.size + detail::extra_alignment_space(value_ops.alignment)))
+          , data(detail::align_address(raw, value_ops.alignment))
+          , capacity(count)
+          , constructed(0)
+        {}
+
+        ~storage_guard()
+        {
+            while (constructed) {
+                --constructed;
+                ops.destroy(at(constructed));
+            }
+            ::operator delete(raw);
+        }
+
+        void* at(std::size_t index) const noexcept
+        {
+            return static_cast<unsigned char*>(data) + index * ops.size;
+        }
+
+        const value_ops& ops;
+        void* raw;
+        void* data;
+        std::size_t capacity;
+        std::size_t constructed;
+    };
+
+    void take(storage_guard& guard) noexcept
+    {
+        clear();
+        ::operator delete(raw_);
+        raw_ = guard.raw;
+        data_ = guard.data;
+        size_ = guard.constructed;
+        capacity_ = guard.capacity;
+        guard.raw = nullptr;
+        guard.constructed = 0;
+    }
+
+    BOOST_NOINLINE void grow(std::size_t count)
+    {
+        std::size_t new_capacity = capacity_ ? capacity_ * 2 : 4;
+        while (new_capacity < count) {
+            new_capacity *= 2;
+        }
+        reallocate(new_capacity);
+    }
+
+    void reallocate(std::size_t new_capacity)
+    {
+        storage_guard guard(*ops_, new_capacity);
+        if (ops_->trivially_relocatable) {
+            if (size_) {
+                std::memcpy(guard.data, data_, size_ * ops_->size);
+            }
+            guard.constructed = size_;
+            size_ = 0;  // Nothing to destroy in old storage
+        } else if (ops_->nothrow_move || !ops_->copy) {
+            for (; guard.constructed != size_; ++guard.constructed) {
+                ops_->move(guard.at(guard.constructed), at(guard.constructed));
+            }
+        } else {
+            // A throwing move would leave the values moved-from, copies keep
+            // them intact. Same as std::move_if_noexcept.
+            for (; guard.constructed != size_; ++guard.constructed) {
+                ops_->copy(guard.at(guard.constructed), at(guard.constructed));
+            }
+        }
+        take(guard);
+    }
+
+    const value_ops* ops_;
+    void* raw_;
+    void* data_;
+    std::size_t size_;
+    std::size_t capacity_;
+};
+
+// Single value of a type that is known only at runtime, always allocated
+// on the heap. Has no value if `ops()` is nullptr.
+class erased_value {
+public:
+    erased_value() noexcept
+      : ops_(nullptr)
+      , raw_(nullptr)
+      , data_(nullptr)
+    {}
+
+    // Move constructs the value from `source`
+    erased_value(const value_ops& value_ops, void* source)
+      : erased_value()
+    {
+        // The constructor delegated, so on exception the destructor frees
+        // the memory. `ops_` is set only after the value is constructed.
+        allocate(value_ops);
+        value_ops.move(data_, source);
+        ops_ = &value_ops;
+    }
+
+    // Memory for a value of `value_ops`, without a value. The value is made
+    // by construct_move() or construct_copy(), that do not allocate.
+    static erased_value reserve(const value_ops& value_ops)
+    {
+        erased_value result;
+        result.allocate(value_ops);
+        return result;
+    }
+
+    void construct_move(const value_ops& value_ops, void* source)
+    {
+        BOOST_ASSERT(raw_ && !ops_);
+        value_ops.move(data_, source);
+        ops_ = &value_ops;
+    }
+
+    void construct_copy(const value_ops& value_ops, const void* source)
+    {
+        BOOST_ASSERT(raw_ && !ops_ && value_ops.copy);
+        value_ops.copy(data_, source);
+        ops_ = &value_ops;
+    }
+
+    erased_value(const erased_value& other)
+      : erased_value()
+    {
+        if (other.ops_) {
+            BOOST_ASSERT(other.ops_->copy);
+            allocate(*other.ops_);
+            other.ops_->copy(data_, other.data_);
+            ops_ = other.ops_;
+        }
+    }
+
+    erased_value(erased_value&& other) noexcept
+      : ops_(other.ops_)
+      , raw_(other.raw_)
+      , data_(other.data_)
+    {
+        other.ops_ = nullptr;
+        other.raw_ = nullptr;
+        other.data_ = nullptr;
+    }
+
+    erased_value& operator=(const erased_value& rhs)
+    {
+        erased_value(rhs).swap(*this);
+        return *this;
+    }
+
+    erased_value& operator=(erased_value&& rhs) noexcept
+    {
+        erased_value(std::move(rhs)).swap(*this);
+        return *this;
+    }
+
+    ~erased_value() noexcept
+    {
+        if (ops_) {
+            ops_->destroy(data_);
+        }
+        ::operator delete(raw_);
+    }
+
+    const value_ops* ops() const noexcept { return ops_; }
+    void* data() const noexcept { return data_; }
+
+    void swap(erased_value& other) noexcept
+    {
+        std::swap(ops_, other.ops_);
+        std::swap(raw_, other.raw_);
+        std::swap(data_, other.data_);
+    }
+
+private:
+    void allocate(const value_ops& value_ops)
+    {
+        raw_ = ::operator new(value_ops.size + detail::extra_alignment_space(value_ops.alignment));
+        data_ = detail::align_address(raw_, value_ops.alignment);
+    }
+
+    const value_ops* ops_;
+    void* raw_;
+    void* data_;
+};
+
+} // namespace detail
+} // namespace anys
+} // namespace boost
+/// @endcond
+
+#endif  // #if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+#endif  // #ifndef BOOST_ANY_ANYS_DETAIL_ERASED_ARRAY_HPP
@@ -0,0 +1,186 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_ANY_ANYS_DETAIL_HAZARD_POINTER_HPP
+#define BOOST_ANY_ANYS_DETAIL_HAZARD_POINTER_HPP
+
+#include <boost/any/detail/config.hpp>
+
+#if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+#ifndef BOOST_ANY_INTERFACE_UNIT
+#include <boost/config.hpp>
+#ifdef BOOST_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include <atomic>
+#include <cstddef>
+#endif
+
+/// @cond
+namespace boost {
+namespace anys {
+namespace detail {
+
+// Object that may be freed only after no thread protects it with a hazard
+// pointer.
+struct hazard_retirable {
+    void (*destroy)(hazard_retirable*) noexcept;
+    hazard_retirable* next_retired;
+};
+
+// Protection slot of a thread. Records are never freed, a record of an
+// exited thread is reused by a new thread.
+struct hazard_record {
+    std::atomic<const void*> pointer;
+    std::atomic<bool> active;
+    hazard_record* next;
+};
+
+// Hazard pointers with a single slot per thread and a lock free list of
+// the retired objects. Retiring scans the slots, so the cost of the
+// reclamation is paid by the thread that retires. Objects protected during
+// the scan wait for the next retire() or scan().
+class hazard_domain {
+public:
+    static hazard_domain& instance() noexcept
+    {
+        static hazard_domain domain;
+        return domain;
+    }
+
+    // Slot of the calling thread.
+    // Throws std::bad_alloc on the first call from a thread if there is no
+    // free record.
+    static hazard_record& this_thread_record()
+    {
+        static thread_local record_owner owner{hazard_domain::instance().acquire_record()};
+        return *owner.record;
+    }
+
+    // Loads the pointer from `source` and protects it from being freed,
+    // until the slot is cleared or reused.
+    template <class T>
+    static T* protect(const std::atomic<T*>& source, hazard_record& record) noexcept
+    {
+        T* p = source.load(std::memory_order_acquire);
+        for (;;) {
+            record.pointer.store(p, std::memory_order_seq_cst);
+            T* const validated = source.load(std::memory_order_seq_cst);
+            if (validated == p) {
+                return p;
+            }
+            p = validated;
+        }
+    }
+
+    static void clear(hazard_record& record) noexcept
+    {
+        record.pointer.store(nullptr, std::memory_order_release);
+    }
+
+    // Frees `object` now or later, when no slot protects it
+    void retire(hazard_retirable* object) noexcept
+    {
+        push_retired(object);
+        scan();
+    }
+
+    // Frees the retired objects that are not protected
+    void scan() noexcept
+    {
+        hazard_retirable* list = retired.exchange(nullptr, std::memory_order_acq_rel);
+
+        // Orders the unlinking of the objects, that is not seq_cst, before
+        // the reads of the slots. Pairs with the seq_cst store and reload in
+        // protect(): either the reader sees the new pointer or the scan sees
+        // the hazard.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while (list) {
+            hazard_retirable* const next = list->next_retired;
+            if (is_protected(list)) {
+                push_retired(list);
+            } else {
+                list->destroy(list);
+            }
+            list = next;
+        }
+    }
+
+private:
+    struct record_owner {
+        hazard_record* record;
+
+        ~record_owner()
+        {
+            record->pointer.store(nullptr, std::memory_order_release);
+            record->active.store(false, std::memory_order_release);
+        }
+    };
+
+    hazard_domain() noexcept
+      : records(nullptr)
+      , retired(nullptr)
+    {}
+
+    hazard_record* acquire_record()
+    {
+        for (hazard_record* r = records.load(std::memory_order_acquire); r; r = r->next) {
+            bool expected = false;
+            if (!r->active.load(std::memory_order_relaxed)
+                && r->active.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+            {
+                return r;
+            }
+        }
+
+        hazard_record* const r = new hazard_record;
+        r->pointer.store(nullptr, std::memory_order_relaxed);
+        r->active.store(true, std::memory_order_relaxed);
+        r->next = records.load(std::memory_order_relaxed);
+        while (!records.compare_exchange_weak(r->next, r, std::memory_order_acq_rel)) {}
+        return r;
+    }
+
+    bool is_protected(const void* object) const noexcept
+    {
+        for (hazard_record* r = records.load(std::memory_order_acquire); r; r = r->next) {
+            if (r->pointer.load(std::memory_order_seq_cst) == object) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void push_retired(hazard_retirable* object) noexcept
+    {
+        object->next_retired = retired.load(std::memory_order_relaxed);
+        while (!retired.compare_exchange_weak(object->next_retired, object, std::memory_order_acq_rel)) {}
+    }
+
+    std::atomic<hazard_record*> records;
+    std::atomic<hazard_retirable*> retired;
+};
+
+// Clears the slot on scope exit, even if the protected code throws
+struct hazard_guard {
+    hazard_record& record;
+
+    ~hazard_guard()
+    {
+        hazard_domain::clear(record);
+    }
+};
+
+} // namespace detail
+} // namespace anys
+} // namespace boost
+/// @endcond
+
+#endif  // #if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+#endif  // #ifndef BOOST_ANY_ANYS_DETAIL_HAZARD_POINTER_HPP
@@ -17,6 +17,8 @@
 # pragma once
 #endif
 
+#include <memory>
+
 #include <boost/type_index.hpp>
 #endif
 
@@ -25,10 +27,46 @@ namespace boost {
 namespace anys {
 namespace detail {
 
+struct value_ops;
+
 class BOOST_SYMBOL_VISIBLE placeholder {
 public:
     virtual ~placeholder() {}
     virtual const boost::typeindex::type_info& type() const noexcept = 0;
+#if defined(BOOST_ANY_USE_POLYMORPHIC_CAST) && !defined(BOOST_NO_EXCEPTIONS)
+    // Throws the pointer to the held value. Allows to catch it as a pointer
+    // to any unambiguous public base of the held type. Opt-in, as it emits
+    // a throw site and the pointer typeinfo for each held type.
+    virtual void throw_address() const = 0;
+#endif
+
+#ifdef BOOST_ANY_USE_HOLDER_VALUE_OPS
+    // Operations on the held value and its address, nullptr if the holder
+    // does not provide them. Opt-in, as the boost::any holders instantiate
+    // value_ops_of for each held type to provide them.
+    virtual const value_ops* ops() const noexcept { return nullptr; }
+    virtual void* address() const noexcept { return nullptr; }
+#endif
+};
+
+// Access to the placeholder of the node based anys.
+struct placeholder_access {
+    template <class Any>
+    static placeholder* content(const Any& operand) noexcept
+    {
+        return placeholder_access::get(operand.content);
+    }
+
+private:
+    static placeholder* get(placeholder* p) noexcept
+    {
+        return p;
+    }
+
+    static placeholder* get(const std::unique_ptr<placeholder>& p) noexcept
+    {
+        return p.get();
+    }
 };
 
 } // namespace detail
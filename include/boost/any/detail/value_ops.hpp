@@ -0,0 +1,165 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_ANY_ANYS_DETAIL_VALUE_OPS_HPP
+#define BOOST_ANY_ANYS_DETAIL_VALUE_OPS_HPP
+
+#include <boost/any/detail/config.hpp>
+
+#if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+#ifndef BOOST_ANY_INTERFACE_UNIT
+#include <boost/config.hpp>
+#ifdef BOOST_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <boost/type_index.hpp>
+#endif
+
+/// @cond
+namespace boost {
+namespace anys {
+namespace detail {
+
+// Operations on a value of a type that is known only at runtime. Used by the
+// containers that keep the values of different types in their own storage
+// instead of a holder per value.
+//
+// There is exactly one instance per type in a program (modulo shared
+// libraries), so the address of the instance identifies the type.
+struct value_ops {
+    const boost::typeindex::type_info& (*type)();
+    std::size_t size;
+    std::size_t alignment;
+
+    // Values may be relocated with std::memcpy.
+    bool trivially_relocatable;
+
+    // `move` does not throw.
+    bool nothrow_move;
+
+    // nullptr if the type is not copy constructible.
+    void (*copy)(void* dest, const void* source);
+
+    // Move constructs the value at `dest` from `source`. Copies if the type
+    // has no usable move constructor, nullptr if it has no copy constructor
+    // either.
+    void (*move)(void* dest, void* source);
+
+    // Moves the value as `move` does and destroys the `source`. nullptr if
+    // `move` is nullptr.
+    void (*relocate)(void* dest, void* source);
+
+    void (*destroy)(void* value);
+};
+
+template <class T>
+struct value_ops_of {
+    // Types with a deleted move constructor are moved by copying
+    using move_source = typename std::conditional<
+        std::is_move_constructible<T>::value, T&&, const T&
+    >::type;
+
+    static const boost::typeindex::type_info& type()
+    {
+        return boost::typeindex::type_id<T>().type_info();
+    }
+
+    static void copy(void* dest, const void* source)
+    {
+        ::new (dest) T(*static_cast<const T*>(source));
+    }
+
+    static void move(void* dest, void* source)
+    {
+        ::new (dest) T(static_cast<move_source>(*static_cast<T*>(source)));
+    }
+
+    static void relocate(void* dest, void* source)
+    {
+        T* const value = static_cast<T*>(source);
+        ::new (dest) T(static_cast<move_source>(*value));
+        value->~T();
+    }
+
+    static void destroy(void* value)
+    {
+        static_cast<T*>(value)->~T();
+    }
+
+    static constexpr void (*copy_ptr(std::true_type))(void*, const void*)
+    {
+        return &value_ops_of::copy;
+    }
+
+    static constexpr void (*copy_ptr(std::false_type))(void*, const void*)
+    {
+        return nullptr;
+    }
+
+    static constexpr void (*move_ptr(std::true_type))(void*, void*)
+    {
+        return &value_ops_of::move;
+    }
+
+    static constexpr void (*move_ptr(std::false_type))(void*, void*)
+    {
+        return nullptr;
+    }
+
+    static constexpr void (*relocate_ptr(std::true_type))(void*, void*)
+    {
+        return &value_ops_of::relocate;
+    }
+
+    static constexpr void (*relocate_ptr(std::false_type))(void*, void*)
+    {
+        return nullptr;
+    }
+
+    using is_movable = std::integral_constant<bool,
+        std::is_move_constructible<T>::value || std::is_copy_constructible<T>::value
+    >;
+
+    static constexpr value_ops value = {
+        &value_ops_of::type,
+        sizeof(T),
+        alignof(T),
+        std::is_trivially_copyable<T>::value,
+        std::is_nothrow_constructible<T, move_source>::value,
+        value_ops_of::copy_ptr(std::is_copy_constructible<T>()),
+        value_ops_of::move_ptr(is_movable()),
+        value_ops_of::relocate_ptr(is_movable()),
+        &value_ops_of::destroy
+    };
+};
+
+template <class T>
+constexpr value_ops value_ops_of<T>::value;
+
+// Comparing the addresses is enough for the types from the same module.
+// Otherwise falls back to the type_info comparison.
+template <class T>
+inline bool is_value_ops_of(const value_ops* ops) noexcept
+{
+    return ops == &value_ops_of<T>::value
+        || (ops && ops->type() == boost::typeindex::type_id<T>());
+}
+
+} // namespace detail
+} // namespace anys
+} // namespace boost
+/// @endcond
+
+#endif  // #if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+#endif  // #ifndef BOOST_ANY_ANYS_DETAIL_VALUE_OPS_HPP
@@ -0,0 +1,351 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/any for Documentation.
+
+#ifndef BOOST_ANYS_EVENT_BUS_HPP_INCLUDED
+#define BOOST_ANYS_EVENT_BUS_HPP_INCLUDED
+
+#include <boost/any/detail/config.hpp>
+
+#if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+/// \file boost/any/event_bus.hpp
+/// \brief \copybrief boost::anys::event_bus
+
+#ifndef BOOST_ANY_INTERFACE_UNIT
+#include <boost/config.hpp>
+#ifdef BOOST_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/type_index.hpp>
+#endif  // #ifndef BOOST_ANY_INTERFACE_UNIT
+
+#include <boost/any.hpp>
+#include <boost/any/detail/placeholder.hpp>
+
+namespace boost {
+
+namespace anys {
+
+/// @cond
+namespace detail {
+
+    struct event_handler {
+        // Zero once unsubscribed during a delivery
+        std::size_t id;
+        std::function<void(const boost::any&)> call;
+    };
+
+    // The topic is looked up by the type of the event, so the handler may
+    // skip the type check
+    template <class T, class F>
+    struct typed_event_handler {
+        F f;
+
+        void operator()(const boost::any& event)
+        {
+            f(*boost::unsafe_any_cast<T>(&event));
+        }
+    };
+
+    struct event_topic {
+        // Handlers do not move, so a handler may subscribe another one
+        std::vector<std::unique_ptr<event_handler>> handlers;
+
+        // Events of the topic collected by publish_many()
+        std::vector<const boost::any*> pending;
+    };
+
+    struct event_type_hash {
+        std::size_t operator()(const boost::typeindex::type_index& key) const noexcept
+        {
+            return key.hash_code();
+        }
+    };
+
+} // namespace detail
+/// @endcond
+
+BOOST_ANY_BEGIN_MODULE_EXPORT
+
+/// \brief Publish/subscribe dispatcher of boost::any events that delivers
+/// an event only to the subscribers of its stored type.
+///
+/// Subscribers are indexed by the type, so publish() finds the handler list
+/// with a single lookup and calls each handler with a typed reference,
+/// without a boost::any_cast per handler. Events nobody is subscribed to
+/// cost one lookup:
+/// \code
+/// boost::anys::event_bus bus;
+/// bus.subscribe<key_pressed>([](const key_pressed& e) { on_key(e.code); });
+///
+/// bus.publish(boost::any(key_pressed{'q'}));
+/// \endcode
+///
+/// Handlers may subscribe and unsubscribe handlers and publish events.
+/// A handler subscribed during a delivery does not receive the event that is
+/// being delivered. The bus is not safe to use concurrently.
+class event_bus {
+public:
+    /// Identifier of a subscription, never 0.
+    using subscription = std::size_t;
+
+    event_bus() noexcept
+      : next_id(1)
+      , depth(0)
+      , has_removed(false)
+    {}
+
+    event_bus(const event_bus&) = delete;
+    event_bus& operator=(const event_bus&) = delete;
+
+    /// Subscribes `f` to the events that store a `T`. `f` is called as
+    /// `f(const T&)`.
+    /// \returns Identifier for unsubscribe().
+    /// \throws std::bad_alloc or any exceptions arising from the copy or
+    /// move constructor of `F`.
+    template <class T, class F>
+    subscription subscribe(F&& f)
+    {
+        static_assert(
+            std::is_same<T, typename std::decay<T>::type>::value,
+            "boost::anys::event_bus event types shall be decayed, as boost::any stores them"
+        );
+
+        using handler_type = detail::typed_event_handler<T, typename std::decay<F>::type>;
+        std::unique_ptr<detail::event_handler> handler(new detail::event_handler{
+            next_id, handler_type{std::forward<F>(f)}
+        });
+
+        const boost::typeindex::type_index key = boost::typeindex::type_id<T>();
+        auto it = topics.find(key);
+        if (it == topics.end()) {
+            it = topics.emplace(key, detail::event_topic()).first;
+
+            // Cached misses may refer to the type
+            by_address.clear();
+        }
+        it->second.handlers.push_back(std::move(handler));
+        return next_id++;
+    }
+
+    /// Removes the subscription `id`. The handler is not called after the
+    /// function returns, but is destroyed only after the current delivery
+    /// if called from a handler.
+    /// \returns `true` if there was such subscription.
+    bool unsubscribe(subscription id) noexcept
+    {
+        if (!id) {
+            return false;
+        }
+
+        for (auto& topic : topics) {
+            auto& handlers = topic.second.handlers;
+            for (auto it = handlers.begin(); it != handlers.end(); ++it) {
+                if ((*it)->id != id) {
+                    continue;
+                }
+                if (depth) {
+                    (*it)->id = 0;
+                    has_removed = true;
+                } else {
+                    handlers.erase(it);
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Calls the handlers subscribed to the type stored in `event`.
+    /// \returns Count of the called handlers.
+    /// \throws std::bad_alloc or any exceptions arising from the handlers.
+    /// Handlers after the throwing one are not called.
+    std::size_t publish(const boost::any& event)
+    {
+        detail::event_topic* topic = resolve(event);
+        if (!topic) {
+            return 0;
+        }
+
+        delivery_guard guard{*this};
+        return deliver(*topic, event);
+    }
+
+    /// Publishes the events of [`first`, `last`) grouped by type: the
+    /// handler list is resolved once per run of events of the same type,
+    /// and all the events of a type are delivered before the events of the
+    /// next type. Types follow in the order of their first event, events of
+    /// the same type keep their order.
+    ///
+    /// `ForwardIterator` shall dereference to boost::any. If called from a
+    /// handler, the events are published one by one.
+    /// \returns Count of the handler calls.
+    /// \throws std::bad_alloc or any exceptions arising from the handlers.
+    template <class ForwardIterator>
+    std::size_t publish_many(ForwardIterator first, ForwardIterator last)
+    {
+        std::size_t delivered = 0;
+        if (depth) {
+            for (; first != last; ++first) {
+                delivered += publish(*first);
+            }
+            return delivered;
+        }
+
+        batch_guard guard{*this};
+        const boost::typeindex::type_info* previous_type = nullptr;
+        detail::event_topic* previous = nullptr;
+        for (; first != last; ++first) {
+            const boost::any& event = *first;
+            const boost::typeindex::type_info* type = type_of(event);
+            detail::event_topic* topic = (type && type == previous_type) ? previous : resolve(event);
+            previous_type = type;
+            previous = topic;
+            if (!topic) {
+                continue;
+            }
+
+            if (topic->pending.empty()) {
+                guard.touched.push_back(topic);
+            }
+            topic->pending.push_back(&event);
+        }
+
+        for (detail::event_topic* topic : guard.touched) {
+            std::vector<const boost::any*> batch;
+            batch.swap(topic->pending);
+            for (const boost::any* event : batch) {
+                delivered += deliver(*topic, *event);
+            }
+
+            // Keep the capacity for the next batch
+            batch.clear();
+            topic->pending.swap(batch);
+        }
+        return delivered;
+    }
+
+private:
+    /// @cond
+    struct delivery_guard {
+        event_bus& bus;
+
+        explicit delivery_guard(event_bus& b) noexcept
+          : bus(b)
+        {
+            ++bus.depth;
+        }
+
+        ~delivery_guard()
+        {
+            if (!--bus.depth && bus.has_removed) {
+                bus.remove_unsubscribed();
+            }
+        }
+    };
+
+    struct batch_guard: delivery_guard {
+        std::vector<detail::event_topic*> touched;
+
+        explicit batch_guard(event_bus& b) noexcept
+          : delivery_guard(b)
+        {}
+
+        // Events left if a handler has thrown
+        ~batch_guard()
+        {
+            for (detail::event_topic* topic : touched) {
+                topic->pending.clear();
+            }
+        }
+    };
+
+    static const boost::typeindex::type_info* type_of(const boost::any& event) noexcept
+    {
+        const detail::placeholder* content = detail::placeholder_access::content(event);
+        return content ? &content->type() : nullptr;
+    }
+
+    // Types are cached by the address of their type_info, the type_index
+    // lookup is needed only for the first event of each type_info
+    detail::event_topic* resolve(const boost::any& event)
+    {
+        const boost::typeindex::type_info* type = type_of(event);
+        if (!type) {
+            return nullptr;
+        }
+
+        const auto cached = by_address.find(type);
+        if (cached != by_address.end()) {
+            return cached->second;
+        }
+
+        const auto it = topics.find(boost::typeindex::type_index(*type));
+        detail::event_topic* topic = (it == topics.end() ? nullptr : &it->second);
+        by_address.emplace(type, topic);
+        return topic;
+    }
+
+    static std::size_t deliver(detail::event_topic& topic, const boost::any& event)
+    {
+        std::size_t delivered = 0;
+
+        // Handlers subscribed meanwhile are appended and skipped
+        const std::size_t count = topic.handlers.size();
+        for (std::size_t i = 0; i < count; ++i) {
+            detail::event_handler& handler = *topic.handlers[i];
+            if (handler.id) {
+                handler.call(event);
+                ++delivered;
+            }
+        }
+        return delivered;
+    }
+
+    void remove_unsubscribed() noexcept
+    {
+        for (auto& topic : topics) {
+            auto& handlers = topic.second.handlers;
+            handlers.erase(
+                std::remove_if(handlers.begin(), handlers.end(), [](const std::unique_ptr<detail::event_handler>& h) {
+                    return !h->id;
+                }),
+                handlers.end()
+            );
+        }
+        has_removed = false;
+    }
+
+    // Topics are never removed, so the pointers to them stay valid
+    std::unordered_map<boost::typeindex::type_index, detail::event_topic, detail::event_type_hash> topics;
+    std::unordered_map<const boost::typeindex::type_info*, detail::event_topic*> by_address;
+    subscription next_id;
+    std::size_t depth;
+    bool has_removed;
+    /// @endcond
+};
+
+BOOST_ANY_END_MODULE_EXPORT
+
+} // namespace anys
+
+} // namespace boost
+
+#endif  // #if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+#endif // #ifndef BOOST_ANYS_EVENT_BUS_HPP_INCLUDED
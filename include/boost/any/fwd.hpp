@@ -37,9 +37,18 @@ BOOST_ANY_BEGIN_MODULE_EXPORT
 
 class unique_any;
 
+class compact_any;
+
+class any_ref;
+
+class any_cref;
+
 template<std::size_t OptimizeForSize = sizeof(void*), std::size_t OptimizeForAlignment = alignof(void*)>
 class basic_any;
 
+template<std::size_t OptimizeForSize, std::size_t OptimizeForAlignment, class... Hints>
+class basic_any_hinted;
+
 BOOST_ANY_END_MODULE_EXPORT
 
 namespace detail {
@@ -50,6 +59,9 @@ namespace detail {
     template<std::size_t OptimizeForSize, std::size_t OptimizeForAlignment>
     struct is_basic_any<boost::anys::basic_any<OptimizeForSize, OptimizeForAlignment> > : public std::true_type {};
 
+    template<std::size_t OptimizeForSize, std::size_t OptimizeForAlignment, class... Hints>
+    struct is_basic_any<boost::anys::basic_any_hinted<OptimizeForSize, OptimizeForAlignment, Hints...> > : public std::true_type {};
+
     template <class T>
     struct is_some_any: public is_basic_any<T> {};
 
@@ -59,6 +71,15 @@ namespace detail {
     template <>
     struct is_some_any<boost::anys::unique_any>: public std::true_type {};
 
+    template <>
+    struct is_some_any<boost::anys::compact_any>: public std::true_type {};
+
+    template <>
+    struct is_some_any<boost::anys::any_ref>: public std::true_type {};
+
+    template <>
+    struct is_some_any<boost::anys::any_cref>: public std::true_type {};
+
 } // namespace detail
 
 } // namespace anys
@@ -0,0 +1,232 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/any for Documentation.
+
+#ifndef BOOST_ANYS_GROUP_BY_TYPE_HPP_INCLUDED
+#define BOOST_ANYS_GROUP_BY_TYPE_HPP_INCLUDED
+
+#include <boost/any/detail/config.hpp>
+
+#if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+/// \file boost/any/group_by_type.hpp
+/// \brief \copybrief boost::anys::group_by_type
+
+#ifndef BOOST_ANY_INTERFACE_UNIT
+#include <boost/config.hpp>
+#ifdef BOOST_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/type_index.hpp>
+#endif  // #ifndef BOOST_ANY_INTERFACE_UNIT
+
+#include <boost/any.hpp>
+#include <boost/any/basic_any.hpp>
+#include <boost/any/unique_any.hpp>
+#include <boost/any/detail/placeholder.hpp>
+#include <boost/any/detail/value_ops.hpp>
+
+namespace boost {
+
+namespace anys {
+
+/// @cond
+namespace detail {
+
+    // The manager is the type identity of basic_any
+    template <std::size_t Size, std::size_t Alignment>
+    auto group_key(const basic_any<Size, Alignment>& operand) noexcept
+        -> decltype(basic_any_access::identity(operand))
+    {
+        return basic_any_access::identity(operand);
+    }
+
+    // Node based anys have no type identity word, the address of the
+    // type_info of the holder is used instead
+    inline const boost::typeindex::type_info* group_key(const boost::any& operand) noexcept
+    {
+        const placeholder* content = placeholder_access::content(operand);
+        return content ? &content->type() : nullptr;
+    }
+
+    inline const boost::typeindex::type_info* group_key(const unique_any& operand) noexcept
+    {
+        const placeholder* content = placeholder_access::content(operand);
+        return content ? &content->type() : nullptr;
+    }
+
+    // basic_any may be relocated with std::memcpy if it is empty, if the
+    // value is on the heap or if the value is trivially copyable. The result
+    // is the same for all the values of a type, so it is computed once per
+    // group. Without the value_ops in the managers all the values in the
+    // buffer are moved.
+    template <std::size_t Size, std::size_t Alignment>
+    bool is_bitwise_relocatable(basic_any<Size, Alignment>& operand) noexcept
+    {
+#ifdef BOOST_ANY_USE_HOLDER_VALUE_OPS
+        const value_ops* ops = basic_any_access::ops(operand);
+        if (!ops || ops->trivially_relocatable) {
+            return true;
+        }
+#else
+        if (operand.empty()) {
+            return true;
+        }
+#endif
+
+        const std::uintptr_t self = reinterpret_cast<std::uintptr_t>(std::addressof(operand));
+        const std::uintptr_t value = reinterpret_cast<std::uintptr_t>(basic_any_access::address(operand));
+        return value < self || value >= self + sizeof(operand);
+    }
+
+    // Moving a node based any is already a pointer steal
+    inline bool is_bitwise_relocatable(const boost::any&) noexcept { return false; }
+    inline bool is_bitwise_relocatable(const unique_any&) noexcept { return false; }
+
+    template <class Any>
+    void relocate_any(void* dest, Any& source, bool bitwise) noexcept
+    {
+        if (bitwise) {
+            std::memcpy(dest, static_cast<void*>(std::addressof(source)), sizeof(Any));
+        } else {
+            ::new (dest) Any(std::move(source));
+            source.~Any();
+        }
+    }
+
+    // Uninitialized storage for an `Any`
+    template <class Any>
+    struct any_storage {
+        alignas(Any) unsigned char data[sizeof(Any)];
+    };
+
+} // namespace detail
+/// @endcond
+
+BOOST_ANY_BEGIN_MODULE_EXPORT
+
+/// Reorders the elements of [`first`, `last`) so that the elements with the
+/// same stored type are adjacent. The groups follow in the order of the
+/// first occurrence of their type, empty elements form a group of their own.
+/// The relative order of the elements within a group is preserved.
+///
+/// Works as a counting sort by the type identity: the identities are
+/// collected in one pass, after that each element is relocated exactly
+/// twice, via std::memcpy where possible, instead of the O(N log N) swaps of
+/// a comparison sort. Turns the per element dispatch into the per group
+/// loops:
+/// \code
+/// boost::anys::group_by_type(batch.begin(), batch.end());
+/// // Values of the same type are now adjacent
+/// \endcode
+///
+/// `ForwardIterator` shall dereference to boost::anys::basic_any,
+/// boost::any or boost::anys::unique_any. Values of the same type from
+/// different shared libraries may form different groups.
+///
+/// \returns Count of the groups.
+/// \throws std::bad_alloc. The range is not modified if an exception is
+/// thrown.
+template <class ForwardIterator>
+std::size_t group_by_type(ForwardIterator first, ForwardIterator last)
+{
+    using any_type = typename std::iterator_traits<ForwardIterator>::value_type;
+    using key_type = decltype(detail::group_key(*first));
+    static_assert(
+        std::is_nothrow_move_constructible<any_type>::value,
+        "boost::anys::group_by_type requires nothrow move constructible anys"
+    );
+
+    struct group {
+        std::size_t position;
+        bool bitwise;
+    };
+
+    const std::size_t size = static_cast<std::size_t>(std::distance(first, last));
+    std::vector<std::size_t> ids(size);
+    std::vector<group> groups;
+    std::unordered_map<key_type, std::size_t> index;
+
+    key_type previous_key = key_type();
+    std::size_t previous_id = 0;
+    bool grouped = true;
+    std::size_t i = 0;
+    for (ForwardIterator it = first; it != last; ++it, ++i) {
+        const key_type key = detail::group_key(*it);
+        if (i && key == previous_key) {
+            ids[i] = previous_id;
+            ++groups[previous_id].position;
+            continue;
+        }
+
+        const auto inserted = index.emplace(key, groups.size());
+        if (inserted.second) {
+            groups.push_back(group{0, detail::is_bitwise_relocatable(*it)});
+        } else {
+            grouped = false;
+        }
+        previous_key = key;
+        previous_id = inserted.first->second;
+        ids[i] = previous_id;
+        ++groups[previous_id].position;
+    }
+
+    if (grouped) {
+        return groups.size();
+    }
+
+    // Counts into starting positions
+    std::size_t position = 0;
+    for (group& g : groups) {
+        const std::size_t count = g.position;
+        g.position = position;
+        position += count;
+    }
+
+    using storage = detail::any_storage<any_type>;
+    std::unique_ptr<storage[]> scratch(new storage[size]);
+    std::vector<bool> bitwise(size);
+
+    // Nothing throws below
+    i = 0;
+    for (ForwardIterator it = first; it != last; ++it, ++i) {
+        group& g = groups[ids[i]];
+        bitwise[g.position] = g.bitwise;
+        detail::relocate_any(&scratch[g.position], *it, g.bitwise);
+        ++g.position;
+    }
+
+    i = 0;
+    for (ForwardIterator it = first; it != last; ++it, ++i) {
+        any_type& value = *reinterpret_cast<any_type*>(&scratch[i]);
+        detail::relocate_any(static_cast<void*>(std::addressof(*it)), value, bitwise[i]);
+    }
+
+    return groups.size();
+}
+
+BOOST_ANY_END_MODULE_EXPORT
+
+} // namespace anys
+
+} // namespace boost
+
+#endif  // #if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+#endif // #ifndef BOOST_ANYS_GROUP_BY_TYPE_HPP_INCLUDED
@@ -0,0 +1,365 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/any for Documentation.
+
+#ifndef BOOST_ANYS_PARALLEL_HPP_INCLUDED
+#define BOOST_ANYS_PARALLEL_HPP_INCLUDED
+
+#include <boost/any/detail/config.hpp>
+
+#if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+/// \file boost/any/parallel.hpp
+/// \brief Bulk algorithms over large ranges of anys, that split the range
+/// between threads.
+
+#ifndef BOOST_ANY_INTERFACE_UNIT
+#include <boost/config.hpp>
+#ifdef BOOST_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#endif  // #ifndef BOOST_ANY_INTERFACE_UNIT
+
+#include <boost/any.hpp>
+#include <boost/any/any_cast_range.hpp>
+#include <boost/any/basic_any.hpp>
+#include <boost/any/group_by_type.hpp>
+#include <boost/any/unique_any.hpp>
+
+namespace boost {
+
+namespace anys {
+
+/// @cond
+namespace detail {
+
+    // Ranges shorter than that are not worth a thread
+    constexpr std::size_t parallel_grain = 4096;
+
+    inline std::size_t parallel_workers(std::size_t size, std::size_t threads) noexcept
+    {
+        if (!threads) {
+            threads = std::thread::hardware_concurrency();
+        }
+        const std::size_t by_size = (size + parallel_grain - 1) / parallel_grain;
+        return (std::max)(std::size_t{1}, (std::min)(threads, by_size));
+    }
+
+    // Calls `f(worker, begin, end)` for `workers` contiguous slices of
+    // [0, size), the slice 0 is processed by the calling thread. Slices that
+    // did not get a thread because of the thread creation failure are also
+    // processed by the calling thread. Rethrows the exception of the first
+    // failed slice after all the slices finish.
+    //
+    // The bookkeeping is allocated by the constructor, so the slices may be
+    // run several times without a std::bad_alloc between the runs.
+    class parallel_slices {
+    public:
+        explicit parallel_slices(std::size_t workers)
+          : errors(workers > 1 ? workers : 0)
+          , count(workers)
+        {
+            threads.reserve(errors.empty() ? 0 : workers - 1);
+        }
+
+        parallel_slices(const parallel_slices&) = delete;
+        parallel_slices& operator=(const parallel_slices&) = delete;
+
+        ~parallel_slices()
+        {
+            join();
+        }
+
+        template <class F>
+        void operator()(std::size_t size, F& f)
+        {
+            if (count == 1) {
+                f(std::size_t{0}, std::size_t{0}, size);
+                return;
+            }
+
+            const std::size_t workers = count;
+            std::vector<std::exception_ptr>& failures = errors;
+            const auto run = [&f, &failures, size, workers](std::size_t worker) {
+#ifndef BOOST_NO_EXCEPTIONS
+                try {
+#endif
+                    f(worker, size * worker / workers, size * (worker + 1) / workers);
+#ifndef BOOST_NO_EXCEPTIONS
+                } catch (...) {
+                    failures[worker] = std::current_exception();
+                }
+#endif
+            };
+
+            std::size_t started = 1;
+#ifndef BOOST_NO_EXCEPTIONS
+            try {
+#endif
+                for (; started < workers; ++started) {
+                    threads.emplace_back(run, started);
+                }
+#ifndef BOOST_NO_EXCEPTIONS
+            } catch (...) {
+                // Out of threads, the rest is done by the calling thread
+            }
+#endif
+            for (std::size_t worker = started; worker < workers; ++worker) {
+                run(worker);
+            }
+            run(0);
+            join();
+
+            for (const std::exception_ptr& e : errors) {
+                if (e) {
+                    std::rethrow_exception(e);
+                }
+            }
+        }
+
+    private:
+        void join() noexcept
+        {
+            for (std::thread& t : threads) {
+                t.join();
+            }
+            threads.clear();
+        }
+
+        std::vector<std::exception_ptr> errors;
+        std::vector<std::thread> threads;
+        const std::size_t count;
+    };
+
+    template <class ValueType, std::size_t Size, std::size_t Alignment>
+    ValueType* typed_address(const basic_any<Size, Alignment>& operand) noexcept
+    {
+        auto& value = const_cast<basic_any<Size, Alignment>&>(operand);
+        return basic_any_access::identity(value) == basic_any_access::identity_of<ValueType, Size, Alignment>()
+            ? basic_any_access::get<ValueType>(value)
+            : nullptr;
+    }
+
+    template <class ValueType>
+    ValueType* typed_address(const boost::any& operand) noexcept
+    {
+        return boost::any_cast<ValueType>(&const_cast<boost::any&>(operand));
+    }
+
+    template <class ValueType>
+    ValueType* typed_address(const unique_any& operand) noexcept
+    {
+        return anys::any_cast<ValueType>(&const_cast<unique_any&>(operand));
+    }
+
+    // Groups of a slice in the order of their first occurrence
+    template <class Key>
+    struct slice_groups {
+        std::vector<Key> keys;
+        std::vector<std::size_t> counts;
+        std::vector<unsigned char> bitwise;
+        std::vector<std::size_t> positions;
+    };
+
+} // namespace detail
+/// @endcond
+
+BOOST_ANY_BEGIN_MODULE_EXPORT
+
+/// Copy assigns the elements of [`first`, `last`) to the elements starting
+/// at `out`, splitting the range between `threads` threads. Zero `threads`
+/// means std::thread::hardware_concurrency(). Short ranges are copied by
+/// the calling thread.
+///
+/// The allocations for the copied values are done by each thread in
+/// parallel, so their cost scales with the count of threads if the global
+/// allocator has per thread caches.
+///
+/// \returns `out + (last - first)`
+/// \throws std::bad_alloc or any exception arising from the copy
+/// assignment. Some of the elements may be copied in that case.
+template <class RandomAccessIterator, class OutputRandomAccessIterator>
+OutputRandomAccessIterator parallel_copy(RandomAccessIterator first, RandomAccessIterator last,
+    OutputRandomAccessIterator out, std::size_t threads = 0)
+{
+    const std::size_t size = static_cast<std::size_t>(last - first);
+    auto copy = [first, out](std::size_t, std::size_t begin, std::size_t end) {
+        std::copy(first + begin, first + end, out + begin);
+    };
+    detail::parallel_slices(detail::parallel_workers(size, threads))(size, copy);
+    return out + size;
+}
+
+/// Destroys the values of the elements of [`first`, `last`), leaving them
+/// empty, splitting the range between `threads` threads. Zero `threads`
+/// means std::thread::hardware_concurrency().
+///
+/// Use it before destroying a large container of anys to make the teardown
+/// scale with the count of threads.
+///
+/// \throws std::bad_alloc. The range is not modified in that case.
+template <class RandomAccessIterator>
+void parallel_reset(RandomAccessIterator first, RandomAccessIterator last, std::size_t threads = 0)
+{
+    using any_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+    const std::size_t size = static_cast<std::size_t>(last - first);
+    auto reset = [first](std::size_t, std::size_t begin, std::size_t end) {
+        for (auto it = first + begin; it != first + end; ++it) {
+            *it = any_type();
+        }
+    };
+    detail::parallel_slices(detail::parallel_workers(size, threads))(size, reset);
+}
+
+/// Calls `f(ValueType&)` for each element of [`first`, `last`) that holds
+/// a `ValueType`, splitting the range between `threads` threads. Zero
+/// `threads` means std::thread::hardware_concurrency(). `f` is called
+/// concurrently. `f` receives `const ValueType&` if the elements are constant.
+///
+/// `RandomAccessIterator` shall dereference to boost::anys::basic_any,
+/// boost::any or boost::anys::unique_any.
+///
+/// \throws Any exception arising from `f`.
+template <class ValueType, class RandomAccessIterator, class F>
+void parallel_for_each_type(RandomAccessIterator first, RandomAccessIterator last, F f, std::size_t threads = 0)
+{
+    using type = typename std::remove_cv<ValueType>::type;
+    using pointer = detail::cast_range_pointer<RandomAccessIterator, ValueType>;
+    const std::size_t size = static_cast<std::size_t>(last - first);
+    auto visit = [first, &f](std::size_t, std::size_t begin, std::size_t end) {
+        for (auto it = first + begin; it != first + end; ++it) {
+            const pointer value = detail::typed_address<type>(*it);
+            if (value) {
+                f(*value);
+            }
+        }
+    };
+    detail::parallel_slices(detail::parallel_workers(size, threads))(size, visit);
+}
+
+/// Same as boost::anys::group_by_type, but splits the range between
+/// `threads` threads. Zero `threads` means
+/// std::thread::hardware_concurrency().
+///
+/// Each thread collects the type identities of its slice, the groups of the
+/// slices are merged in order, after that each thread relocates the
+/// elements of its slice to their positions. The result is the same as of
+/// boost::anys::group_by_type.
+///
+/// \returns Count of the groups.
+/// \throws std::bad_alloc. The range is not modified if an exception is
+/// thrown.
+template <class RandomAccessIterator>
+std::size_t parallel_group_by_type(RandomAccessIterator first, RandomAccessIterator last, std::size_t threads = 0)
+{
+    using any_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+    using key_type = decltype(detail::group_key(*first));
+    static_assert(
+        std::is_nothrow_move_constructible<any_type>::value,
+        "boost::anys::parallel_group_by_type requires nothrow move constructible anys"
+    );
+
+    const std::size_t size = static_cast<std::size_t>(last - first);
+    const std::size_t workers = detail::parallel_workers(size, threads);
+    if (workers == 1) {
+        return anys::group_by_type(first, last);
+    }
+
+    // All the allocations are done before the first element is relocated
+    detail::parallel_slices run_slices(workers);
+
+    // Groups of each slice
+    std::vector<std::size_t> ids(size);
+    std::vector<detail::slice_groups<key_type>> slices(workers);
+    auto collect = [first, &ids, &slices](std::size_t worker, std::size_t begin, std::size_t end) {
+        detail::slice_groups<key_type>& slice = slices[worker];
+        std::unordered_map<key_type, std::size_t> index;
+        for (std::size_t i = begin; i != end; ++i) {
+            const auto inserted = index.emplace(detail::group_key(first[i]), slice.keys.size());
+            if (inserted.second) {
+                slice.keys.push_back(inserted.first->first);
+                slice.counts.push_back(0);
+                slice.bitwise.push_back(detail::is_bitwise_relocatable(first[i]));
+            }
+            ids[i] = inserted.first->second;
+            ++slice.counts[inserted.first->second];
+        }
+        slice.positions.resize(slice.keys.size());
+    };
+    run_slices(size, collect);
+
+    // Merges the groups in the order of the first occurrence
+    std::unordered_map<key_type, std::size_t> index;
+    std::vector<std::vector<std::pair<std::size_t, std::size_t>>> members;
+    for (std::size_t worker = 0; worker < workers; ++worker) {
+        const detail::slice_groups<key_type>& slice = slices[worker];
+        for (std::size_t local = 0; local < slice.keys.size(); ++local) {
+            const auto inserted = index.emplace(slice.keys[local], members.size());
+            if (inserted.second) {
+                members.emplace_back();
+            }
+            members[inserted.first->second].emplace_back(worker, local);
+        }
+    }
+
+    std::size_t position = 0;
+    for (const auto& group : members) {
+        for (const auto& member : group) {
+            slices[member.first].positions[member.second] = position;
+            position += slices[member.first].counts[member.second];
+        }
+    }
+
+    using storage = detail::any_storage<any_type>;
+    std::unique_ptr<storage[]> scratch(new storage[size]);
+    std::vector<unsigned char> bitwise(size);
+
+    // Nothing throws below: relocations do not throw and the bookkeeping of
+    // the threads is already allocated. Slices that fail to get a thread are
+    // relocated by the calling thread
+    auto relocate_out = [first, &ids, &slices, &scratch, &bitwise](std::size_t worker, std::size_t begin, std::size_t end) {
+        detail::slice_groups<key_type>& slice = slices[worker];
+        for (std::size_t i = begin; i != end; ++i) {
+            const std::size_t local = ids[i];
+            const std::size_t to = slice.positions[local]++;
+            bitwise[to] = slice.bitwise[local];
+            detail::relocate_any(&scratch[to], first[i], slice.bitwise[local] != 0);
+        }
+    };
+    run_slices(size, relocate_out);
+
+    auto relocate_back = [first, &scratch, &bitwise](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i != end; ++i) {
+            any_type& value = *reinterpret_cast<any_type*>(&scratch[i]);
+            detail::relocate_any(static_cast<void*>(std::addressof(first[i])), value, bitwise[i] != 0);
+        }
+    };
+    run_slices(size, relocate_back);
+
+    return members.size();
+}
+
+BOOST_ANY_END_MODULE_EXPORT
+
+} // namespace anys
+
+} // namespace boost
+
+#endif  // #if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+#endif // #ifndef BOOST_ANYS_PARALLEL_HPP_INCLUDED
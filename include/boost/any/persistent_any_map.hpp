@@ -0,0 +1,453 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/any for Documentation.
+
+#ifndef BOOST_ANYS_PERSISTENT_ANY_MAP_HPP_INCLUDED
+#define BOOST_ANYS_PERSISTENT_ANY_MAP_HPP_INCLUDED
+
+#include <boost/any/detail/config.hpp>
+
+#if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+/// \file boost/any/persistent_any_map.hpp
+/// \brief \copybrief boost::anys::basic_persistent_any_map
+
+#ifndef BOOST_ANY_INTERFACE_UNIT
+#include <boost/config.hpp>
+#ifdef BOOST_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#endif  // #ifndef BOOST_ANY_INTERFACE_UNIT
+
+#include <boost/any.hpp>
+
+namespace boost {
+
+namespace anys {
+
+/// @cond
+namespace detail {
+
+    // Immutable entry, shared by all the maps that contain it
+    struct hamt_leaf {
+        hamt_leaf(std::string&& k, std::size_t h, boost::any&& v) noexcept
+          : key(std::move(k))
+          , hash(h)
+          , value(std::move(v))
+        {}
+
+        const std::string key;
+        const std::size_t hash;
+        const boost::any value;
+    };
+
+    struct hamt_node;
+
+    using hamt_leaf_ptr = std::shared_ptr<const hamt_leaf>;
+    using hamt_node_ptr = std::shared_ptr<const hamt_node>;
+
+    constexpr unsigned hamt_bits = 5;
+    constexpr unsigned hamt_hash_bits = sizeof(std::size_t) * CHAR_BIT;
+
+    // Node of a hash array mapped trie: the bitmaps tell which of the 32
+    // slots of the level hold a leaf and which hold a child, the leaves and
+    // the children are stored densely in the order of their slots. Below
+    // the last level a collision node keeps the leaves with equal hashes
+    // unordered and has no bitmaps.
+    struct hamt_node {
+        std::uint32_t datamap = 0;
+        std::uint32_t nodemap = 0;
+        std::vector<hamt_leaf_ptr> leaves;
+        std::vector<hamt_node_ptr> children;
+    };
+
+    inline unsigned hamt_popcount(std::uint32_t x) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_popcount(x));
+#else
+        x = x - ((x >> 1) & 0x55555555u);
+        x = (x & 0x33333333u) + ((x >> 2) & 0x33333333u);
+        return static_cast<unsigned>((((x + (x >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24);
+#endif
+    }
+
+    inline std::uint32_t hamt_bit(std::size_t hash, unsigned shift) noexcept
+    {
+        return std::uint32_t(1) << ((hash >> shift) & ((1u << hamt_bits) - 1));
+    }
+
+    // Position of `bit` among the set bits of `map`
+    inline std::size_t hamt_index(std::uint32_t map, std::uint32_t bit) noexcept
+    {
+        return detail::hamt_popcount(map & (bit - 1));
+    }
+
+    // Owning pointer of the leaf of `key`, nullptr if there is no such key
+    inline const hamt_leaf_ptr* hamt_find(const hamt_node* node, const std::string& key, std::size_t hash) noexcept
+    {
+        unsigned shift = 0;
+        while (node) {
+            if (shift >= hamt_hash_bits) {
+                for (const hamt_leaf_ptr& leaf : node->leaves) {
+                    if (leaf->key == key) {
+                        return &leaf;
+                    }
+                }
+                return nullptr;
+            }
+
+            const std::uint32_t bit = detail::hamt_bit(hash, shift);
+            if (node->datamap & bit) {
+                const hamt_leaf_ptr& leaf = node->leaves[detail::hamt_index(node->datamap, bit)];
+                return (leaf->hash == hash && leaf->key == key) ? &leaf : nullptr;
+            }
+            if (!(node->nodemap & bit)) {
+                return nullptr;
+            }
+            node = node->children[detail::hamt_index(node->nodemap, bit)].get();
+            shift += hamt_bits;
+        }
+        return nullptr;
+    }
+
+    // Node at `shift` with two leaves of different keys
+    inline hamt_node_ptr hamt_merge(hamt_leaf_ptr a, hamt_leaf_ptr b, unsigned shift)
+    {
+        std::shared_ptr<hamt_node> node = std::make_shared<hamt_node>();
+        if (shift >= hamt_hash_bits) {
+            node->leaves.reserve(2);
+            node->leaves.push_back(std::move(a));
+            node->leaves.push_back(std::move(b));
+            return node;
+        }
+
+        const std::uint32_t bit_a = detail::hamt_bit(a->hash, shift);
+        const std::uint32_t bit_b = detail::hamt_bit(b->hash, shift);
+        if (bit_a == bit_b) {
+            node->children.push_back(detail::hamt_merge(std::move(a), std::move(b), shift + hamt_bits));
+            node->nodemap = bit_a;
+            return node;
+        }
+
+        node->leaves.reserve(2);
+        if (bit_a < bit_b) {
+            node->leaves.push_back(std::move(a));
+            node->leaves.push_back(std::move(b));
+        } else {
+            node->leaves.push_back(std::move(b));
+            node->leaves.push_back(std::move(a));
+        }
+        node->datamap = bit_a | bit_b;
+        return node;
+    }
+
+    // Copy of `node` with `leaf` added or replacing the leaf of the same
+    // key. Only the nodes on the path to the leaf are copied.
+    inline hamt_node_ptr hamt_insert(const hamt_node* node, hamt_leaf_ptr leaf, unsigned shift, bool& added)
+    {
+        std::shared_ptr<hamt_node> result = node ? std::make_shared<hamt_node>(*node) : std::make_shared<hamt_node>();
+        if (shift >= hamt_hash_bits) {
+            for (hamt_leaf_ptr& existing : result->leaves) {
+                if (existing->key == leaf->key) {
+                    existing = std::move(leaf);
+                    added = false;
+                    return result;
+                }
+            }
+            result->leaves.push_back(std::move(leaf));
+            added = true;
+            return result;
+        }
+
+        const std::uint32_t bit = detail::hamt_bit(leaf->hash, shift);
+        if (result->datamap & bit) {
+            const std::size_t i = detail::hamt_index(result->datamap, bit);
+            hamt_leaf_ptr& existing = result->leaves[i];
+            if (existing->hash == leaf->hash && existing->key == leaf->key) {
+                existing = std::move(leaf);
+                added = false;
+                return result;
+            }
+
+            // Both leaves go one level down
+            hamt_node_ptr child = detail::hamt_merge(existing, std::move(leaf), shift + hamt_bits);
+            result->children.insert(result->children.begin() + static_cast<std::ptrdiff_t>(detail::hamt_index(result->nodemap, bit)), std::move(child));
+            result->leaves.erase(result->leaves.begin() + static_cast<std::ptrdiff_t>(i));
+            result->datamap &= ~bit;
+            result->nodemap |= bit;
+            added = true;
+            return result;
+        }
+
+        if (result->nodemap & bit) {
+            hamt_node_ptr& child = result->children[detail::hamt_index(result->nodemap, bit)];
+            child = detail::hamt_insert(child.get(), std::move(leaf), shift + hamt_bits, added);
+            return result;
+        }
+
+        result->leaves.insert(result->leaves.begin() + static_cast<std::ptrdiff_t>(detail::hamt_index(result->datamap, bit)), std::move(leaf));
+        result->datamap |= bit;
+        added = true;
+        return result;
+    }
+
+    // The only leaf of a node that has no children, nullptr otherwise
+    inline const hamt_leaf_ptr* hamt_single_leaf(const hamt_node& node) noexcept
+    {
+        return (node.children.empty() && node.leaves.size() == 1) ? &node.leaves.front() : nullptr;
+    }
+
+    // Copy of `node` without the leaf of `key`, `node` itself if there is no
+    // such key. Nodes with a single leaf are merged into their parents, so
+    // the trie stays as short as after the insertions only.
+    inline hamt_node_ptr hamt_erase(const hamt_node_ptr& node, const std::string& key, std::size_t hash, unsigned shift, bool& removed)
+    {
+        removed = false;
+        if (shift >= hamt_hash_bits) {
+            for (std::size_t i = 0; i < node->leaves.size(); ++i) {
+                if (node->leaves[i]->key == key) {
+                    std::shared_ptr<hamt_node> result = std::make_shared<hamt_node>(*node);
+                    result->leaves.erase(result->leaves.begin() + static_cast<std::ptrdiff_t>(i));
+                    removed = true;
+                    return result;
+                }
+            }
+            return node;
+        }
+
+        const std::uint32_t bit = detail::hamt_bit(hash, shift);
+        if (node->datamap & bit) {
+            const std::size_t i = detail::hamt_index(node->datamap, bit);
+            const hamt_leaf& leaf = *node->leaves[i];
+            if (leaf.hash != hash || leaf.key != key) {
+                return node;
+            }
+
+            std::shared_ptr<hamt_node> result = std::make_shared<hamt_node>(*node);
+            result->leaves.erase(result->leaves.begin() + static_cast<std::ptrdiff_t>(i));
+            result->datamap &= ~bit;
+            removed = true;
+            return result;
+        }
+
+        if (!(node->nodemap & bit)) {
+            return node;
+        }
+
+        const std::size_t child_index = detail::hamt_index(node->nodemap, bit);
+        hamt_node_ptr child = detail::hamt_erase(node->children[child_index], key, hash, shift + hamt_bits, removed);
+        if (!removed) {
+            return node;
+        }
+
+        std::shared_ptr<hamt_node> result = std::make_shared<hamt_node>(*node);
+        if (const hamt_leaf_ptr* single = detail::hamt_single_leaf(*child)) {
+            const std::size_t leaf_index = detail::hamt_index(result->datamap, bit);
+            result->leaves.insert(result->leaves.begin() + static_cast<std::ptrdiff_t>(leaf_index), *single);
+            result->children.erase(result->children.begin() + static_cast<std::ptrdiff_t>(child_index));
+            result->nodemap &= ~bit;
+            result->datamap |= bit;
+        } else {
+            result->children[child_index] = std::move(child);
+        }
+        return result;
+    }
+
+    template <class F>
+    void hamt_for_each(const hamt_node* node, F& f)
+    {
+        if (!node) {
+            return;
+        }
+        for (const hamt_leaf_ptr& leaf : node->leaves) {
+            f(leaf->key, leaf->value);
+        }
+        for (const hamt_node_ptr& child : node->children) {
+            detail::hamt_for_each(child.get(), f);
+        }
+    }
+
+} // namespace detail
+/// @endcond
+
+BOOST_ANY_BEGIN_MODULE_EXPORT
+
+/// \brief Persistent map from `std::string` to boost::any: a copy is an
+/// O(1) snapshot that shares the whole structure with the original.
+///
+/// The map is a hash array mapped trie of immutable nodes with 32 slots
+/// per level. A modification copies only the nodes on the path to the
+/// changed entry, O(log32 N) nodes, and never copies the values, so the
+/// snapshots for the readers do not depend on the size of the state:
+/// \code
+/// boost::anys::persistent_any_map state;
+/// state.insert_or_assign("balance", 100);
+///
+/// const boost::anys::persistent_any_map snapshot = state;  // O(1)
+/// state.insert_or_assign("balance", 50);
+/// assert(*snapshot.get<int>("balance") == 100);
+/// \endcode
+///
+/// Different map objects that share the structure may be used from
+/// different threads concurrently. A single map object is not safe to
+/// modify concurrently.
+template <class Hash = std::hash<std::string>>
+class basic_persistent_any_map {
+public:
+    /// \post this->empty() is true.
+    basic_persistent_any_map() noexcept
+      : count(0)
+    {}
+
+    /// \returns Count of entries.
+    std::size_t size() const noexcept { return count; }
+
+    /// \returns `true` if there are no entries.
+    bool empty() const noexcept { return !count; }
+
+    /// \returns Pointer to the value of `key`, nullptr if there is no such
+    /// key. The pointer is valid until `*this` is modified or destroyed.
+    const boost::any* find(const std::string& key) const noexcept
+    {
+        const detail::hamt_leaf_ptr* leaf = detail::hamt_find(root.get(), key, Hash()(key));
+        return leaf ? &(*leaf)->value : nullptr;
+    }
+
+    /// \returns Shared pointer to the value of `key`, that keeps the value
+    /// alive independently from the map. Empty pointer if there is no such
+    /// key.
+    std::shared_ptr<const boost::any> share(const std::string& key) const noexcept
+    {
+        const detail::hamt_leaf_ptr* leaf = detail::hamt_find(root.get(), key, Hash()(key));
+        if (!leaf) {
+            return nullptr;
+        }
+        return std::shared_ptr<const boost::any>(*leaf, &(*leaf)->value);
+    }
+
+    /// \returns Pointer to the value of `key` if it is a `ValueType`,
+    /// nullptr otherwise. The pointer is valid until `*this` is modified or
+    /// destroyed.
+    template <class ValueType>
+    const ValueType* get(const std::string& key) const noexcept
+    {
+        return boost::any_cast<ValueType>(find(key));
+    }
+
+    /// \returns `true` if there is a value for `key`.
+    bool contains(const std::string& key) const noexcept
+    {
+        return find(key) != nullptr;
+    }
+
+    /// Sets the value of `key` to `value`. Copies of `*this` are not
+    /// affected.
+    /// \returns `true` if the key was inserted, `false` if it was assigned.
+    /// \throws std::bad_alloc. Strong exception guarantee.
+    bool insert_or_assign(std::string key, boost::any value)
+    {
+        const std::size_t hash = Hash()(key);
+        detail::hamt_leaf_ptr leaf = std::make_shared<const detail::hamt_leaf>(std::move(key), hash, std::move(value));
+
+        bool added = false;
+        root = detail::hamt_insert(root.get(), std::move(leaf), 0, added);
+        if (added) {
+            ++count;
+        }
+        return added;
+    }
+
+    /// Removes the value of `key`. Copies of `*this` are not affected.
+    /// \returns `true` if the key was removed.
+    /// \throws std::bad_alloc. Strong exception guarantee.
+    bool erase(const std::string& key)
+    {
+        if (!root) {
+            return false;
+        }
+
+        bool removed = false;
+        detail::hamt_node_ptr result = detail::hamt_erase(root, key, Hash()(key), 0, removed);
+        if (!removed) {
+            return false;
+        }
+
+        if (--count) {
+            root = std::move(result);
+        } else {
+            root.reset();
+        }
+        return true;
+    }
+
+    /// Calls `f(const std::string& key, const boost::any& value)` for each
+    /// entry, in an unspecified order.
+    template <class F>
+    void for_each(F f) const
+    {
+        detail::hamt_for_each(root.get(), f);
+    }
+
+    /// Removes all the entries. Copies of `*this` are not affected.
+    void clear() noexcept
+    {
+        root.reset();
+        count = 0;
+    }
+
+    /// \returns `true` if `*this` and `other` share the whole structure,
+    /// so they are equal without comparing the values.
+    bool shares_with(const basic_persistent_any_map& other) const noexcept
+    {
+        return root == other.root;
+    }
+
+    /// Exchanges the content of `*this` and `rhs`.
+    /// \throws Nothing.
+    void swap(basic_persistent_any_map& rhs) noexcept
+    {
+        root.swap(rhs.root);
+        std::swap(count, rhs.count);
+    }
+
+private:
+    /// @cond
+    detail::hamt_node_ptr root;
+    std::size_t count;
+    /// @endcond
+};
+
+/// Exchanges the content of `lhs` and `rhs`.
+/// \throws Nothing.
+template <class Hash>
+void swap(basic_persistent_any_map<Hash>& lhs, basic_persistent_any_map<Hash>& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+/// boost::anys::basic_persistent_any_map with `std::hash<std::string>`.
+using persistent_any_map = basic_persistent_any_map<>;
+
+BOOST_ANY_END_MODULE_EXPORT
+
+} // namespace anys
+
+} // namespace boost
+
+#endif  // #if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+#endif // #ifndef BOOST_ANYS_PERSISTENT_ANY_MAP_HPP_INCLUDED
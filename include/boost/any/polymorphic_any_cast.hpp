@@ -0,0 +1,259 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/any for Documentation.
+
+#ifndef BOOST_ANYS_POLYMORPHIC_ANY_CAST_HPP_INCLUDED
+#define BOOST_ANYS_POLYMORPHIC_ANY_CAST_HPP_INCLUDED
+
+#include <boost/any/detail/config.hpp>
+
+#if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+/// \file boost/any/polymorphic_any_cast.hpp
+/// \brief Casts of boost::any, boost::anys::basic_any and
+/// boost::anys::unique_any to a base class of the stored value.
+
+#ifndef BOOST_ANY_INTERFACE_UNIT
+#include <boost/config.hpp>
+#ifdef BOOST_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include <cstddef>
+#include <limits>
+#include <memory>  // for std::addressof
+#include <type_traits>
+#include <unordered_map>
+
+#include <boost/throw_exception.hpp>
+#include <boost/type_index.hpp>
+#endif  // #ifndef BOOST_ANY_INTERFACE_UNIT
+
+#include <boost/any.hpp>
+#include <boost/any/basic_any.hpp>
+#include <boost/any/unique_any.hpp>
+#include <boost/any/detail/placeholder.hpp>
+
+namespace boost {
+
+namespace anys {
+
+/// @cond
+namespace detail {
+
+    constexpr std::ptrdiff_t not_a_base = (std::numeric_limits<std::ptrdiff_t>::min)();
+
+    // The hooks that throw the stored pointer are compiled into the anys
+    // only on request
+    template <class Base>
+    struct polymorphic_cast_enabled
+#ifdef BOOST_ANY_USE_POLYMORPHIC_CAST
+        : std::true_type
+#else
+        : std::false_type
+#endif
+    {};
+
+#if defined(BOOST_ANY_USE_POLYMORPHIC_CAST) && !defined(BOOST_NO_EXCEPTIONS)
+    struct placeholder_thrower {
+        const placeholder* content;
+        void operator()() const { content->throw_address(); }
+    };
+
+    template <std::size_t Size, std::size_t Alignment>
+    struct basic_any_thrower {
+        basic_any<Size, Alignment>* operand;
+        void operator()() const { basic_any_access::throw_address(*operand); }
+    };
+
+    // The only portable way to get the derived-to-base adjustment without
+    // knowing the derived type at compile time is to throw a pointer to the
+    // derived type and to catch it as a pointer to the base. That is slow,
+    // so the result is cached by the callers.
+    template <class Base, class Thrower>
+    std::ptrdiff_t base_offset(const void* address, const Thrower& thrower) noexcept
+    {
+        try {
+            thrower();
+        } catch (Base* base) {
+            return static_cast<const char*>(static_cast<const void*>(base))
+                - static_cast<const char*>(address);
+        } catch (...) {
+        }
+        return not_a_base;
+    }
+#else
+    struct placeholder_thrower {
+        const placeholder* content;
+    };
+
+    template <std::size_t Size, std::size_t Alignment>
+    struct basic_any_thrower {
+        basic_any<Size, Alignment>* operand;
+    };
+
+    // Derived-to-base conversions are detected via exceptions,
+    // only the exact type matches without them.
+    template <class Base, class Thrower>
+    std::ptrdiff_t base_offset(const void*, const Thrower&) noexcept
+    {
+        return not_a_base;
+    }
+#endif
+
+    struct type_index_hash {
+        std::size_t operator()(const boost::typeindex::type_index& key) const noexcept {
+            return key.hash_code();
+        }
+    };
+
+    // `address` is the address that the offset is computed from. For the same
+    // stored type in the same `Any` type the offset from it to the base
+    // subobject shall not change.
+    template <class Base, class Any, class Thrower>
+    Base* polymorphic_cast(const boost::typeindex::type_info& stored, void* address, const Thrower& thrower)
+    {
+        static_assert(
+            polymorphic_cast_enabled<Base>::value,
+            "boost::anys::polymorphic_any_cast requires BOOST_ANY_USE_POLYMORPHIC_CAST "
+            "to be defined in all the translation units"
+        );
+
+        using base_t = typename std::remove_cv<Base>::type;
+        using cache_t = std::unordered_map<boost::typeindex::type_index, std::ptrdiff_t, type_index_hash>;
+
+        // Offset is the same for all the instances of the stored type, so it
+        // is computed once per thread for each (stored type, base type) pair.
+        static thread_local cache_t cache;
+
+        const boost::typeindex::type_index key(stored);
+        auto it = cache.find(key);
+        if (it == cache.end()) {
+            it = cache.emplace(key, detail::base_offset<base_t>(address, thrower)).first;
+        }
+
+        return it->second == not_a_base
+            ? nullptr
+            : static_cast<Base*>(static_cast<void*>(static_cast<char*>(address) + it->second));
+    }
+
+    template <class Base, class Any>
+    Base* polymorphic_cast(const placeholder* content)
+    {
+        return content
+            ? detail::polymorphic_cast<Base, Any>(content->type(), const_cast<placeholder*>(content), placeholder_thrower{content})
+            : nullptr;
+    }
+
+} // namespace detail
+/// @endcond
+
+BOOST_ANY_BEGIN_MODULE_EXPORT
+
+/// \returns Pointer to the `Base` subobject of the value stored in `operand`,
+/// nullptr if `operand` is empty or the stored value has no unambiguous public
+/// base class `Base` (and is not of type `Base`).
+///
+/// Values of type `Base` are handled as in boost::any_cast. The
+/// derived-to-base adjustment is resolved once per stored type and `Base`
+/// type and is cached in a thread local hash table, so the subsequent casts
+/// cost a hash table lookup.
+///
+/// Opt-in: `BOOST_ANY_USE_POLYMORPHIC_CAST` shall be defined in all the
+/// translation units of the program. Otherwise the anys do not emit the code
+/// that is needed to find the base, a throw site per stored type, and the
+/// function does not compile.
+///
+/// \throws std::bad_alloc if the cache could not be updated.
+/// \note If exceptions are disabled only the exact `Base` type matches.
+template <class Base>
+Base* polymorphic_any_cast(boost::any* operand)
+{
+    Base* exact = boost::any_cast<Base>(operand);
+    return exact ? exact : detail::polymorphic_cast<Base, boost::any>(operand ? detail::placeholder_access::content(*operand) : nullptr);
+}
+
+/// \copydoc boost::anys::polymorphic_any_cast(boost::any*)
+template <class Base>
+inline const Base* polymorphic_any_cast(const boost::any* operand)
+{
+    return anys::polymorphic_any_cast<Base>(const_cast<boost::any*>(operand));
+}
+
+/// \copydoc boost::anys::polymorphic_any_cast(boost::any*)
+template <class Base>
+Base* polymorphic_any_cast(unique_any* operand)
+{
+    Base* exact = anys::any_cast<Base>(operand);
+    return exact ? exact : detail::polymorphic_cast<Base, unique_any>(operand ? detail::placeholder_access::content(*operand) : nullptr);
+}
+
+/// \copydoc boost::anys::polymorphic_any_cast(boost::any*)
+template <class Base>
+inline const Base* polymorphic_any_cast(const unique_any* operand)
+{
+    return anys::polymorphic_any_cast<Base>(const_cast<unique_any*>(operand));
+}
+
+/// \copydoc boost::anys::polymorphic_any_cast(boost::any*)
+template <class Base, std::size_t OptimizeForSize, std::size_t OptimizeForAlignment>
+Base* polymorphic_any_cast(basic_any<OptimizeForSize, OptimizeForAlignment>* operand)
+{
+    Base* exact = operand ? anys::any_cast<Base>(operand) : nullptr;
+    if (exact) {
+        return exact;
+    }
+
+    void* address = operand ? detail::basic_any_access::address(*operand) : nullptr;
+    return address
+        ? detail::polymorphic_cast<Base, basic_any<OptimizeForSize, OptimizeForAlignment> >(
+            operand->type(), address, detail::basic_any_thrower<OptimizeForSize, OptimizeForAlignment>{operand}
+        )
+        : nullptr;
+}
+
+/// \copydoc boost::anys::polymorphic_any_cast(boost::any*)
+template <class Base, std::size_t OptimizeForSize, std::size_t OptimizeForAlignment>
+inline const Base* polymorphic_any_cast(const basic_any<OptimizeForSize, OptimizeForAlignment>* operand)
+{
+    return anys::polymorphic_any_cast<Base>(const_cast<basic_any<OptimizeForSize, OptimizeForAlignment>*>(operand));
+}
+
+/// \returns Reference to the `Base` subobject of the value stored in `operand`.
+/// \throws boost::bad_any_cast if `operand` is empty or the stored value has
+/// no unambiguous public base class `Base` (and is not of type `Base`).
+template <class Base, class Any>
+typename std::conditional<std::is_const<Any>::value, const Base, Base>::type& polymorphic_any_cast(Any& operand)
+{
+    static_assert(
+        detail::is_some_any<typename std::remove_cv<Any>::type>::value,
+        "boost::anys::polymorphic_any_cast shall be used with boost::any, "
+        "boost::anys::basic_any or boost::anys::unique_any"
+    );
+
+    auto* result = anys::polymorphic_any_cast<Base>(std::addressof(operand));
+    if (!result)
+        detail::throw_bad_any_cast();
+
+    return *result;
+}
+
+BOOST_ANY_END_MODULE_EXPORT
+
+} // namespace anys
+
+BOOST_ANY_BEGIN_MODULE_EXPORT
+
+using boost::anys::polymorphic_any_cast;
+
+BOOST_ANY_END_MODULE_EXPORT
+
+} // namespace boost
+
+#endif  // #if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+#endif // #ifndef BOOST_ANYS_POLYMORPHIC_ANY_CAST_HPP_INCLUDED
@@ -0,0 +1,287 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/any for Documentation.
+
+#ifndef BOOST_ANYS_POOLED_ALLOCATION_HPP_INCLUDED
+#define BOOST_ANYS_POOLED_ALLOCATION_HPP_INCLUDED
+
+#include <boost/any/detail/config.hpp>
+
+#if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+/// \file boost/any/pooled_allocation.hpp
+/// \brief \copybrief boost::anys::use_pooled_allocation
+
+#ifndef BOOST_ANY_INTERFACE_UNIT
+#include <boost/config.hpp>
+#ifdef BOOST_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#endif  // #ifndef BOOST_ANY_INTERFACE_UNIT
+
+#include <boost/any/detail/allocation.hpp>
+
+namespace boost {
+
+namespace anys {
+
+/// @cond
+namespace detail {
+
+    // Every pooled block starts with the header, so the deallocation does
+    // not need the size and knows the owning thread cache.
+    struct pool_cache;
+
+    struct alignas(std::max_align_t) pool_header {
+        pool_cache* owner;
+        std::size_t size_class;
+    };
+
+    struct pool_free_block {
+        pool_free_block* next;
+    };
+
+    constexpr std::size_t pool_size_classes = 5;
+    constexpr std::size_t pool_max_size = 256;
+    constexpr std::size_t pool_no_class = pool_size_classes;
+
+    // Blocks kept per size class; the rest go back to the global heap
+    constexpr std::size_t pool_max_cached = 1024;
+
+    // 16, 32, 64, 128, 256
+    inline std::size_t pool_size_class(std::size_t size) noexcept
+    {
+        std::size_t size_class = 0;
+        std::size_t class_size = 16;
+        while (class_size < size) {
+            class_size *= 2;
+            ++size_class;
+        }
+        return size_class;
+    }
+
+    constexpr std::size_t pool_class_size(std::size_t size_class) noexcept
+    {
+        return std::size_t(16) << size_class;
+    }
+
+    // Caches are never freed. The cache of an exited thread is adopted by a
+    // new thread, blocks that other threads free meanwhile wait for it in
+    // the remote list.
+    struct pool_cache {
+        pool_free_block* free[pool_size_classes];
+        std::size_t cached[pool_size_classes];
+        std::atomic<pool_free_block*> remote[pool_size_classes];
+        std::atomic<bool> active;
+        pool_cache* next;
+
+        void push_local(pool_header* header) noexcept
+        {
+            const std::size_t c = header->size_class;
+            if (cached[c] >= pool_max_cached) {
+                ::operator delete(header);
+                return;
+            }
+
+            pool_free_block* const block = reinterpret_cast<pool_free_block*>(header);
+            block->next = free[c];
+            free[c] = block;
+            ++cached[c];
+        }
+
+        void push_remote(pool_header* header) noexcept
+        {
+            std::atomic<pool_free_block*>& list = remote[header->size_class];
+            pool_free_block* const block = reinterpret_cast<pool_free_block*>(header);
+            block->next = list.load(std::memory_order_relaxed);
+            while (!list.compare_exchange_weak(block->next, block, std::memory_order_release, std::memory_order_relaxed)) {}
+        }
+
+        // Only the owner pops, and it takes the whole list at once, so
+        // there is no ABA problem
+        pool_header* pop(std::size_t c) noexcept
+        {
+            if (!free[c]) {
+                free[c] = remote[c].exchange(nullptr, std::memory_order_acquire);
+                if (!free[c]) {
+                    return nullptr;
+                }
+                std::size_t count = 0;
+                for (pool_free_block* b = free[c]; b; b = b->next) {
+                    ++count;
+                }
+                cached[c] = count;
+            }
+
+            pool_free_block* const block = free[c];
+            free[c] = block->next;
+            --cached[c];
+            return reinterpret_cast<pool_header*>(block);
+        }
+
+        void release_local() noexcept
+        {
+            for (std::size_t c = 0; c < pool_size_classes; ++c) {
+                while (free[c]) {
+                    pool_free_block* const block = free[c];
+                    free[c] = block->next;
+                    ::operator delete(block);
+                }
+                cached[c] = 0;
+            }
+        }
+    };
+
+    class pool_registry {
+    public:
+        static pool_registry& instance() noexcept
+        {
+            static pool_registry registry;
+            return registry;
+        }
+
+        pool_cache* acquire()
+        {
+            for (pool_cache* c = caches.load(std::memory_order_acquire); c; c = c->next) {
+                bool expected = false;
+                if (!c->active.load(std::memory_order_relaxed)
+                    && c->active.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+                {
+                    return c;
+                }
+            }
+
+            pool_cache* const c = new pool_cache;
+            for (std::size_t i = 0; i < pool_size_classes; ++i) {
+                c->free[i] = nullptr;
+                c->cached[i] = 0;
+                c->remote[i].store(nullptr, std::memory_order_relaxed);
+            }
+            c->active.store(true, std::memory_order_relaxed);
+            c->next = caches.load(std::memory_order_relaxed);
+            while (!caches.compare_exchange_weak(c->next, c, std::memory_order_acq_rel)) {}
+            return c;
+        }
+
+    private:
+        pool_registry() noexcept
+          : caches(nullptr)
+        {}
+
+        std::atomic<pool_cache*> caches;
+    };
+
+    // The pointer and the state are trivially destructible, so they stay
+    // usable while the thread local objects and the statics are destroyed
+    enum class pool_state { uninitialized, active, destroyed };
+
+    inline pool_cache*& pool_current() noexcept
+    {
+        static thread_local pool_cache* current = nullptr;
+        return current;
+    }
+
+    inline pool_state& pool_current_state() noexcept
+    {
+        static thread_local pool_state state = pool_state::uninitialized;
+        return state;
+    }
+
+    struct pool_cache_owner {
+        pool_cache* cache;
+
+        pool_cache_owner()
+          : cache(pool_registry::instance().acquire())
+        {
+            pool_current() = cache;
+            pool_current_state() = pool_state::active;
+        }
+
+        ~pool_cache_owner()
+        {
+            pool_current() = nullptr;
+            pool_current_state() = pool_state::destroyed;
+            cache->release_local();
+            cache->active.store(false, std::memory_order_release);
+        }
+    };
+
+    // Cache of the calling thread, nullptr if the thread is exiting
+    inline pool_cache* pool_this_thread()
+    {
+        pool_cache* const cache = pool_current();
+        if (cache || pool_current_state() == pool_state::destroyed) {
+            return cache;
+        }
+
+        static thread_local pool_cache_owner owner;
+        return owner.cache;
+    }
+
+    inline void* pool_allocate(std::size_t size)
+    {
+        pool_cache* const cache = size <= pool_max_size ? detail::pool_this_thread() : nullptr;
+        if (!cache) {
+            pool_header* const header = static_cast<pool_header*>(::operator new(sizeof(pool_header) + size));
+            header->owner = nullptr;
+            header->size_class = pool_no_class;
+            return header + 1;
+        }
+
+        const std::size_t c = detail::pool_size_class(size);
+        pool_header* header = cache->pop(c);
+        if (!header) {
+            header = static_cast<pool_header*>(::operator new(sizeof(pool_header) + detail::pool_class_size(c)));
+        }
+
+        // The free list link of a cached block overwrote the header
+        header->owner = cache;
+        header->size_class = c;
+        return header + 1;
+    }
+
+    inline void pool_deallocate(void* p) noexcept
+    {
+        pool_header* const header = static_cast<pool_header*>(p) - 1;
+        pool_cache* const owner = header->owner;
+        if (!owner) {
+            ::operator delete(header);
+        } else if (owner == pool_current()) {
+            owner->push_local(header);
+        } else {
+            owner->push_remote(header);
+        }
+    }
+
+    // Definition of the hooks declared in boost/any/detail/allocation.hpp
+    template <class ValueType>
+    struct pool_allocator {
+        static void* allocate(std::size_t size)
+        {
+            return detail::pool_allocate(size);
+        }
+
+        static void deallocate(void* p) noexcept
+        {
+            detail::pool_deallocate(p);
+        }
+    };
+
+} // namespace detail
+/// @endcond
+
+} // namespace anys
+
+} // namespace boost
+
+#endif  // #if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+#endif // #ifndef BOOST_ANYS_POOLED_ALLOCATION_HPP_INCLUDED
@@ -0,0 +1,219 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/any for Documentation.
+
+#ifndef BOOST_ANYS_TRY_ANY_CAST_HPP_INCLUDED
+#define BOOST_ANYS_TRY_ANY_CAST_HPP_INCLUDED
+
+#include <boost/any/detail/config.hpp>
+
+#if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+/// \file boost/any/try_any_cast.hpp
+/// \brief Casts that report a failure without exceptions.
+
+#ifndef BOOST_ANY_INTERFACE_UNIT
+#include <boost/config.hpp>
+#ifdef BOOST_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include <memory>  // for std::addressof
+#include <type_traits>
+#include <utility>
+#endif  // #ifndef BOOST_ANY_INTERFACE_UNIT
+
+#include <boost/any.hpp>
+#include <boost/any/bad_any_cast.hpp>
+#include <boost/any/basic_any.hpp>
+#include <boost/any/unique_any.hpp>
+#include <boost/any/fwd.hpp>
+
+namespace boost {
+
+namespace anys {
+
+/// @cond
+namespace detail {
+
+    template <class Any>
+    bool holds_nothing(const Any& operand) noexcept
+    {
+        return operand.empty();
+    }
+
+    inline bool holds_nothing(const unique_any& operand) noexcept
+    {
+        return !operand.has_value();
+    }
+
+} // namespace detail
+/// @endcond
+
+BOOST_ANY_BEGIN_MODULE_EXPORT
+
+/// Reason of a failed boost::anys::try_any_cast.
+enum class any_cast_error {
+    /// The operand holds no value.
+    empty = 1,
+
+    /// The operand holds a value of another type.
+    type_mismatch
+};
+
+/// The result of boost::anys::try_any_cast: a reference to the held value of
+/// type `ValueType` or a boost::anys::any_cast_error.
+///
+/// Works as `expected<ValueType&, any_cast_error>` and is as cheap to return
+/// as a pointer.
+template <class ValueType>
+class any_cast_result {
+public:
+    using value_type = ValueType;
+    using error_type = any_cast_error;
+
+    /// Constructs the result that refers to `value`.
+    explicit any_cast_result(ValueType& value) noexcept
+      : value_ptr(std::addressof(value))
+      , error_code()
+    {}
+
+    /// Constructs the failed result.
+    explicit any_cast_result(any_cast_error error) noexcept
+      : value_ptr(nullptr)
+      , error_code(error)
+    {}
+
+    /// \returns true if the cast succeeded.
+    bool has_value() const noexcept { return value_ptr != nullptr; }
+
+    /// \returns true if the cast succeeded.
+    explicit operator bool() const noexcept { return has_value(); }
+
+    /// \returns Reference to the held value.
+    /// \throws boost::bad_any_cast if the cast failed.
+    ValueType& value() const
+    {
+        if (!value_ptr) {
+            detail::throw_bad_any_cast();
+        }
+        return *value_ptr;
+    }
+
+    /// \returns Copy of the held value if the cast succeeded, `default_value`
+    /// converted to `ValueType` otherwise.
+    template <class U>
+    typename std::remove_cv<ValueType>::type value_or(U&& default_value) const
+    {
+        return value_ptr
+            ? *value_ptr
+            : static_cast<typename std::remove_cv<ValueType>::type>(std::forward<U>(default_value));
+    }
+
+    /// \returns Reason of the failure.
+    /// \pre `!has_value()`
+    any_cast_error error() const noexcept { return error_code; }
+
+    /// \returns Reference to the held value.
+    /// \pre `has_value()`
+    ValueType& operator*() const noexcept { return *value_ptr; }
+
+    /// \returns Pointer to the held value.
+    /// \pre `has_value()`
+    ValueType* operator->() const noexcept { return value_ptr; }
+
+private:
+    ValueType* value_ptr;
+    any_cast_error error_code;
+};
+
+/// \returns boost::anys::any_cast_result that refers to the `ValueType`
+/// value stored in `operand`, or holds the reason of the failure.
+///
+/// Works with boost::any, boost::anys::basic_any, boost::anys::unique_any and
+/// other any types of this library. Never throws and does not require
+/// exceptions to be enabled, so it suits code that probes the stored type
+/// speculatively.
+///
+/// \throws Nothing.
+template <class ValueType, class Any>
+any_cast_result<typename std::conditional<
+    std::is_const<Any>::value,
+    const typename std::remove_reference<ValueType>::type,
+    typename std::remove_reference<ValueType>::type
+>::type> try_any_cast(Any& operand) noexcept
+{
+    static_assert(
+        detail::is_some_any<typename std::remove_cv<Any>::type>::value,
+        "boost::anys::try_any_cast shall be used with any type from the Boost.Any library"
+    );
+    using nonref = typename std::remove_reference<ValueType>::type;
+    using result_t = any_cast_result<typename std::conditional<
+        std::is_const<Any>::value, const nonref, nonref
+    >::type>;
+
+    auto* result = any_cast<nonref>(std::addressof(operand));
+    if (result) {
+        return result_t(*result);
+    }
+    return result_t(detail::holds_nothing(operand) ? any_cast_error::empty : any_cast_error::type_mismatch);
+}
+
+/// \returns `ValueType` stored in `operand` if `operand` contains
+/// the `ValueType`, `default_value` converted to `ValueType` otherwise.
+///
+/// If `operand` is a non-const rvalue, the stored value is moved out and
+/// the `operand` is not cleared.
+///
+/// Works with boost::any, boost::anys::basic_any, boost::anys::unique_any and
+/// other any types of this library.
+///
+/// \throws Nothing on type mismatch. Any exceptions arising from the copy or
+/// move constructor of `ValueType`.
+template <class ValueType, class Any, class U>
+ValueType any_cast_or(Any&& operand, U&& default_value)
+{
+    using any_t = typename std::remove_reference<Any>::type;
+    static_assert(
+        detail::is_some_any<typename std::remove_cv<any_t>::type>::value,
+        "boost::anys::any_cast_or shall be used with any type from the Boost.Any library"
+    );
+    static_assert(
+        !std::is_reference<ValueType>::value,
+        "boost::anys::any_cast_or returns a value, use boost::anys::try_any_cast to get a reference"
+    );
+
+    using nonref = typename std::remove_cv<ValueType>::type;
+    using stored_ref = typename std::conditional<
+        std::is_lvalue_reference<Any>::value || std::is_const<any_t>::value,
+        const nonref&,
+        nonref&&
+    >::type;
+
+    auto* result = any_cast<nonref>(std::addressof(operand));
+    if (result) {
+        return static_cast<stored_ref>(*result);
+    }
+    return static_cast<nonref>(std::forward<U>(default_value));
+}
+
+BOOST_ANY_END_MODULE_EXPORT
+
+} // namespace anys
+
+BOOST_ANY_BEGIN_MODULE_EXPORT
+
+using boost::anys::try_any_cast;
+using boost::anys::any_cast_or;
+
+BOOST_ANY_END_MODULE_EXPORT
+
+} // namespace boost
+
+#endif  // #if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+#endif // #ifndef BOOST_ANYS_TRY_ANY_CAST_HPP_INCLUDED
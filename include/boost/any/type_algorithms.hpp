@@ -0,0 +1,186 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/any for Documentation.
+
+#ifndef BOOST_ANYS_TYPE_ALGORITHMS_HPP_INCLUDED
+#define BOOST_ANYS_TYPE_ALGORITHMS_HPP_INCLUDED
+
+#include <boost/any/detail/config.hpp>
+
+#if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+/// \file boost/any/type_algorithms.hpp
+/// \brief Algorithms that look for the stored type in ranges of
+/// boost::anys::basic_any.
+
+#ifndef BOOST_ANY_INTERFACE_UNIT
+#include <boost/config.hpp>
+#ifdef BOOST_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#endif  // #ifndef BOOST_ANY_INTERFACE_UNIT
+
+#include <boost/any/basic_any.hpp>
+
+namespace boost {
+
+namespace anys {
+
+/// @cond
+namespace detail {
+
+    template <class ValueType, std::size_t Size, std::size_t Alignment>
+    auto identity_for(const basic_any<Size, Alignment>&) noexcept
+        -> decltype(basic_any_access::identity_of<typename std::remove_cv<ValueType>::type, Size, Alignment>())
+    {
+        return basic_any_access::identity_of<typename std::remove_cv<ValueType>::type, Size, Alignment>();
+    }
+
+    // Compares the manager of an element with the manager for `ValueType`,
+    // the manager is the type identity of basic_any.
+    template <class Manager>
+    struct same_identity {
+        Manager manager;
+
+        template <std::size_t Size, std::size_t Alignment>
+        bool operator()(const basic_any<Size, Alignment>& operand) const noexcept
+        {
+            return basic_any_access::identity(operand) == manager;
+        }
+    };
+
+    template <class ValueType, class Iterator>
+    auto same_identity_for(Iterator first) noexcept
+        -> same_identity<decltype(detail::identity_for<ValueType>(*first))>
+    {
+        return {detail::identity_for<ValueType>(*first)};
+    }
+
+    template <class Iterator, class Predicate>
+    Iterator find_identity(Iterator first, Iterator last, Predicate same, std::input_iterator_tag)
+    {
+        for (; first != last; ++first) {
+            if (same(*first)) {
+                break;
+            }
+        }
+        return first;
+    }
+
+    // The identity words are strided by the size of basic_any, so instead
+    // of vector compares the loop is unrolled to keep several independent
+    // loads in flight and to test a single branch per 4 elements.
+    template <class Iterator, class Predicate>
+    Iterator find_identity(Iterator first, Iterator last, Predicate same, std::random_access_iterator_tag)
+    {
+        for (auto blocks = (last - first) / 4; blocks; --blocks, first += 4) {
+            if (same(first[0]) | same(first[1]) | same(first[2]) | same(first[3])) {
+                break;
+            }
+        }
+        return detail::find_identity(first, last, same, std::input_iterator_tag());
+    }
+
+    template <class Iterator, class Predicate>
+    std::size_t count_identity(Iterator first, Iterator last, Predicate same, std::input_iterator_tag)
+    {
+        std::size_t count = 0;
+        for (; first != last; ++first) {
+            count += same(*first);
+        }
+        return count;
+    }
+
+    template <class Iterator, class Predicate>
+    std::size_t count_identity(Iterator first, Iterator last, Predicate same, std::random_access_iterator_tag)
+    {
+        std::size_t counts[4] = {0, 0, 0, 0};
+        for (auto blocks = (last - first) / 4; blocks; --blocks, first += 4) {
+            counts[0] += same(first[0]);
+            counts[1] += same(first[1]);
+            counts[2] += same(first[2]);
+            counts[3] += same(first[3]);
+        }
+        return counts[0] + counts[1] + counts[2] + counts[3]
+            + detail::count_identity(first, last, same, std::input_iterator_tag());
+    }
+
+} // namespace detail
+/// @endcond
+
+BOOST_ANY_BEGIN_MODULE_EXPORT
+
+/// \returns Iterator to the first element of [`first`, `last`) that holds
+/// a `ValueType`, `last` if there is no such element.
+///
+/// Unlike the boost::any_cast per element, compares the type identities
+/// stored in the elements without calling into the stored type.
+///
+/// `Iterator` shall dereference to boost::anys::basic_any.
+template <class ValueType, class Iterator>
+Iterator find_type(Iterator first, Iterator last)
+{
+    if (first == last) {
+        return last;
+    }
+    return detail::find_identity(
+        first, last,
+        detail::same_identity_for<ValueType>(first),
+        typename std::iterator_traits<Iterator>::iterator_category()
+    );
+}
+
+/// \returns Count of the elements of [`first`, `last`) that hold
+/// a `ValueType`.
+///
+/// Unlike the boost::any_cast per element, compares the type identities
+/// stored in the elements without calling into the stored type.
+///
+/// `Iterator` shall dereference to boost::anys::basic_any.
+template <class ValueType, class Iterator>
+std::size_t count_type(Iterator first, Iterator last)
+{
+    if (first == last) {
+        return 0;
+    }
+    return detail::count_identity(
+        first, last,
+        detail::same_identity_for<ValueType>(first),
+        typename std::iterator_traits<Iterator>::iterator_category()
+    );
+}
+
+/// Reorders the elements of [`first`, `last`) so that the elements that hold
+/// a `ValueType` precede the other elements. Relative order of the elements
+/// is not preserved. Elements are swapped, the values are not moved.
+///
+/// \returns Iterator to the first element that does not hold a `ValueType`.
+///
+/// `Iterator` shall dereference to boost::anys::basic_any.
+template <class ValueType, class Iterator>
+Iterator partition_by_type(Iterator first, Iterator last)
+{
+    if (first == last) {
+        return last;
+    }
+    return std::partition(first, last, detail::same_identity_for<ValueType>(first));
+}
+
+BOOST_ANY_END_MODULE_EXPORT
+
+} // namespace anys
+
+} // namespace boost
+
+#endif  // #if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+#endif // #ifndef BOOST_ANYS_TYPE_ALGORITHMS_HPP_INCLUDED
@@ -0,0 +1,259 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/any for Documentation.
+
+#ifndef BOOST_ANYS_TYPE_MAP_HPP_INCLUDED
+#define BOOST_ANYS_TYPE_MAP_HPP_INCLUDED
+
+#include <boost/any/detail/config.hpp>
+
+#if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+/// \file boost/any/type_map.hpp
+/// \brief \copybrief boost::anys::type_map
+
+#ifndef BOOST_ANY_INTERFACE_UNIT
+#include <boost/config.hpp>
+#ifdef BOOST_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/type_index.hpp>
+#endif  // #ifndef BOOST_ANY_INTERFACE_UNIT
+
+#include <boost/any/bad_any_cast.hpp>
+#include <boost/any/unique_any.hpp>
+
+namespace boost {
+
+namespace anys {
+
+/// @cond
+namespace detail {
+
+    inline std::size_t next_type_slot() noexcept
+    {
+        static std::atomic<std::size_t> counter{0};
+        return counter.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Index of `T`, assigned on the first use. Each shared library with
+    // hidden symbols has its own copy of the static, so the same type may
+    // get different slots there and different types may share a slot.
+    template <class T>
+    std::size_t type_slot() noexcept
+    {
+        static const std::size_t slot = detail::next_type_slot();
+        return slot;
+    }
+
+} // namespace detail
+/// @endcond
+
+BOOST_ANY_BEGIN_MODULE_EXPORT
+
+/// \brief Container of at most one value per type, a faster replacement
+/// for `std::unordered_map<std::type_index, boost::any>`.
+///
+/// Each type gets a small integer slot on its first use, the values are
+/// kept in a dense array of boost::anys::unique_any indexed by the slot.
+/// So get() is an array access and an unchecked cast: only a `T` is ever
+/// stored in the slot of `T`.
+/// \code
+/// boost::anys::type_map services;
+/// services.emplace<renderer>(window);
+///
+/// // Per frame
+/// if (renderer* r = services.get<renderer>()) {
+///     r->draw();
+/// }
+/// \endcode
+///
+/// Types are the keys as is, without decay: `T` shall be an object type
+/// without cv-qualifiers. Slots are assigned thread safely, but a type_map
+/// object is not safe to modify concurrently. The array grows up to the
+/// largest slot of the stored types, so the memory is proportional to the
+/// count of the types used in the program with any type_map.
+///
+/// Slots are assigned by each module separately if the shared libraries do
+/// not export the inline functions, as with hidden visibility or on Windows.
+/// A type_map shall not be shared between such modules: the same slot may
+/// hold different types there. Debug builds assert on such a mismatch.
+class type_map {
+public:
+    /// \post this->empty() is true.
+    type_map() noexcept
+      : count(0)
+    {}
+
+    /// Takes the values of `other`, leaving it empty.
+    /// \throws Nothing.
+    type_map(type_map&& other) noexcept
+      : values(std::move(other.values))
+      , count(other.count)
+    {
+        other.values.clear();
+        other.count = 0;
+    }
+
+    /// Takes the values of `rhs`, destroying the previous ones.
+    /// \throws Nothing.
+    type_map& operator=(type_map&& rhs) noexcept
+    {
+        type_map(std::move(rhs)).swap(*this);
+        return *this;
+    }
+
+    /// Makes a `T` from `args` as the value for `T`, replacing the previous
+    /// value.
+    /// \returns Reference to the new value.
+    /// \throws std::bad_alloc or any exceptions arising from the
+    /// constructor of `T`. Strong exception guarantee.
+    template <class T, class... Args>
+    T& emplace(Args&&... args)
+    {
+        static_assert_key<T>();
+        const std::size_t slot = detail::type_slot<T>();
+        if (slot >= values.size()) {
+            values.resize(slot + 1);
+        }
+
+        unique_any& value = values[slot];
+        const bool inserted = !value.has_value();
+        T& result = value.emplace<T>(std::forward<Args>(args)...);
+        if (inserted) {
+            ++count;
+        }
+        return result;
+    }
+
+    /// \returns Pointer to the value for `T`, nullptr if there is none.
+    template <class T>
+    T* get() noexcept
+    {
+        static_assert_key<T>();
+        const std::size_t slot = detail::type_slot<T>();
+        if (slot >= values.size() || !values[slot].has_value()) {
+            return nullptr;
+        }
+        BOOST_ASSERT_MSG(
+            values[slot].type() == boost::typeindex::type_id<T>(),
+            "boost::anys::type_map shared between modules with different type slots"
+        );
+        return anys::unsafe_any_cast<T>(&values[slot]);
+    }
+
+    /// \returns Pointer to the value for `T`, nullptr if there is none.
+    template <class T>
+    const T* get() const noexcept
+    {
+        return const_cast<type_map*>(this)->get<T>();
+    }
+
+    /// \returns Reference to the value for `T`.
+    /// \throws boost::bad_any_cast if there is no value for `T`.
+    template <class T>
+    T& at()
+    {
+        T* result = get<T>();
+        if (!result) {
+            detail::throw_bad_any_cast();
+        }
+        return *result;
+    }
+
+    /// \returns Reference to the value for `T`.
+    /// \throws boost::bad_any_cast if there is no value for `T`.
+    template <class T>
+    const T& at() const
+    {
+        return const_cast<type_map*>(this)->at<T>();
+    }
+
+    /// \returns `true` if there is a value for `T`.
+    template <class T>
+    bool contains() const noexcept
+    {
+        return get<T>() != nullptr;
+    }
+
+    /// Destroys the value for `T`.
+    /// \returns `true` if there was a value.
+    template <class T>
+    bool erase() noexcept
+    {
+        static_assert_key<T>();
+        const std::size_t slot = detail::type_slot<T>();
+        if (slot >= values.size() || !values[slot].has_value()) {
+            return false;
+        }
+        values[slot].reset();
+        --count;
+        return true;
+    }
+
+    /// \returns Count of the stored values.
+    std::size_t size() const noexcept { return count; }
+
+    /// \returns `true` if there are no values.
+    bool empty() const noexcept { return !count; }
+
+    /// Destroys all the values and frees the memory.
+    void clear() noexcept
+    {
+        std::vector<unique_any>().swap(values);
+        count = 0;
+    }
+
+    /// Exchanges the content of `*this` and `rhs`.
+    /// \throws Nothing.
+    void swap(type_map& rhs) noexcept
+    {
+        values.swap(rhs.values);
+        std::swap(count, rhs.count);
+    }
+
+private:
+    /// @cond
+    template <class T>
+    static void static_assert_key() noexcept
+    {
+        static_assert(
+            std::is_object<T>::value && !std::is_const<T>::value && !std::is_volatile<T>::value,
+            "boost::anys::type_map keys shall be object types without cv-qualifiers"
+        );
+        static_assert(!std::is_array<T>::value, "boost::anys::type_map keys shall not be arrays");
+    }
+
+    std::vector<unique_any> values;
+    std::size_t count;
+    /// @endcond
+};
+
+/// Exchanges the content of `lhs` and `rhs`.
+/// \throws Nothing.
+inline void swap(type_map& lhs, type_map& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+BOOST_ANY_END_MODULE_EXPORT
+
+} // namespace anys
+
+} // namespace boost
+
+#endif  // #if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+#endif // #ifndef BOOST_ANYS_TYPE_MAP_HPP_INCLUDED
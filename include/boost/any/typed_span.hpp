@@ -0,0 +1,101 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/any for Documentation.
+
+#ifndef BOOST_ANYS_TYPED_SPAN_HPP_INCLUDED
+#define BOOST_ANYS_TYPED_SPAN_HPP_INCLUDED
+
+#include <boost/any/detail/config.hpp>
+
+#if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+/// \file boost/any/typed_span.hpp
+/// \brief \copybrief boost::anys::typed_span
+
+#ifndef BOOST_ANY_INTERFACE_UNIT
+#include <boost/config.hpp>
+#ifdef BOOST_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include <cstddef>
+#include <type_traits>
+
+#include <boost/assert.hpp>
+#endif  // #ifndef BOOST_ANY_INTERFACE_UNIT
+
+namespace boost {
+
+namespace anys {
+
+BOOST_ANY_BEGIN_MODULE_EXPORT
+
+/// \brief Non-owning view to a contiguous sequence of `T`.
+///
+/// Returned by the containers of this library that keep the values of the
+/// same type contiguously. Works in C++11, unlike `std::span`.
+template <class T>
+class typed_span {
+public:
+    using element_type = T;
+    using value_type = typename std::remove_cv<T>::type;
+    using size_type = std::size_t;
+    using pointer = T*;
+    using reference = T&;
+    using iterator = T*;
+
+    /// \post this->empty() is true.
+    constexpr typed_span() noexcept
+      : first(nullptr)
+      , count(0)
+    {}
+
+    /// Makes a view to `size` values starting at `data`.
+    constexpr typed_span(T* data, std::size_t size) noexcept
+      : first(data)
+      , count(size)
+    {}
+
+    /// Makes a view to constant values from a view to mutable ones.
+    template <class U>
+    constexpr typed_span(const typed_span<U>& other, typename std::enable_if<
+        std::is_convertible<U(*)[], T(*)[]>::value
+    >::type* = nullptr) noexcept
+      : first(other.data())
+      , count(other.size())
+    {}
+
+    constexpr T* data() const noexcept { return first; }
+    constexpr std::size_t size() const noexcept { return count; }
+    constexpr bool empty() const noexcept { return !count; }
+
+    constexpr T* begin() const noexcept { return first; }
+    constexpr T* end() const noexcept { return first + count; }
+
+    /// \pre `index < this->size()`
+    T& operator[](std::size_t index) const noexcept
+    {
+        BOOST_ASSERT(index < count);
+        return first[index];
+    }
+
+private:
+    /// @cond
+    T* first;
+    std::size_t count;
+    /// @endcond
+};
+
+BOOST_ANY_END_MODULE_EXPORT
+
+} // namespace anys
+
+} // namespace boost
+
+#endif  // #if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+#endif // #ifndef BOOST_ANYS_TYPED_SPAN_HPP_INCLUDED
@@ -32,6 +32,7 @@
 
 #include <boost/any/fwd.hpp>
 #include <boost/any/bad_any_cast.hpp>
+#include <boost/any/detail/allocation.hpp>
 #include <boost/any/detail/placeholder.hpp>
 
 namespace boost { namespace anys {
@@ -233,11 +234,41 @@ private: // types
         {
         }
 
+        static void* operator new(std::size_t size)
+        {
+            return boost::anys::detail::allocate_block<T, holder>(size);
+        }
+
+        static void operator delete(void* p) noexcept
+        {
+            boost::anys::detail::deallocate_block<T, holder>(p);
+        }
+
+#ifdef __cpp_aligned_new
+        // Over-aligned holders are never pooled
+        static void* operator new(std::size_t size, std::align_val_t alignment)
+        {
+            return ::operator new(size, alignment);
+        }
+
+        static void operator delete(void* p, std::align_val_t alignment) noexcept
+        {
+            ::operator delete(p, alignment);
+        }
+#endif
+
         const boost::typeindex::type_info& type() const noexcept override
         {
             return boost::typeindex::type_id<T>().type_info();
         }
 
+#if defined(BOOST_ANY_USE_POLYMORPHIC_CAST) && !defined(BOOST_NO_EXCEPTIONS)
+        void throw_address() const override
+        {
+            throw const_cast<T*>(std::addressof(held));
+        }
+#endif
+
     public:
         T held;
     };
@@ -246,6 +277,8 @@ private: // representation
     template<typename T>
     friend T * unsafe_any_cast(unique_any *) noexcept;
 
+    friend struct boost::anys::detail::placeholder_access;
+
     std::unique_ptr<boost::anys::detail::placeholder> content;
     /// @endcond
 };
@@ -306,7 +339,7 @@ T any_cast(unique_any & operand)
 
     nonref * result = anys::any_cast<nonref>(std::addressof(operand));
     if(!result)
-        boost::throw_exception(bad_any_cast());
+        detail::throw_bad_any_cast();
 
     // Attempt to avoid construction of a temporary object in cases when
     // `T` is not a reference. Example:
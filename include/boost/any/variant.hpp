@@ -0,0 +1,239 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/any for Documentation.
+
+#ifndef BOOST_ANYS_VARIANT_HPP_INCLUDED
+#define BOOST_ANYS_VARIANT_HPP_INCLUDED
+
+#include <boost/any/detail/config.hpp>
+
+#if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+/// \file boost/any/variant.hpp
+/// \brief Conversions between boost::anys::basic_any and `std::variant`.
+
+#ifndef BOOST_ANY_INTERFACE_UNIT
+#include <boost/config.hpp>
+#ifdef BOOST_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#ifndef BOOST_NO_CXX17_HDR_VARIANT
+#include <cstdint>
+#include <exception>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include <boost/throw_exception.hpp>
+#endif
+#endif  // #ifndef BOOST_ANY_INTERFACE_UNIT
+
+#include <boost/any/basic_any.hpp>
+
+#ifndef BOOST_NO_CXX17_HDR_VARIANT
+
+namespace boost {
+
+namespace anys {
+
+/// @cond
+namespace detail {
+
+    constexpr std::size_t manager_table_size(std::size_t count) noexcept {
+        std::size_t size = 1;
+        while (size < count * 2) {
+            size *= 2;
+        }
+        return size;
+    }
+
+    // Open addressing table from the basic_any manager of the type to
+    // the index of the type in a std::variant. Built once per conversion
+    // instantiation, so the lookup cost does not depend on the alternatives
+    // count.
+    template <class Manager, std::size_t N>
+    class manager_index_table {
+        static constexpr std::size_t table_size = detail::manager_table_size(N);
+        static constexpr std::size_t mask = table_size - 1;
+
+        static std::size_t hash(Manager man) noexcept {
+            const auto value = reinterpret_cast<std::uintptr_t>(man);
+            return static_cast<std::size_t>((value >> 4) ^ (value >> 12)) & mask;
+        }
+
+    public:
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        explicit manager_index_table(const Manager (&managers)[N]) noexcept
+          : keys(), values()
+        {
+            for (std::size_t i = N; i != 0; --i) {
+                const Manager man = managers[i - 1];
+                std::size_t pos = manager_index_table::hash(man);
+                while (keys[pos] && keys[pos] != man) {
+                    pos = (pos + 1) & mask;
+                }
+                // Iterating backwards makes the first duplicate alternative win
+                keys[pos] = man;
+                values[pos] = i - 1;
+            }
+        }
+
+        std::size_t find(Manager man) const noexcept {
+            std::size_t pos = manager_index_table::hash(man);
+            while (keys[pos]) {
+                if (keys[pos] == man) {
+                    return values[pos];
+                }
+                pos = (pos + 1) & mask;
+            }
+            return npos;
+        }
+
+    private:
+        Manager keys[table_size];
+        std::size_t values[table_size];
+    };
+
+    template <class... Ts>
+    struct monostate_index: std::integral_constant<std::size_t, static_cast<std::size_t>(-1)> {};
+
+    template <class... Ts>
+    struct monostate_index<std::monostate, Ts...>: std::integral_constant<std::size_t, 0> {};
+
+    template <class T, class... Ts>
+    struct monostate_index<T, Ts...>: std::integral_constant<std::size_t,
+        monostate_index<Ts...>::value == static_cast<std::size_t>(-1) ? monostate_index<Ts...>::value : monostate_index<Ts...>::value + 1
+    > {};
+
+    template <std::size_t I, class Variant, std::size_t Size, std::size_t Alignment>
+    Variant relocate_to_variant(basic_any<Size, Alignment>& operand)
+    {
+        using T = std::variant_alternative_t<I, Variant>;
+        // Destroys the moved out value only if the move succeeded
+        struct reset_on_success {
+            basic_any<Size, Alignment>& any;
+            const int exceptions;
+            ~reset_on_success() {
+                if (std::uncaught_exceptions() == exceptions) {
+                    basic_any_access::reset(any);
+                }
+            }
+        } guard{operand, std::uncaught_exceptions()};
+        return Variant(std::in_place_index<I>, std::move(*basic_any_access::get<T>(operand)));
+    }
+
+    template <class Variant, std::size_t Size, std::size_t Alignment, std::size_t... I>
+    Variant to_variant_impl(basic_any<Size, Alignment>& operand, std::index_sequence<I...>)
+    {
+        using manager = decltype(basic_any_access::identity(operand));
+        using converter = Variant(*)(basic_any<Size, Alignment>&);
+
+        static const manager managers[] = {
+            basic_any_access::identity_of<std::variant_alternative_t<I, Variant>, Size, Alignment>()...
+        };
+        static const manager_index_table<manager, sizeof...(I)> table(managers);
+        static const converter converters[] = {
+            &detail::relocate_to_variant<I, Variant, Size, Alignment>...
+        };
+
+        const std::size_t index = table.find(basic_any_access::identity(operand));
+        if (index == table.npos) {
+            detail::throw_bad_any_cast();
+        }
+        return converters[index](operand);
+    }
+
+    template <class Any>
+    struct to_any_visitor {
+        template <class T>
+        Any operator()(T&& value) const
+        {
+            return Any(std::forward<T>(value));
+        }
+
+        Any operator()(std::monostate) const noexcept
+        {
+            return Any();
+        }
+    };
+
+} // namespace detail
+/// @endcond
+
+BOOST_ANY_BEGIN_MODULE_EXPORT
+
+/// Moves the content of `operand` into a `std::variant<Ts...>`,
+/// leaving the `operand` empty.
+///
+/// The alternative is found by a single lookup of the stored type identity
+/// in a precomputed table, the cost does not depend on `sizeof...(Ts)`.
+/// The value is move constructed right in the resulting variant.
+///
+/// An empty `operand` is converted into `std::monostate` if it is one of
+/// the `Ts...`.
+///
+/// \throws boost::bad_any_cast if `operand` does not contain any of the
+/// `Ts...` or any exceptions arising from the move constructor of the
+/// contained type.
+template <class... Ts, std::size_t OptimizeForSize, std::size_t OptimizeForAlignment>
+std::variant<Ts...> to_variant(basic_any<OptimizeForSize, OptimizeForAlignment>&& operand)
+{
+    using variant_t = std::variant<Ts...>;
+    constexpr std::size_t monostate_pos = detail::monostate_index<Ts...>::value;
+
+    if (operand.empty()) {
+        if constexpr (monostate_pos != static_cast<std::size_t>(-1)) {
+            return variant_t(std::in_place_index<monostate_pos>);
+        } else {
+            detail::throw_bad_any_cast();
+        }
+    }
+
+    return detail::to_variant_impl<variant_t>(operand, std::index_sequence_for<Ts...>());
+}
+
+/// \returns `Any` that holds the moved alternative of `value`, or an empty
+/// `Any` if `value` holds `std::monostate`.
+///
+/// The alternative is moved right into the result, without intermediate
+/// temporaries. No dynamic allocation happens if `Any` is a
+/// boost::anys::basic_any and the alternative fits its buffer.
+///
+/// \throws std::bad_variant_access if `value` is valueless by exception,
+/// std::bad_alloc or any exceptions arising from the move constructor of
+/// the contained type.
+template <class Any, class... Ts>
+Any from_variant(std::variant<Ts...>&& value)
+{
+    return std::visit(detail::to_any_visitor<Any>{}, std::move(value));
+}
+
+/// \returns `Any` that holds a copy of the alternative of `value`, or an
+/// empty `Any` if `value` holds `std::monostate`.
+///
+/// \throws std::bad_variant_access if `value` is valueless by exception,
+/// std::bad_alloc or any exceptions arising from the copy constructor of
+/// the contained type.
+template <class Any, class... Ts>
+Any from_variant(const std::variant<Ts...>& value)
+{
+    return std::visit(detail::to_any_visitor<Any>{}, value);
+}
+
+BOOST_ANY_END_MODULE_EXPORT
+
+} // namespace anys
+
+} // namespace boost
+
+#endif  // #ifndef BOOST_NO_CXX17_HDR_VARIANT
+
+#endif  // #if !defined(BOOST_USE_MODULES) || defined(BOOST_ANY_INTERFACE_UNIT)
+
+#endif // #ifndef BOOST_ANYS_VARIANT_HPP_INCLUDED
@@ -16,11 +16,29 @@ module;
 #ifdef BOOST_ANY_USE_STD_MODULE
 import std;
 #else
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <new>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
 #include <typeinfo>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
+#include <variant>
+#include <vector>
 #endif
 
 #define BOOST_ANY_INTERFACE_UNIT
@@ -32,6 +50,33 @@ export module boost.any;
 #endif
 
 #include <boost/any.hpp>
+#include <boost/any/adaptive_any_vector.hpp>
+#include <boost/any/any_block.hpp>
+#include <boost/any/any_cast_range.hpp>
+#include <boost/any/any_context.hpp>
+#include <boost/any/any_dict.hpp>
+#include <boost/any/any_queue.hpp>
+#include <boost/any/any_record.hpp>
+#include <boost/any/any_ref.hpp>
+#include <boost/any/any_segments.hpp>
+#include <boost/any/any_table.hpp>
+#include <boost/any/any_vector.hpp>
+#include <boost/any/atomic_any.hpp>
 #include <boost/any/basic_any.hpp>
+#include <boost/any/basic_any_hinted.hpp>
+#include <boost/any/compact_any.hpp>
+#include <boost/any/concurrent_any_map.hpp>
+#include <boost/any/deferred_destroy.hpp>
+#include <boost/any/event_bus.hpp>
+#include <boost/any/group_by_type.hpp>
+#include <boost/any/parallel.hpp>
+#include <boost/any/persistent_any_map.hpp>
+#include <boost/any/polymorphic_any_cast.hpp>
+#include <boost/any/pooled_allocation.hpp>
+#include <boost/any/try_any_cast.hpp>
+#include <boost/any/type_algorithms.hpp>
+#include <boost/any/type_map.hpp>
+#include <boost/any/typed_span.hpp>
+#include <boost/any/variant.hpp>
 #include <boost/any/unique_any.hpp>
 
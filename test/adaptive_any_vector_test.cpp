@@ -0,0 +1,221 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_ANY_USE_HOLDER_VALUE_OPS
+#include <boost/any/adaptive_any_vector.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+#ifndef BOOST_NO_EXCEPTIONS
+// Allocations left before operator new throws, negative for no limit
+static int allocations_left = -1;
+
+void* operator new(std::size_t size) {
+    if (allocations_left == 0) {
+        throw std::bad_alloc();
+    }
+    if (allocations_left > 0) {
+        --allocations_left;
+    }
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+#endif
+
+namespace {
+
+struct counted {
+    static int instances;
+
+    explicit counted(int v) : value(v) { ++instances; }
+    counted(const counted& other) : value(other.value) { ++instances; }
+    ~counted() { --instances; }
+
+    int value;
+};
+
+int counted::instances = 0;
+
+struct thrower {
+    thrower() { throw std::runtime_error("thrower"); }
+    thrower(const thrower&) = default;
+};
+
+struct alignas(32) over_aligned {
+    int value;
+};
+
+void test_homogeneous() {
+    boost::anys::adaptive_any_vector v;
+    BOOST_TEST(v.empty());
+    BOOST_TEST(v.is_homogeneous());
+    BOOST_TEST(v.homogeneous_span<int>().empty());
+
+    for (int i = 0; i < 100; ++i) {
+        v.push_back(i);
+    }
+    BOOST_TEST_EQ(v.size(), 100u);
+    BOOST_TEST(v.is_homogeneous());
+
+    boost::anys::typed_span<int> values = v.homogeneous_span<int>();
+    BOOST_TEST_EQ(values.size(), 100u);
+    BOOST_TEST_EQ(values[42], 42);
+    BOOST_TEST(v.homogeneous_span<long>().empty());
+
+    BOOST_TEST_EQ(boost::any_cast<int>(v[10]), 10);
+    boost::any_cast<int&>(v[10]) = -10;
+    BOOST_TEST_EQ(values[10], -10);
+    BOOST_TEST_THROWS(boost::any_cast<long>(v[10]), boost::bad_any_cast);
+
+    const boost::anys::adaptive_any_vector& cv = v;
+    BOOST_TEST_EQ(boost::any_cast<int>(cv[99]), 99);
+    BOOST_TEST_EQ(cv.homogeneous_span<int>().size(), 100u);
+
+    boost::anys::basic_any<> a = 100;
+    v.push_back(std::move(a));
+    BOOST_TEST(a.empty());
+    BOOST_TEST(v.is_homogeneous());
+    BOOST_TEST_EQ(v.homogeneous_span<int>()[100], 100);
+}
+
+void test_switch_to_holders() {
+    {
+        boost::anys::adaptive_any_vector v;
+        v.emplace_back<counted>(1);
+        v.emplace_back<counted>(2);
+        BOOST_TEST_EQ(counted::instances, 2);
+
+        std::string& s = v.emplace_back<std::string>("text");
+        BOOST_TEST_EQ(s, "text");
+        BOOST_TEST(!v.is_homogeneous());
+        BOOST_TEST(v.homogeneous_span<counted>().empty());
+        BOOST_TEST_EQ(v.size(), 3u);
+        BOOST_TEST_EQ(counted::instances, 2);
+
+        BOOST_TEST_EQ(boost::any_cast<counted&>(v[0]).value, 1);
+        BOOST_TEST_EQ(boost::any_cast<counted&>(v[1]).value, 2);
+        BOOST_TEST_EQ(boost::any_cast<std::string&>(v[2]), "text");
+
+        v.push_back(over_aligned{7});
+        const over_aligned* p = boost::any_cast<over_aligned>(&static_cast<const boost::anys::any_ref&>(v[3]));
+        BOOST_TEST(p);
+        BOOST_TEST_EQ(reinterpret_cast<std::uintptr_t>(p) % 32, 0u);
+
+        v.push_back(boost::anys::basic_any<>());
+        BOOST_TEST(v[4].empty());
+        BOOST_TEST_EQ(v.size(), 5u);
+
+        const boost::anys::basic_any<> copied = counted(3);
+        v.push_back(copied);
+        BOOST_TEST_EQ(boost::any_cast<counted&>(v[5]).value, 3);
+
+        boost::anys::adaptive_any_vector copy = v;
+        BOOST_TEST_EQ(counted::instances, 3 * 2 + 1);  // `copied` holds one more
+        BOOST_TEST_EQ(boost::any_cast<std::string&>(copy[2]), "text");
+        BOOST_TEST(copy[4].empty());
+
+        v.clear();
+        BOOST_TEST(v.empty());
+        BOOST_TEST(v.is_homogeneous());
+        BOOST_TEST_EQ(counted::instances, 4);
+
+        v.push_back(std::string("again"));
+        BOOST_TEST_EQ(v.homogeneous_span<std::string>()[0], "again");
+
+        swap(v, copy);
+        BOOST_TEST(!v.is_homogeneous());
+        BOOST_TEST(copy.is_homogeneous());
+
+        boost::anys::adaptive_any_vector moved = std::move(v);
+        BOOST_TEST(v.empty());
+        BOOST_TEST(v.is_homogeneous());
+        BOOST_TEST_EQ(moved.size(), 6u);
+    }
+    BOOST_TEST_EQ(counted::instances, 0);
+}
+
+void test_first_empty() {
+    boost::anys::adaptive_any_vector v;
+    v.push_back(boost::anys::basic_any<>());
+    BOOST_TEST(!v.is_homogeneous());
+    v.push_back(1);
+    BOOST_TEST_EQ(v.size(), 2u);
+    BOOST_TEST(v[0].empty());
+    BOOST_TEST_EQ(boost::any_cast<int>(v[1]), 1);
+}
+
+
+// The failed first insert shall not fix the type of the sequence
+void test_throw_on_first() {
+#ifndef BOOST_NO_EXCEPTIONS
+    boost::anys::adaptive_any_vector v;
+    BOOST_TEST_THROWS(v.emplace_back<thrower>(), std::runtime_error);
+    BOOST_TEST(v.empty());
+
+    v.push_back(std::string("text"));
+    v.push_back(boost::anys::basic_any<>(std::string("more")));
+    BOOST_TEST(v.is_homogeneous());
+    BOOST_TEST_EQ(v.homogeneous_span<std::string>().size(), 2u);
+    BOOST_TEST(v[0].type() == boost::typeindex::type_id<std::string>());
+    BOOST_TEST_EQ(boost::any_cast<std::string>(v[0]), "text");
+    BOOST_TEST_EQ(boost::any_cast<std::string>(v[1]), "more");
+#endif
+}
+
+// Switching to holders allocates a holder per value, the values shall
+// survive a failure in the middle of it
+void test_spill_allocation_failure() {
+#ifndef BOOST_NO_EXCEPTIONS
+    boost::anys::adaptive_any_vector v;
+    for (int i = 0; i < 10; ++i) {
+        v.push_back(std::string(50, static_cast<char>('a' + i)));
+    }
+
+    // The new value, the holders array and two of the holders
+    allocations_left = 4;
+    BOOST_TEST_THROWS(v.push_back(1), std::bad_alloc);
+    allocations_left = -1;
+
+    BOOST_TEST(v.is_homogeneous());
+    BOOST_TEST_EQ(v.size(), 10u);
+    for (int i = 0; i < 10; ++i) {
+        BOOST_TEST_EQ(v.homogeneous_span<std::string>()[i], std::string(50, static_cast<char>('a' + i)));
+    }
+
+    v.push_back(1);
+    BOOST_TEST(!v.is_homogeneous());
+    BOOST_TEST_EQ(boost::any_cast<std::string>(v[9]), std::string(50, 'j'));
+    BOOST_TEST_EQ(boost::any_cast<int>(v[10]), 1);
+#endif
+}
+
+}
+
+int main() {
+    test_homogeneous();
+    test_switch_to_holders();
+    test_first_empty();
+    test_throw_on_first();
+    test_spill_allocation_failure();
+
+    return boost::report_errors();
+}
@@ -0,0 +1,229 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/any/any_block.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct counted {
+    static int instances;
+
+    explicit counted(int v) : value(v) { ++instances; }
+    counted(const counted& other) : value(other.value) { ++instances; }
+    ~counted() { --instances; }
+
+    int value;
+};
+
+int counted::instances = 0;
+
+struct throws_on_copy {
+    static int copies_left;
+
+    throws_on_copy() = default;
+    throws_on_copy(throws_on_copy&&) noexcept = default;
+    throws_on_copy(const throws_on_copy&) {
+        if (!copies_left--) {
+            throw 42;
+        }
+    }
+};
+
+int throws_on_copy::copies_left = 0;
+
+struct alignas(64) over_aligned {
+    int value;
+};
+
+#ifdef BOOST_ANY_USE_HOLDER_VALUE_OPS
+template <class Any>
+void test_clone_range() {
+    std::vector<Any> values;
+    values.emplace_back(1);
+    values.emplace_back(std::string("a long string that does not fit into the small buffer"));
+    values.emplace_back();
+    values.emplace_back('c');
+    values.emplace_back(counted(5));
+
+    boost::anys::any_block block(values.begin(), values.end());
+    BOOST_TEST_EQ(block.size(), values.size());
+    BOOST_TEST(!block.empty());
+    BOOST_TEST_EQ(counted::instances, 2);
+
+    BOOST_TEST_EQ(boost::any_cast<int>(block[0]), 1);
+    BOOST_TEST_EQ(boost::any_cast<std::string&>(block[1]), boost::any_cast<std::string&>(values[1]));
+    BOOST_TEST(block[2].empty());
+    BOOST_TEST_EQ(boost::any_cast<char>(block[3]), 'c');
+    BOOST_TEST_EQ(boost::any_cast<counted&>(block[4]).value, 5);
+
+    // Copies, not references
+    boost::any_cast<int&>(block[0]) = 10;
+    BOOST_TEST_EQ(boost::any_cast<int>(values[0]), 1);
+
+    // All the values are in one block after the entries
+    const boost::anys::any_ref first_ref = block[0];
+    const boost::anys::any_ref last_ref = block[4];
+    const unsigned char* first = reinterpret_cast<const unsigned char*>(boost::any_cast<int>(&first_ref));
+    const unsigned char* last = reinterpret_cast<const unsigned char*>(boost::any_cast<counted>(&last_ref));
+    BOOST_TEST(first < last);
+    BOOST_TEST(static_cast<std::size_t>(last - first) < 128);
+}
+#endif
+
+void test_clone_range_of_refs() {
+    std::vector<boost::anys::any_cref> refs;
+    const int i = 7;
+    const std::string s = "s";
+    refs.emplace_back(i);
+    refs.emplace_back(s);
+    refs.emplace_back();
+
+    const boost::anys::any_block block(refs.begin(), refs.end());
+    BOOST_TEST_EQ(block.size(), 3u);
+    BOOST_TEST_EQ(boost::any_cast<int>(block[0]), 7);
+    BOOST_TEST_EQ(boost::any_cast<const std::string&>(block[1]), "s");
+    BOOST_TEST(block[2].empty());
+}
+
+#ifdef BOOST_ANY_USE_HOLDER_VALUE_OPS
+void test_broadcast() {
+    {
+        const boost::anys::basic_any<> value(counted(3));
+        boost::anys::any_block block(100, value);
+        BOOST_TEST_EQ(block.size(), 100u);
+        BOOST_TEST_EQ(counted::instances, 101);
+        for (std::size_t i = 0; i < block.size(); ++i) {
+            BOOST_TEST_EQ(boost::any_cast<counted&>(block[i]).value, 3);
+        }
+        BOOST_TEST_EQ(
+            &boost::any_cast<counted&>(block[1]) - &boost::any_cast<counted&>(block[0]),
+            1
+        );
+
+        const boost::any text(std::string("text"));
+        const boost::anys::any_block texts(3, text);
+        BOOST_TEST_EQ(boost::any_cast<const std::string&>(texts[2]), "text");
+
+        const boost::anys::any_block empties(4, boost::any());
+        BOOST_TEST_EQ(empties.size(), 4u);
+        BOOST_TEST(empties[3].empty());
+
+        const boost::anys::any_block none(0, value);
+        BOOST_TEST(none.empty());
+    }
+    BOOST_TEST_EQ(counted::instances, 0);
+}
+#endif
+
+void test_broadcast_of_ref() {
+    {
+        const counted value(4);
+        const boost::anys::any_block block(5, boost::anys::any_cref(value));
+        BOOST_TEST_EQ(counted::instances, 6);
+        BOOST_TEST_EQ(boost::any_cast<const counted&>(block[4]).value, 4);
+    }
+    BOOST_TEST_EQ(counted::instances, 0);
+}
+
+void test_copy_move() {
+    std::vector<counted> values;
+    values.reserve(10);
+    for (int i = 0; i < 10; ++i) {
+        values.emplace_back(i);
+    }
+    std::vector<boost::anys::any_cref> refs(values.begin(), values.end());
+    BOOST_TEST_EQ(counted::instances, 10);
+    {
+        boost::anys::any_block block(refs.begin(), refs.end());
+        BOOST_TEST_EQ(counted::instances, 20);
+
+        boost::anys::any_block copy(block);
+        BOOST_TEST_EQ(counted::instances, 30);
+        BOOST_TEST_EQ(boost::any_cast<const counted&>(copy[9]).value, 9);
+
+        boost::anys::any_block moved(std::move(copy));
+        BOOST_TEST(copy.empty());
+        BOOST_TEST_EQ(counted::instances, 30);
+
+        moved = block;
+        BOOST_TEST_EQ(counted::instances, 30);
+        moved = boost::anys::any_block();
+        BOOST_TEST_EQ(counted::instances, 20);
+
+        swap(moved, block);
+        BOOST_TEST(block.empty());
+        BOOST_TEST_EQ(moved.size(), 10u);
+    }
+    BOOST_TEST_EQ(counted::instances, 10);
+}
+
+#ifdef BOOST_ANY_USE_HOLDER_VALUE_OPS
+void test_exception() {
+    std::vector<boost::anys::basic_any<>> values;
+    values.reserve(4);
+    values.emplace_back(counted(1));
+    values.emplace_back(throws_on_copy());
+    values.emplace_back(throws_on_copy());
+    values.emplace_back(counted(2));
+    BOOST_TEST_EQ(counted::instances, 2);
+
+    throws_on_copy::copies_left = 1;
+    BOOST_TEST_THROWS(boost::anys::any_block(values.begin(), values.end()), int);
+    BOOST_TEST_EQ(counted::instances, 2);
+
+    throws_on_copy::copies_left = 2;
+    boost::anys::any_block block(values.begin(), values.end());
+    BOOST_TEST_EQ(counted::instances, 4);
+}
+#endif
+
+void test_over_aligned() {
+    const char x = 'x';
+    const char y = 'y';
+    const over_aligned a{1};
+    const over_aligned b{2};
+    std::vector<boost::anys::any_cref> values;
+    values.emplace_back(x);
+    values.emplace_back(a);
+    values.emplace_back(y);
+    values.emplace_back(b);
+
+    const boost::anys::any_block block(values.begin(), values.end());
+    for (std::size_t i = 1; i < 4; i += 2) {
+        const over_aligned& v = boost::any_cast<const over_aligned&>(block[i]);
+        BOOST_TEST_EQ(reinterpret_cast<std::uintptr_t>(&v) % 64, 0u);
+        BOOST_TEST_EQ(v.value, static_cast<int>(i / 2 + 1));
+    }
+    BOOST_TEST_EQ(boost::any_cast<char>(block[2]), 'y');
+}
+
+} // namespace
+
+int main() {
+#ifdef BOOST_ANY_USE_HOLDER_VALUE_OPS
+    test_clone_range<boost::any>();
+    test_clone_range<boost::anys::basic_any<>>();
+    test_clone_range<boost::anys::basic_any<8, 8>>();
+    BOOST_TEST_EQ(counted::instances, 0);
+    test_broadcast();
+#endif
+    test_clone_range_of_refs();
+    test_broadcast_of_ref();
+    test_copy_move();
+    BOOST_TEST_EQ(counted::instances, 0);
+#ifdef BOOST_ANY_USE_HOLDER_VALUE_OPS
+    test_exception();
+#endif
+    test_over_aligned();
+
+    return boost::report_errors();
+}
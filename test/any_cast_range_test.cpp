@@ -0,0 +1,127 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/any/any_cast_range.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <iterator>
+#include <list>
+#include <string>
+#include <vector>
+
+namespace {
+
+template <class Any>
+void test_homogeneous() {
+    std::vector<Any> values;
+    for (int i = 0; i < 10; ++i) {
+        values.emplace_back(i);
+    }
+
+    std::vector<int*> pointers(values.size());
+    const auto result = boost::anys::any_cast_range<int>(values.begin(), values.end(), pointers.begin());
+    BOOST_TEST(result.in == values.end());
+    BOOST_TEST(result.out == pointers.end());
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        BOOST_TEST_EQ(pointers[i], boost::any_cast<int>(&values[i]));
+    }
+
+    *pointers[3] = 42;
+    BOOST_TEST_EQ(boost::any_cast<int>(values[3]), 42);
+
+    std::vector<int*> ranged;
+    BOOST_TEST(boost::anys::any_cast_range<int>(values, std::back_inserter(ranged)).in == values.end());
+    BOOST_TEST(ranged == pointers);
+
+    const std::vector<Any>& cvalues = values;
+    std::vector<const int*> cpointers;
+    BOOST_TEST(boost::anys::any_cast_range<const int>(cvalues, std::back_inserter(cpointers)).in == cvalues.end());
+    BOOST_TEST_EQ(cpointers.size(), values.size());
+    BOOST_TEST_EQ(*cpointers[3], 42);
+
+    std::vector<const int*> from_const;
+    boost::anys::any_cast_range<int>(cvalues.begin(), cvalues.end(), std::back_inserter(from_const));
+    BOOST_TEST_EQ(from_const.size(), values.size());
+}
+
+template <class Any>
+void test_mismatch() {
+    std::vector<Any> values;
+    values.emplace_back(std::string("a"));
+    values.emplace_back(std::string("b"));
+    values.emplace_back(1);
+    values.emplace_back(std::string("c"));
+
+    std::vector<std::string*> pointers;
+    auto result = boost::anys::any_cast_range<std::string>(values.begin(), values.end(), std::back_inserter(pointers));
+    BOOST_TEST(result.in == values.begin() + 2);
+    BOOST_TEST_EQ(pointers.size(), 2u);
+    BOOST_TEST_EQ(*pointers[1], "b");
+
+    pointers.clear();
+    result = boost::anys::any_cast_range<std::string>(values.begin() + 3, values.end(), std::back_inserter(pointers));
+    BOOST_TEST(result.in == values.end());
+    BOOST_TEST_EQ(pointers.size(), 1u);
+
+    std::vector<Any> empty_first(2);
+    std::vector<int*> ints;
+    BOOST_TEST(boost::anys::any_cast_range<int>(empty_first, std::back_inserter(ints)).in == empty_first.begin());
+    BOOST_TEST(ints.empty());
+
+    std::vector<Any> none;
+    BOOST_TEST(boost::anys::any_cast_range<int>(none, std::back_inserter(ints)).in == none.end());
+}
+
+template <class Any>
+void test_runs() {
+    // Alternating runs of the same type with values of a different type
+    std::list<Any> values;
+    for (int i = 0; i < 4; ++i) {
+        values.emplace_back(i);
+    }
+    values.emplace_back(1.0);
+    for (int i = 0; i < 4; ++i) {
+        values.emplace_back(i);
+    }
+
+    int* pointers[10] = {};
+    const auto result = boost::anys::any_cast_range<int>(values.begin(), values.end(), pointers);
+    BOOST_TEST(result.in == std::next(values.begin(), 4));
+    BOOST_TEST(result.out == pointers + 4);
+    BOOST_TEST_EQ(*pointers[3], 3);
+    BOOST_TEST(!pointers[4]);
+}
+
+void test_unique_any() {
+    std::vector<boost::anys::unique_any> values;
+    for (int i = 0; i < 5; ++i) {
+        values.emplace_back(i);
+    }
+    values.emplace_back(std::string("x"));
+
+    std::vector<int*> pointers;
+    const auto result = boost::anys::any_cast_range<int>(values, std::back_inserter(pointers));
+    BOOST_TEST(result.in == values.begin() + 5);
+    BOOST_TEST_EQ(pointers.size(), 5u);
+    BOOST_TEST_EQ(*pointers[4], 4);
+}
+
+} // namespace
+
+int main() {
+    test_homogeneous<boost::any>();
+    test_homogeneous<boost::anys::basic_any<>>();
+    test_homogeneous<boost::anys::basic_any<8, 8>>();
+    test_mismatch<boost::any>();
+    test_mismatch<boost::anys::basic_any<>>();
+    test_mismatch<boost::anys::basic_any<8, 8>>();
+    test_runs<boost::any>();
+    test_runs<boost::anys::basic_any<>>();
+    test_unique_any();
+
+    return boost::report_errors();
+}
@@ -0,0 +1,147 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/any/any_context.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+const boost::anys::context_key<long> deadline_key;
+const boost::anys::context_key<std::string> trace_key;
+const boost::anys::context_key<std::shared_ptr<int>> auth_key;
+const boost::anys::context_key<long> timeout_key;
+
+struct throws_on_copy {
+    throws_on_copy() = default;
+    throws_on_copy(throws_on_copy&&) = default;
+    throws_on_copy(const throws_on_copy&) { throw std::runtime_error("copy"); }
+};
+
+const boost::anys::context_key<throws_on_copy> throwing_key;
+
+void test_basics() {
+    BOOST_TEST_NE(deadline_key.index(), timeout_key.index());
+
+    boost::anys::any_context context;
+    BOOST_TEST(!context.get(deadline_key));
+    BOOST_TEST(!context.contains(trace_key));
+    BOOST_TEST(!context.erase(trace_key));
+
+    context.set(deadline_key, 100);
+    context.emplace(trace_key, 3, 't');
+    BOOST_TEST_EQ(*context.get(deadline_key), 100);
+    BOOST_TEST_EQ(*context.get(trace_key), "ttt");
+    BOOST_TEST(!context.get(timeout_key));
+
+    context.set(deadline_key, 200);
+    BOOST_TEST_EQ(*context.get(deadline_key), 200);
+
+    BOOST_TEST(context.erase(trace_key));
+    BOOST_TEST(!context.contains(trace_key));
+    BOOST_TEST(context.contains(deadline_key));
+}
+
+void test_fork() {
+    boost::anys::any_context parent;
+    parent.set(deadline_key, 1);
+    parent.set(trace_key, std::string("root"));
+    parent.set(auth_key, std::make_shared<int>(7));
+
+    boost::anys::any_context child = parent.fork();
+    BOOST_TEST(child.shares_with(parent));
+    BOOST_TEST_EQ(child.get(trace_key), parent.get(trace_key));
+
+    child.set(trace_key, std::string("child"));
+    BOOST_TEST(!child.shares_with(parent));
+    BOOST_TEST_EQ(*parent.get(trace_key), "root");
+    BOOST_TEST_EQ(*child.get(trace_key), "child");
+    BOOST_TEST_EQ(*child.get(deadline_key), 1);
+
+    // Unchanged values are shared, not copied
+    BOOST_TEST_EQ(child.get(deadline_key), parent.get(deadline_key));
+    BOOST_TEST_EQ(child.get(auth_key), parent.get(auth_key));
+    BOOST_TEST_EQ(parent.get(auth_key)->use_count(), 1);
+
+    // Sole owner modifies in place
+    const std::string* before = child.get(trace_key);
+    child.set(deadline_key, 2);
+    BOOST_TEST_EQ(child.get(trace_key), before);
+
+    boost::anys::any_context grandchild = child.fork();
+    BOOST_TEST(grandchild.erase(auth_key));
+    BOOST_TEST(child.contains(auth_key));
+    BOOST_TEST(!grandchild.contains(auth_key));
+
+    boost::anys::any_context moved(std::move(grandchild));
+    BOOST_TEST(!grandchild.contains(deadline_key));
+    BOOST_TEST_EQ(*moved.get(deadline_key), 2);
+
+    swap(moved, grandchild);
+    BOOST_TEST(!moved.contains(deadline_key));
+    BOOST_TEST_EQ(*grandchild.get(deadline_key), 2);
+}
+
+void test_exceptions() {
+    boost::anys::any_context parent;
+    parent.emplace(throwing_key);
+    parent.set(deadline_key, 5);
+
+    boost::anys::any_context child = parent.fork();
+#ifndef BOOST_NO_EXCEPTIONS
+    const throws_on_copy source;
+    BOOST_TEST_THROWS(child.emplace(throwing_key, source), std::runtime_error);
+    BOOST_TEST(child.shares_with(parent));
+    BOOST_TEST_EQ(*child.get(deadline_key), 5);
+#endif
+
+    // Values that cannot be copied do not prevent the copy on write
+    child.set(deadline_key, 6);
+    BOOST_TEST_EQ(*child.get(deadline_key), 6);
+    BOOST_TEST_EQ(*parent.get(deadline_key), 5);
+    BOOST_TEST_EQ(child.get(throwing_key), parent.get(throwing_key));
+}
+
+void test_threads() {
+    boost::anys::any_context root;
+    root.set(trace_key, std::string("request"));
+    root.set(deadline_key, 10);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&root, i]() {
+            for (int j = 0; j < 200; ++j) {
+                boost::anys::any_context task = root.fork();
+                BOOST_TEST_EQ(*task.get(trace_key), "request");
+                task.set(deadline_key, static_cast<long>(i * 1000 + j));
+                BOOST_TEST_EQ(*task.get(deadline_key), i * 1000 + j);
+                std::this_thread::yield();
+            }
+        });
+    }
+    for (std::thread& t : threads) {
+        t.join();
+    }
+    BOOST_TEST_EQ(*root.get(deadline_key), 10);
+}
+
+} // anonymous namespace
+
+int main() {
+    test_basics();
+    test_fork();
+    test_exceptions();
+    test_threads();
+
+    return boost::report_errors();
+}
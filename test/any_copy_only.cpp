@@ -0,0 +1,26 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/any.hpp>
+
+// Copy constructible type with a deleted move constructor
+struct copy_only {
+    copy_only() = default;
+    copy_only(const copy_only&) = default;
+    copy_only(copy_only&&) = delete;
+    copy_only& operator=(const copy_only&) = default;
+
+    int value = 42;
+};
+
+int main()
+{
+    const copy_only c;
+    boost::any a(c);
+    boost::any b(a);
+    b = a;
+    return boost::any_cast<const copy_only&>(b).value == 42 ? 0 : 1;
+}
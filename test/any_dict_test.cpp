@@ -0,0 +1,187 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/any/any_dict.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#ifndef BOOST_NO_CXX17_HDR_STRING_VIEW
+#include <string_view>
+#endif
+
+namespace {
+
+int alive = 0;
+
+struct tracked {
+    explicit tracked(int v) : value(v) { ++alive; }
+    tracked(const tracked& other) : value(other.value) { ++alive; }
+    ~tracked() { --alive; }
+    int value;
+};
+
+struct throws_on_copy {
+    throws_on_copy() = default;
+    throws_on_copy(throws_on_copy&&) = default;
+    throws_on_copy(const throws_on_copy&) { throw std::runtime_error("copy"); }
+};
+
+void test_basics() {
+    boost::anys::any_dict dict;
+    BOOST_TEST(dict.empty());
+    BOOST_TEST(!dict.contains("a"));
+    BOOST_TEST(!dict.find("a"));
+    BOOST_TEST(!dict.get<int>("a"));
+    BOOST_TEST(!dict.erase("a"));
+
+    BOOST_TEST(dict.insert_or_assign("a", 1));
+    BOOST_TEST(dict.insert_or_assign("b", std::string("text")));
+    BOOST_TEST_EQ(dict.size(), 2u);
+
+    BOOST_TEST_EQ(*dict.get<int>("a"), 1);
+    BOOST_TEST(!dict.get<double>("a"));
+    BOOST_TEST_EQ(*dict.get<std::string>(std::string("b")), "text");
+    BOOST_TEST_EQ(boost::any_cast<int>(*dict.find("a")), 1);
+
+    BOOST_TEST(!dict.insert_or_assign("a", 2.5));
+    BOOST_TEST_EQ(dict.size(), 2u);
+    BOOST_TEST(!dict.get<int>("a"));
+    BOOST_TEST_EQ(*dict.get<double>("a"), 2.5);
+
+    std::string& value = dict.emplace<std::string>("c", 3, 'x');
+    BOOST_TEST_EQ(value, "xxx");
+    value += 'y';
+    BOOST_TEST_EQ(*dict.get<std::string>("c"), "xxxy");
+
+    const boost::anys::any_dict& cdict = dict;
+    BOOST_TEST_EQ(*cdict.get<double>("a"), 2.5);
+    BOOST_TEST(cdict.find("b"));
+
+    BOOST_TEST(dict.erase("b"));
+    BOOST_TEST(!dict.erase("b"));
+    BOOST_TEST(!dict.contains("b"));
+    BOOST_TEST_EQ(dict.size(), 2u);
+    BOOST_TEST_EQ(*dict.get<std::string>("c"), "xxxy");
+
+    const char key[] = {'a', 'b'};
+    dict.insert_or_assign(std::string(key, 2), 7);
+    BOOST_TEST_EQ(*dict.get<int>("ab"), 7);
+    BOOST_TEST(!dict.contains(std::string(key, 1) + "x"));
+
+#ifndef BOOST_NO_CXX17_HDR_STRING_VIEW
+    const std::string_view view = "abc";
+    BOOST_TEST_EQ(*dict.get<int>(view.substr(0, 2)), 7);
+    BOOST_TEST(dict.erase(view.substr(0, 2)));
+#endif
+}
+
+// Crosses the switch from the linear scan to the hash table both ways
+void test_growth() {
+    using dict_type = boost::anys::basic_any_dict<sizeof(int), alignof(int)>;
+    dict_type dict;
+    std::map<std::string, int> reference;
+
+    for (int i = 0; i < 500; ++i) {
+        const std::string k = "key" + std::to_string(i);
+        BOOST_TEST(dict.insert_or_assign(k, i));
+        reference[k] = i;
+        BOOST_TEST_EQ(dict.size(), reference.size());
+        BOOST_TEST_EQ(*dict.get<int>(k), i);
+    }
+
+    // Erase every other key, the others stay reachable
+    for (int i = 0; i < 500; i += 2) {
+        const std::string k = "key" + std::to_string(i);
+        BOOST_TEST(dict.erase(k));
+        reference.erase(k);
+    }
+    BOOST_TEST_EQ(dict.size(), reference.size());
+    for (int i = 0; i < 500; ++i) {
+        const int* v = dict.get<int>("key" + std::to_string(i));
+        BOOST_TEST_EQ(v != nullptr, i % 2 == 1);
+        if (v) {
+            BOOST_TEST_EQ(*v, i);
+        }
+    }
+
+    int sum = 0;
+    std::size_t visited = 0;
+    dict.for_each([&](const std::string& k, dict_type::value_type& v) {
+        BOOST_TEST_EQ(reference.at(k), boost::any_cast<int>(v));
+        sum += boost::any_cast<int>(v);
+        ++visited;
+    });
+    BOOST_TEST_EQ(visited, reference.size());
+    BOOST_TEST_EQ(sum, 250 * 250);
+
+    dict.clear();
+    BOOST_TEST(dict.empty());
+    BOOST_TEST(!dict.contains("key1"));
+    for (std::size_t i = 0; i < dict_type::linear_limit; ++i) {
+        dict.insert_or_assign(std::to_string(i), static_cast<int>(i));
+    }
+    for (std::size_t i = 0; i < dict_type::linear_limit; i += 3) {
+        BOOST_TEST(dict.erase(std::to_string(i)));
+    }
+    for (std::size_t i = 0; i < dict_type::linear_limit; ++i) {
+        BOOST_TEST_EQ(dict.contains(std::to_string(i)), i % 3 != 0);
+    }
+}
+
+void test_lifetime() {
+    {
+        boost::anys::any_dict dict;
+        for (int i = 0; i < 20; ++i) {
+            dict.insert_or_assign(std::to_string(i), tracked(i));
+        }
+        BOOST_TEST_EQ(alive, 20);
+
+        boost::anys::any_dict copy = dict;
+        BOOST_TEST_EQ(alive, 40);
+        BOOST_TEST_EQ(copy.get<tracked>("7")->value, 7);
+
+        dict.insert_or_assign("7", 0);
+        BOOST_TEST_EQ(alive, 39);
+        BOOST_TEST(dict.erase("8"));
+        BOOST_TEST_EQ(alive, 38);
+
+        boost::anys::any_dict other;
+        swap(dict, other);
+        BOOST_TEST(dict.empty());
+        BOOST_TEST_EQ(other.size(), 19u);
+        BOOST_TEST_EQ(other.get<tracked>("9")->value, 9);
+    }
+    BOOST_TEST_EQ(alive, 0);
+}
+
+void test_exceptions() {
+#ifndef BOOST_NO_EXCEPTIONS
+    boost::anys::any_dict dict;
+    dict.insert_or_assign("a", 1);
+    const throws_on_copy value{};
+    BOOST_TEST_THROWS(dict.insert_or_assign("a", value), std::runtime_error);
+    BOOST_TEST_THROWS(dict.insert_or_assign("b", value), std::runtime_error);
+    BOOST_TEST_EQ(*dict.get<int>("a"), 1);
+    BOOST_TEST(!dict.contains("b"));
+    BOOST_TEST_EQ(dict.size(), 1u);
+#endif
+}
+
+} // anonymous namespace
+
+int main() {
+    test_basics();
+    test_growth();
+    test_lifetime();
+    test_exceptions();
+
+    return boost::report_errors();
+}
@@ -0,0 +1,183 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/any/any_queue.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using any_type = boost::anys::basic_any<32, 8>;
+using pair_type = std::pair<int, double>;
+
+struct throws_on_construction {
+    explicit throws_on_construction(int) { throw std::runtime_error("construction"); }
+};
+
+template <class Queue>
+void test_single_thread() {
+    Queue queue(3);
+    BOOST_TEST_EQ(queue.capacity(), 4u);
+
+    BOOST_TEST(queue.template try_emplace<pair_type>(1, 2.0));
+    BOOST_TEST(queue.template try_emplace<std::string>(100, 'x'));
+    BOOST_TEST(queue.try_push(any_type(3)));
+    BOOST_TEST(queue.try_push(any_type()));
+
+    any_type rejected = 5;
+    BOOST_TEST(!queue.try_push(std::move(rejected)));
+    BOOST_TEST_EQ(boost::any_cast<int>(rejected), 5);
+    BOOST_TEST(!queue.template try_emplace<int>(6));
+
+    BOOST_TEST(queue.try_consume([](any_type& message) {
+        const auto& value = boost::any_cast<pair_type&>(message);
+        BOOST_TEST_EQ(value.first, 1);
+        BOOST_TEST_EQ(value.second, 2.0);
+    }));
+
+    any_type popped;
+    BOOST_TEST(queue.try_pop(popped));
+    BOOST_TEST_EQ(boost::any_cast<const std::string&>(popped), std::string(100, 'x'));
+    BOOST_TEST(queue.try_pop(popped));
+    BOOST_TEST_EQ(boost::any_cast<int>(popped), 3);
+    BOOST_TEST(queue.try_pop(popped));
+    BOOST_TEST(popped.empty());
+    BOOST_TEST(!queue.try_pop(popped));
+
+    // Wraps around
+    for (int i = 0; i < 10; ++i) {
+        BOOST_TEST(queue.template try_emplace<int>(i));
+        BOOST_TEST(queue.try_pop(popped));
+        BOOST_TEST_EQ(boost::any_cast<int>(popped), i);
+    }
+}
+
+template <class Queue>
+void test_exceptions() {
+    Queue queue(2);
+    BOOST_TEST_THROWS(queue.template try_emplace<throws_on_construction>(1), std::runtime_error);
+    BOOST_TEST(queue.template try_emplace<int>(1));
+
+    BOOST_TEST_THROWS(queue.try_consume([](any_type&) {
+        throw std::runtime_error("visitor");
+    }), std::runtime_error);
+
+    // The message was removed despite the exception
+    any_type popped;
+    BOOST_TEST(!queue.try_pop(popped));
+
+    // The queue is still usable
+    BOOST_TEST(queue.template try_emplace<int>(2));
+    BOOST_TEST(queue.try_pop(popped));
+    BOOST_TEST_EQ(boost::any_cast<int>(popped), 2);
+}
+
+void test_spsc_threads() {
+    constexpr int count = 20000;
+    boost::anys::spsc_any_queue<32, 8> queue(64);
+
+    std::thread producer([&queue]() {
+        for (int i = 0; i < count; ++i) {
+            if (i % 3) {
+                while (!queue.try_emplace<int>(i)) {
+                    std::this_thread::yield();
+                }
+            } else {
+                while (!queue.try_emplace<std::string>(std::to_string(i))) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    });
+
+    int expected = 0;
+    while (expected < count) {
+        if (!queue.try_consume([&expected](any_type& message) {
+            if (expected % 3) {
+                BOOST_TEST_EQ(boost::any_cast<int>(message), expected);
+            } else {
+                BOOST_TEST_EQ(boost::any_cast<const std::string&>(message), std::to_string(expected));
+            }
+            ++expected;
+        })) {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    BOOST_TEST(queue.empty());
+}
+
+void test_mpmc_threads() {
+    constexpr int producers = 3;
+    constexpr int consumers = 3;
+    constexpr int per_producer = 10000;
+    boost::anys::mpmc_any_queue<32, 8> queue(128);
+
+    std::atomic<long long> sum{0};
+    std::atomic<int> consumed{0};
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&queue]() {
+            for (int i = 1; i <= per_producer; ++i) {
+                if (i % 2) {
+                    while (!queue.try_emplace<int>(i)) {
+                        std::this_thread::yield();
+                    }
+                } else {
+                    while (!queue.try_emplace<long long>(i)) {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+        });
+    }
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&queue, &sum, &consumed]() {
+            while (consumed.load() < producers * per_producer) {
+                const bool consumed_one = queue.try_consume([&sum, &consumed](any_type& message) {
+                    if (const int* i = boost::any_cast<int>(&message)) {
+                        sum += *i;
+                    } else {
+                        sum += boost::any_cast<long long>(message);
+                    }
+                    ++consumed;
+                });
+                if (!consumed_one) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (std::thread& t : threads) {
+        t.join();
+    }
+
+    const long long expected = static_cast<long long>(per_producer) * (per_producer + 1) / 2 * producers;
+    BOOST_TEST_EQ(sum.load(), expected);
+    any_type popped;
+    BOOST_TEST(!queue.try_pop(popped));
+}
+
+} // anonymous namespace
+
+int main() {
+    test_single_thread<boost::anys::spsc_any_queue<32, 8>>();
+    test_single_thread<boost::anys::mpmc_any_queue<32, 8>>();
+    test_exceptions<boost::anys::spsc_any_queue<32, 8>>();
+    test_exceptions<boost::anys::mpmc_any_queue<32, 8>>();
+    test_spsc_threads();
+    test_mpmc_threads();
+
+    return boost::report_errors();
+}
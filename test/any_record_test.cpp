@@ -0,0 +1,187 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_ANY_USE_HOLDER_VALUE_OPS
+#include <boost/any/any_record.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <cstdint>
+#include <string>
+
+namespace {
+
+struct counted {
+    static int instances;
+
+    explicit counted(int v) : value(v) { ++instances; }
+    counted(const counted& other) : value(other.value) { ++instances; }
+    ~counted() { --instances; }
+
+    int value;
+};
+
+int counted::instances = 0;
+
+struct throws_on_copy {
+    static bool enabled;
+
+    throws_on_copy() = default;
+    throws_on_copy(throws_on_copy&&) = default;
+    throws_on_copy(const throws_on_copy&) {
+        if (enabled) {
+            throw 42;
+        }
+    }
+};
+
+bool throws_on_copy::enabled = false;
+
+struct alignas(32) over_aligned {
+    int value;
+};
+
+void test_schema_layout() {
+    boost::anys::record_schema schema;
+    BOOST_TEST_EQ(schema.field_count(), 0u);
+
+    const std::size_t c = schema.add_field('a');
+    const std::size_t d = schema.add_field(boost::anys::basic_any<>(1.0));
+    const std::size_t s = schema.add_field(std::string("default"));
+    BOOST_TEST_EQ(c, 0u);
+    BOOST_TEST_EQ(d, 1u);
+    BOOST_TEST_EQ(s, 2u);
+    BOOST_TEST_EQ(schema.field_count(), 3u);
+
+    BOOST_TEST(schema.field_type(c) == boost::typeindex::type_id<char>());
+    BOOST_TEST(schema.field_type(d) == boost::typeindex::type_id<double>());
+    BOOST_TEST(schema.field_type(s) == boost::typeindex::type_id<std::string>());
+
+    BOOST_TEST_EQ(schema.field_offset(c), 0u);
+    BOOST_TEST_EQ(schema.field_offset(d), alignof(double));
+    BOOST_TEST_EQ(schema.field_offset(s) % alignof(std::string), 0u);
+    BOOST_TEST_EQ(schema.record_size(), schema.field_offset(s) + sizeof(std::string));
+    BOOST_TEST_EQ(schema.record_alignment(), alignof(std::string) > alignof(double) ? alignof(std::string) : alignof(double));
+
+    BOOST_TEST_THROWS(schema.add_field(boost::anys::basic_any<>()), boost::bad_any_cast);
+    BOOST_TEST_EQ(schema.field_count(), 3u);
+}
+
+void test_record_access() {
+    boost::anys::record_schema schema;
+    const std::size_t id = schema.add_field(std::uint64_t{7});
+    const std::size_t name = schema.add_field(std::string("none"));
+
+    boost::anys::any_record record(schema);
+    BOOST_TEST_EQ(record.size(), 2u);
+    BOOST_TEST_EQ(&record.schema(), &schema);
+    BOOST_TEST_EQ(record.get<std::uint64_t>(id), 7u);
+    BOOST_TEST_EQ(record.get<std::string>(name), "none");
+
+    record.get<std::uint64_t>(id) = 42;
+    boost::any_cast<std::string&>(record.field(name)) = "answer";
+    BOOST_TEST_EQ(boost::any_cast<std::uint64_t>(record.field(id)), 42u);
+    BOOST_TEST_EQ(record.get<std::string>(name), "answer");
+
+    const boost::anys::any_record& crecord = record;
+    BOOST_TEST_EQ(crecord.get<std::string>(name), "answer");
+    BOOST_TEST_EQ(boost::any_cast<const std::string&>(crecord.field(name)), "answer");
+
+    BOOST_TEST_THROWS(record.get<int>(id), boost::bad_any_cast);
+    BOOST_TEST_THROWS(crecord.get<std::uint64_t>(name), boost::bad_any_cast);
+
+    boost::anys::any_record other(schema);
+    BOOST_TEST_EQ(other.get<std::string>(name), "none");
+    other = record;
+    BOOST_TEST_EQ(other.get<std::string>(name), "answer");
+    other.get<std::string>(name) = "changed";
+    BOOST_TEST_EQ(record.get<std::string>(name), "answer");
+
+    swap(record, other);
+    BOOST_TEST_EQ(record.get<std::string>(name), "changed");
+}
+
+void test_empty_schema() {
+    const boost::anys::record_schema schema;
+    boost::anys::any_record record(schema);
+    BOOST_TEST_EQ(record.size(), 0u);
+    boost::anys::any_record copy(record);
+    BOOST_TEST_EQ(copy.size(), 0u);
+}
+
+void test_lifetime() {
+    boost::anys::record_schema schema;
+    schema.add_field(counted(1));
+    schema.add_field(counted(2));
+    BOOST_TEST_EQ(counted::instances, 2);
+    {
+        boost::anys::any_record record(schema);
+        BOOST_TEST_EQ(counted::instances, 4);
+        BOOST_TEST_EQ(record.get<counted>(1).value, 2);
+
+        boost::anys::any_record copy(record);
+        BOOST_TEST_EQ(counted::instances, 6);
+
+        boost::anys::any_record moved(std::move(copy));
+        BOOST_TEST_EQ(counted::instances, 6);
+        BOOST_TEST_EQ(moved.get<counted>(0).value, 1);
+
+        copy = std::move(moved);
+        BOOST_TEST_EQ(counted::instances, 6);
+        BOOST_TEST_EQ(copy.get<counted>(0).value, 1);
+    }
+    BOOST_TEST_EQ(counted::instances, 2);
+}
+
+void test_strong_guarantee() {
+    boost::anys::record_schema schema;
+    schema.add_field(counted(1));
+    schema.add_field(throws_on_copy());
+    schema.add_field(counted(2));
+
+    throws_on_copy::enabled = true;
+    BOOST_TEST_THROWS(boost::anys::any_record{schema}, int);
+    BOOST_TEST_EQ(counted::instances, 2);
+    throws_on_copy::enabled = false;
+
+    boost::anys::any_record record(schema);
+    BOOST_TEST_EQ(counted::instances, 4);
+
+    boost::anys::any_record other(schema);
+    other.get<counted>(0).value = 10;
+    throws_on_copy::enabled = true;
+    BOOST_TEST_THROWS(other = record, int);
+    BOOST_TEST_EQ(other.get<counted>(0).value, 10);
+    throws_on_copy::enabled = false;
+}
+
+void test_over_aligned() {
+    boost::anys::record_schema schema;
+    const std::size_t c = schema.add_field('x');
+    const std::size_t a = schema.add_field(over_aligned{5});
+    BOOST_TEST_EQ(schema.field_offset(a), 32u);
+    BOOST_TEST_EQ(schema.record_alignment(), 32u);
+
+    for (int i = 0; i < 10; ++i) {
+        boost::anys::any_record record(schema);
+        BOOST_TEST_EQ(reinterpret_cast<std::uintptr_t>(&record.get<over_aligned>(a)) % 32, 0u);
+        BOOST_TEST_EQ(record.get<over_aligned>(a).value, 5);
+        BOOST_TEST_EQ(record.get<char>(c), 'x');
+    }
+}
+
+} // namespace
+
+int main() {
+    test_schema_layout();
+    test_record_access();
+    test_empty_schema();
+    test_lifetime();
+    test_strong_guarantee();
+    test_over_aligned();
+
+    return boost::report_errors();
+}
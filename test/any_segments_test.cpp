@@ -0,0 +1,187 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_ANY_USE_HOLDER_VALUE_OPS
+#include <boost/any/any_segments.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct alignas(64) over_aligned {
+    int value;
+};
+
+// Moves throw, so the growth of the segment shall copy
+struct throwing_move {
+    explicit throwing_move(int v) : value(v) {}
+    throwing_move(const throwing_move& other) : value(other.value) {}
+    throwing_move(throwing_move&&) { throw std::runtime_error("move"); }
+    int value;
+};
+
+struct sum_visitor {
+    long long* sum;
+    void operator()(int v) const { *sum += v; }
+    void operator()(const std::string& v) const { *sum += static_cast<long long>(v.size()); }
+};
+
+void test_insert_and_segments() {
+    boost::anys::any_segments c;
+    BOOST_TEST(c.empty());
+    BOOST_TEST(c.segment<int>().empty());
+
+    for (int i = 0; i < 100; ++i) {
+        c.insert(i);
+        c.insert(std::string(static_cast<std::size_t>(i % 7), 'x'));
+    }
+    c.insert(over_aligned{42});
+    BOOST_TEST_EQ(c.size(), 201u);
+    BOOST_TEST_EQ(c.segment_count(), 3u);
+
+    boost::anys::typed_span<int> ints = c.segment<int>();
+    BOOST_TEST_EQ(ints.size(), 100u);
+    for (int i = 0; i < 100; ++i) {
+        BOOST_TEST_EQ(ints[static_cast<std::size_t>(i)], i);
+    }
+    ints[0] = 1000;
+
+    const boost::anys::any_segments& cc = c;
+    boost::anys::typed_span<const int> cints = cc.segment<int>();
+    BOOST_TEST_EQ(cints[0], 1000);
+    BOOST_TEST_EQ(cc.segment<std::string>()[8], "x");
+    BOOST_TEST(cc.segment<double>().empty());
+
+    boost::anys::typed_span<over_aligned> aligned = c.segment<over_aligned>();
+    BOOST_TEST_EQ(aligned.size(), 1u);
+    BOOST_TEST_EQ(reinterpret_cast<std::uintptr_t>(aligned.data()) % 64, 0u);
+    BOOST_TEST_EQ(aligned[0].value, 42);
+}
+
+void test_insert_basic_any() {
+    boost::anys::any_segments c;
+
+    boost::anys::basic_any<> small = 5;
+    boost::anys::basic_any<> large = std::string("large");
+    boost::anys::basic_any<> empty;
+
+    c.insert(std::move(small));
+    c.insert(std::move(large));
+    c.insert(std::move(empty));
+    BOOST_TEST(small.empty());
+    BOOST_TEST(large.empty());
+    BOOST_TEST_EQ(c.size(), 2u);
+
+    const boost::anys::basic_any<64, 8> copied = std::vector<int>(3, 1);
+    c.insert(copied);
+    BOOST_TEST(!copied.empty());
+
+    c.insert(7);
+    BOOST_TEST_EQ(c.segment_count(), 3u);
+    BOOST_TEST_EQ(c.segment<int>().size(), 2u);
+    BOOST_TEST_EQ(c.segment<int>()[0], 5);
+    BOOST_TEST_EQ(c.segment<int>()[1], 7);
+    BOOST_TEST_EQ(c.segment<std::string>()[0], "large");
+    BOOST_TEST_EQ(c.segment<std::vector<int> >()[0].size(), 3u);
+}
+
+void test_for_each() {
+    boost::anys::any_segments c;
+    c.insert(std::string("a"));
+    c.insert(1);
+    c.insert(2.0);
+    c.insert(std::string("bcd"));
+    c.insert(3);
+
+    std::vector<std::string> order;
+    c.for_each([&order](boost::anys::any_ref v) {
+        if (const int* i = boost::any_cast<int>(&v)) {
+            order.push_back(std::to_string(*i));
+        } else if (const std::string* s = boost::any_cast<std::string>(&v)) {
+            order.push_back(*s);
+        } else {
+            order.push_back("?");
+        }
+    });
+    const std::vector<std::string> expected = {"a", "bcd", "1", "3", "?"};
+    BOOST_TEST(order == expected);
+
+    long long sum = 0;
+    c.for_each<int, std::string>(sum_visitor{&sum});
+    BOOST_TEST_EQ(sum, 1 + 3 + 1 + 3);
+
+    c.for_each<int>([](int& v) { v *= 10; });
+    BOOST_TEST_EQ(c.segment<int>()[1], 30);
+
+    const boost::anys::any_segments& cc = c;
+    std::size_t count = 0;
+    cc.for_each([&count](boost::anys::any_cref) { ++count; });
+    BOOST_TEST_EQ(count, 5u);
+
+    sum = 0;
+    cc.for_each<int>([&sum](const int& v) { sum += v; });
+    BOOST_TEST_EQ(sum, 40);
+}
+
+void test_copy_move_clear() {
+    boost::anys::any_segments c;
+    c.insert(std::string(100, 'x'));
+    c.insert(1);
+
+    boost::anys::any_segments copy = c;
+    BOOST_TEST_EQ(copy.size(), 2u);
+    BOOST_TEST_EQ(copy.segment<std::string>()[0], std::string(100, 'x'));
+    BOOST_TEST(copy.segment<std::string>().data() != c.segment<std::string>().data());
+
+    boost::anys::any_segments moved = std::move(c);
+    BOOST_TEST(c.empty());
+    BOOST_TEST(c.segment<int>().empty());
+    BOOST_TEST_EQ(moved.segment<int>()[0], 1);
+
+    moved.clear();
+    BOOST_TEST(moved.empty());
+    BOOST_TEST(moved.segment<int>().empty());
+    moved.insert(2);
+    BOOST_TEST_EQ(moved.segment<int>()[0], 2);
+
+    swap(moved, copy);
+    BOOST_TEST_EQ(moved.size(), 2u);
+    BOOST_TEST_EQ(copy.size(), 1u);
+}
+
+void test_growth_with_throwing_move() {
+#ifndef BOOST_NO_EXCEPTIONS
+    boost::anys::any_segments c;
+    const throwing_move value(7);
+    for (int i = 0; i < 100; ++i) {
+        c.insert(value);
+    }
+    BOOST_TEST_EQ(c.size(), 100u);
+    for (const throwing_move& v : c.segment<throwing_move>()) {
+        BOOST_TEST_EQ(v.value, 7);
+    }
+
+    BOOST_TEST_THROWS(c.insert(throwing_move(1)), std::runtime_error);
+    BOOST_TEST_EQ(c.size(), 100u);
+#endif
+}
+
+}
+
+int main() {
+    test_insert_and_segments();
+    test_insert_basic_any();
+    test_for_each();
+    test_copy_move_clear();
+    test_growth_with_throwing_move();
+
+    return boost::report_errors();
+}
@@ -0,0 +1,202 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_ANY_USE_HOLDER_VALUE_OPS
+#include <boost/any/any_table.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+struct counted {
+    static int instances;
+
+    explicit counted(int v) : value(v) { ++instances; }
+    counted(const counted& other) : value(other.value) { ++instances; }
+    ~counted() { --instances; }
+
+    int value;
+};
+
+int counted::instances = 0;
+
+struct throws_on_copy {
+    static bool enabled;
+
+    throws_on_copy() = default;
+    throws_on_copy(throws_on_copy&&) = default;
+    throws_on_copy(const throws_on_copy&) {
+        if (enabled) {
+            throw 42;
+        }
+    }
+};
+
+bool throws_on_copy::enabled = false;
+
+struct alignas(32) over_aligned {
+    int value;
+};
+
+void test_columns_and_rows() {
+    boost::anys::any_table table;
+    BOOST_TEST_EQ(table.column_count(), 0u);
+    BOOST_TEST_EQ(table.row_count(), 0u);
+
+    const std::size_t price = table.add_column(boost::anys::basic_any<>(0.0));
+    const std::size_t name = table.add_column(std::string("none"));
+    BOOST_TEST_EQ(price, 0u);
+    BOOST_TEST_EQ(name, 1u);
+    BOOST_TEST(table.column_type(price) == boost::typeindex::type_id<double>());
+    BOOST_TEST(table.column_type(name) == boost::typeindex::type_id<std::string>());
+
+    table.emplace_row(9.5, std::string("apple"));
+    table.emplace_row(0.5, std::string("nut"));
+    table.push_row();
+    BOOST_TEST_EQ(table.row_count(), 3u);
+
+    double total = 0;
+    for (double p : table.column<double>(price)) {
+        total += p;
+    }
+    BOOST_TEST_EQ(total, 10.0);
+    BOOST_TEST_EQ(table.column<std::string>(name)[2], "none");
+
+    auto row = table.row(1);
+    BOOST_TEST_EQ(row.size(), 2u);
+    BOOST_TEST_EQ(row.index(), 1u);
+    BOOST_TEST_EQ(boost::any_cast<std::string&>(row[name]), "nut");
+    boost::any_cast<double&>(row[price]) = 2.0;
+    BOOST_TEST_EQ(table.column<double>(price)[1], 2.0);
+
+    const boost::anys::any_table& ctable = table;
+    BOOST_TEST_EQ(boost::any_cast<double>(ctable.cell(1, price)), 2.0);
+    BOOST_TEST_EQ(boost::any_cast<const std::string&>(ctable.row(0)[name]), "apple");
+    BOOST_TEST_EQ(ctable.column<std::string>(name).size(), 3u);
+
+    table.pop_row();
+    BOOST_TEST_EQ(table.row_count(), 2u);
+    BOOST_TEST_EQ(table.column<std::string>(name).size(), 2u);
+}
+
+void test_column_for_existing_rows() {
+    boost::anys::any_table table;
+    table.add_column(1);
+    table.push_row();
+    table.push_row();
+
+    const std::size_t c = table.add_column(std::string("filled"));
+    BOOST_TEST_EQ(table.column<std::string>(c).size(), 2u);
+    BOOST_TEST_EQ(table.column<std::string>(c)[1], "filled");
+
+    table.reserve_rows(100);
+    table.clear_rows();
+    BOOST_TEST_EQ(table.row_count(), 0u);
+    BOOST_TEST_EQ(table.column_count(), 2u);
+    BOOST_TEST(table.column<int>(0).empty());
+}
+
+void test_errors() {
+    boost::anys::any_table table;
+    BOOST_TEST_THROWS(table.add_column(boost::anys::basic_any<>()), boost::bad_any_cast);
+
+    table.add_column(1);
+    table.add_column(std::string());
+    BOOST_TEST_THROWS(table.emplace_row(1), std::invalid_argument);
+    BOOST_TEST_THROWS(table.emplace_row(1, 2), boost::bad_any_cast);
+    BOOST_TEST_THROWS(table.emplace_row(1, std::string(), 3), std::invalid_argument);
+    BOOST_TEST_EQ(table.row_count(), 0u);
+    BOOST_TEST(table.column<int>(0).empty());
+
+    table.emplace_row(1, std::string("a"));
+    BOOST_TEST_THROWS(table.column<long>(0), boost::bad_any_cast);
+    BOOST_TEST_THROWS(table.column<std::string>(0), boost::bad_any_cast);
+}
+
+void test_strong_guarantee() {
+    boost::anys::any_table table;
+    table.add_column(std::string("x"));
+    table.add_column(throws_on_copy());
+    table.push_row();
+
+    throws_on_copy::enabled = true;
+    BOOST_TEST_THROWS(table.push_row(), int);
+    BOOST_TEST_EQ(table.row_count(), 1u);
+    BOOST_TEST_EQ(table.column<std::string>(0).size(), 1u);
+
+    const throws_on_copy value;
+    BOOST_TEST_THROWS(table.emplace_row(std::string("y"), value), int);
+    BOOST_TEST_EQ(table.column<std::string>(0).size(), 1u);
+
+    BOOST_TEST_THROWS(table.add_column(throws_on_copy()), int);
+    BOOST_TEST_EQ(table.column_count(), 2u);
+    throws_on_copy::enabled = false;
+
+    table.emplace_row(std::string("y"), throws_on_copy());
+    BOOST_TEST_EQ(table.row_count(), 2u);
+}
+
+void test_lifetime() {
+    {
+        boost::anys::any_table table;
+        table.add_column(counted(0));
+        for (int i = 0; i < 10; ++i) {
+            table.emplace_row(counted(i));
+        }
+        BOOST_TEST_EQ(counted::instances, 11);
+        BOOST_TEST_EQ(table.column<counted>(0)[7].value, 7);
+
+        boost::anys::any_table copy(table);
+        BOOST_TEST_EQ(counted::instances, 22);
+        BOOST_TEST_EQ(copy.column<counted>(0)[9].value, 9);
+
+        boost::anys::any_table moved(std::move(copy));
+        BOOST_TEST_EQ(counted::instances, 22);
+        BOOST_TEST_EQ(copy.column_count(), 0u);
+        BOOST_TEST_EQ(moved.row_count(), 10u);
+
+        moved = table;
+        BOOST_TEST_EQ(counted::instances, 22);
+        table.clear_rows();
+        BOOST_TEST_EQ(counted::instances, 12);
+
+        swap(table, moved);
+        BOOST_TEST_EQ(table.row_count(), 10u);
+        BOOST_TEST_EQ(moved.row_count(), 0u);
+    }
+    BOOST_TEST_EQ(counted::instances, 0);
+}
+
+void test_over_aligned() {
+    boost::anys::any_table table;
+    table.add_column(over_aligned{0});
+    for (int i = 0; i < 20; ++i) {
+        table.emplace_row(over_aligned{i});
+    }
+
+    const auto column = table.column<over_aligned>(0);
+    for (std::size_t i = 0; i < column.size(); ++i) {
+        BOOST_TEST_EQ(reinterpret_cast<std::uintptr_t>(&column[i]) % 32, 0u);
+        BOOST_TEST_EQ(column[i].value, static_cast<int>(i));
+    }
+}
+
+} // namespace
+
+int main() {
+    test_columns_and_rows();
+    test_column_for_existing_rows();
+    test_errors();
+    test_strong_guarantee();
+    test_lifetime();
+    test_over_aligned();
+
+    return boost::report_errors();
+}
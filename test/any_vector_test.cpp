@@ -0,0 +1,209 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/any/any_vector.hpp>
+#include <boost/any/try_any_cast.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct counted {
+    static int instances;
+
+    explicit counted(int v) noexcept : value(v) { ++instances; }
+    counted(const counted& other) noexcept : value(other.value) { ++instances; }
+    counted(counted&& other) noexcept : value(other.value) { other.value = -1; ++instances; }
+    ~counted() { --instances; }
+
+    int value;
+};
+
+int counted::instances = 0;
+
+struct alignas(16) aligned16 {
+    char data[3];
+};
+
+void test_push_and_iterate() {
+    boost::anys::any_vector v;
+    BOOST_TEST(v.empty());
+    BOOST_TEST(v.begin() == v.end());
+
+    v.push_back(1);
+    v.push_back('c');
+    v.push_back(std::string("hello"));
+    v.emplace_back<std::vector<int> >(3u, 7);
+    v.push_back(aligned16{{'a', 'b', 'c'}});
+    v.push_back(2.5);
+    BOOST_TEST_EQ(v.size(), 6u);
+
+    auto it = v.begin();
+    boost::anys::any_ref first = *it;
+    BOOST_TEST_EQ(boost::any_cast<int>(first), 1);
+    BOOST_TEST(!boost::any_cast<char>(&first));
+    ++it;
+    BOOST_TEST_EQ(boost::any_cast<char>(*it), 'c');
+    ++it;
+    boost::anys::any_ref s = *it;
+    BOOST_TEST(s.type() == boost::typeindex::type_id<std::string>());
+    boost::any_cast<std::string&>(s) += " world";
+    ++it;
+    BOOST_TEST_EQ(boost::any_cast<const std::vector<int>&>(*it).size(), 3u);
+    ++it;
+    const aligned16* a = boost::any_cast<aligned16>(&static_cast<const boost::anys::any_ref&>(*it));
+    BOOST_TEST(a);
+    BOOST_TEST_EQ(reinterpret_cast<std::uintptr_t>(a) % 16, 0u);
+    BOOST_TEST_EQ(a->data[2], 'c');
+    ++it;
+    BOOST_TEST_EQ(boost::any_cast<double>(*it), 2.5);
+    BOOST_TEST_THROWS(boost::any_cast<float>(*it), boost::bad_any_cast);
+    ++it;
+    BOOST_TEST(it == v.end());
+
+    const boost::anys::any_vector& cv = v;
+    std::size_t count = 0;
+    for (boost::anys::any_cref element : cv) {
+        BOOST_TEST(!element.empty());
+        ++count;
+    }
+    BOOST_TEST_EQ(count, 6u);
+    BOOST_TEST_EQ(boost::any_cast<int>(cv.front()), 1);
+
+    auto cit = cv.begin();
+    ++cit; ++cit;
+    const boost::anys::any_cref third = *cit;
+    BOOST_TEST_EQ(boost::any_cast<const std::string&>(third), "hello world");
+    BOOST_TEST_EQ(boost::try_any_cast<std::string>(third).value_or(""), "hello world");
+}
+
+void test_growth_and_copy() {
+    {
+        boost::anys::any_vector v;
+        for (int i = 0; i < 1000; ++i) {
+            if (i % 3) {
+                v.emplace_back<counted>(i);
+            } else {
+                v.push_back(std::string(static_cast<std::size_t>(i % 50), 'x'));
+            }
+        }
+        BOOST_TEST_EQ(v.size(), 1000u);
+        BOOST_TEST_EQ(counted::instances, 666);
+        BOOST_TEST(v.size_bytes() <= v.capacity_bytes());
+
+        boost::anys::any_vector copy = v;
+        BOOST_TEST_EQ(counted::instances, 666 * 2);
+
+        int i = 0;
+        for (boost::anys::any_cref element : copy) {
+            if (i % 3) {
+                BOOST_TEST_EQ(boost::any_cast<const counted&>(element).value, i);
+            } else {
+                BOOST_TEST_EQ(boost::any_cast<const std::string&>(element).size(), static_cast<std::size_t>(i % 50));
+            }
+            ++i;
+        }
+
+        boost::anys::any_vector moved = std::move(v);
+        BOOST_TEST(v.empty());
+        BOOST_TEST_EQ(moved.size(), 1000u);
+        BOOST_TEST_EQ(counted::instances, 666 * 2);
+
+        v = copy;
+        BOOST_TEST_EQ(counted::instances, 666 * 3);
+        swap(v, moved);
+
+        copy.clear();
+        BOOST_TEST(copy.empty());
+        BOOST_TEST_EQ(counted::instances, 666 * 2);
+    }
+    BOOST_TEST_EQ(counted::instances, 0);
+}
+
+void test_erase() {
+    {
+        boost::anys::any_vector v;
+        v.push_back(static_cast<char>(1));
+        v.emplace_back<counted>(2);
+        v.push_back(std::string(100, 'a'));  // overlaps with itself after erasing a char
+        v.push_back(aligned16{{'x', 'y', 'z'}});
+        v.emplace_back<counted>(5);
+
+        auto it = v.erase(v.begin());
+        BOOST_TEST_EQ(v.size(), 4u);
+        BOOST_TEST_EQ(boost::any_cast<counted&>(*it).value, 2);
+        BOOST_TEST_EQ(counted::instances, 2);
+
+        ++it;
+        BOOST_TEST_EQ(boost::any_cast<std::string&>(*it), std::string(100, 'a'));
+        ++it;
+        const aligned16* a = boost::any_cast<aligned16>(&static_cast<const boost::anys::any_ref&>(*it));
+        BOOST_TEST(a);
+        BOOST_TEST_EQ(reinterpret_cast<std::uintptr_t>(a) % 16, 0u);
+        BOOST_TEST_EQ(a->data[0], 'x');
+
+        it = v.begin();
+        ++it;
+        auto last = it;
+        ++last; ++last;
+        it = v.erase(it, last);
+        BOOST_TEST_EQ(v.size(), 2u);
+        BOOST_TEST_EQ(boost::any_cast<counted&>(*it).value, 5);
+        BOOST_TEST_EQ(boost::any_cast<counted&>(v.front()).value, 2);
+
+        it = v.erase(it);
+        BOOST_TEST(it == v.end());
+        BOOST_TEST_EQ(counted::instances, 1);
+
+        v.push_back(std::string("tail"));
+        BOOST_TEST_EQ(v.size(), 2u);
+        it = v.begin();
+        ++it;
+        BOOST_TEST_EQ(boost::any_cast<std::string&>(*it), "tail");
+
+        it = v.erase(v.begin(), v.end());
+        BOOST_TEST(it == v.end());
+        BOOST_TEST(v.empty());
+        BOOST_TEST_EQ(v.size_bytes(), 0u);
+        BOOST_TEST_EQ(counted::instances, 0);
+
+        v.emplace_back<counted>(7);
+    }
+    BOOST_TEST_EQ(counted::instances, 0);
+}
+
+void test_any_ref() {
+    int i = 5;
+    boost::anys::any_ref r(i);
+    BOOST_TEST(r.type() == boost::typeindex::type_id<int>());
+    boost::any_cast<int&>(r) = 6;
+    BOOST_TEST_EQ(i, 6);
+
+    boost::anys::any_cref cr = r;
+    BOOST_TEST_EQ(boost::any_cast<int>(cr), 6);
+    BOOST_TEST(!boost::any_cast<long>(&cr));
+
+    boost::anys::any_ref empty;
+    BOOST_TEST(empty.empty());
+    BOOST_TEST(empty.type() == boost::typeindex::type_id<void>());
+    BOOST_TEST(!boost::any_cast<int>(&empty));
+    BOOST_TEST(boost::try_any_cast<int>(empty).error() == boost::anys::any_cast_error::empty);
+}
+
+}
+
+int main() {
+    test_push_and_iterate();
+    test_growth_and_copy();
+    test_erase();
+    test_any_ref();
+
+    return boost::report_errors();
+}
@@ -0,0 +1,169 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/any/atomic_any.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct counted {
+    static std::atomic<int> alive;
+
+    explicit counted(int v) : value(v) { ++alive; }
+    counted(const counted& other) : value(other.value) { ++alive; }
+    ~counted() { --alive; }
+
+    int value;
+};
+
+std::atomic<int> counted::alive{0};
+
+void test_basics() {
+    boost::anys::atomic_any empty;
+    BOOST_TEST(empty.load()->empty());
+    BOOST_TEST(boost::anys::atomic_any::is_lock_free());
+
+    boost::anys::atomic_any value{boost::any(std::string("first"))};
+    const boost::anys::any_snapshot first = value.load();
+    BOOST_TEST_EQ(boost::any_cast<const std::string&>(*first), "first");
+    BOOST_TEST(first == value.load());
+
+    value.store(std::string("second"));
+    BOOST_TEST_EQ(boost::any_cast<const std::string&>(*first), "first");
+    BOOST_TEST_EQ(boost::any_cast<const std::string&>(*value.load()), "second");
+    BOOST_TEST(first != value.load());
+
+    const boost::anys::any_snapshot previous = value.exchange(42);
+    BOOST_TEST_EQ(boost::any_cast<const std::string&>(*previous), "second");
+    BOOST_TEST_EQ(boost::any_cast<int>(*value.load()), 42);
+
+    boost::anys::any_snapshot copy = first;
+    boost::anys::any_snapshot moved = std::move(copy);
+    BOOST_TEST(copy->empty());
+    BOOST_TEST(moved == first);
+    swap(copy, moved);
+    BOOST_TEST(copy == first);
+    BOOST_TEST(moved->empty());
+
+    BOOST_TEST(empty.visit([](const boost::any& v) { return v.empty(); }));
+    BOOST_TEST_EQ(value.visit([](const boost::any& v) { return boost::any_cast<int>(v); }), 42);
+#ifndef BOOST_NO_EXCEPTIONS
+    BOOST_TEST_THROWS(value.visit([](const boost::any&) -> int { throw 1; }), int);
+#endif
+}
+
+void test_compare_exchange() {
+    boost::anys::atomic_any value{boost::any(1)};
+    boost::anys::any_snapshot expected = value.load();
+
+    boost::any desired = 2;
+    BOOST_TEST(value.compare_exchange(expected, std::move(desired)));
+    BOOST_TEST_EQ(boost::any_cast<int>(*value.load()), 2);
+    BOOST_TEST_EQ(boost::any_cast<int>(*expected), 1);
+
+    desired = 3;
+    BOOST_TEST(!value.compare_exchange(expected, std::move(desired)));
+    BOOST_TEST_EQ(boost::any_cast<int>(desired), 3);
+    BOOST_TEST_EQ(boost::any_cast<int>(*expected), 2);
+    BOOST_TEST(value.compare_exchange(expected, std::move(desired)));
+    BOOST_TEST_EQ(boost::any_cast<int>(*value.load()), 3);
+
+    boost::anys::atomic_any empty;
+    boost::anys::any_snapshot nothing;
+    desired = 4;
+    BOOST_TEST(empty.compare_exchange(nothing, std::move(desired)));
+    BOOST_TEST_EQ(boost::any_cast<int>(*empty.load()), 4);
+}
+
+void test_lifetime() {
+    {
+        boost::anys::atomic_any value{boost::any(counted(0))};
+        boost::anys::any_snapshot kept = value.load();
+        value.store(counted(1));
+        BOOST_TEST_EQ(counted::alive.load(), 2);
+        kept = boost::anys::any_snapshot();
+        BOOST_TEST_EQ(counted::alive.load(), 1);
+    }
+    BOOST_TEST_EQ(counted::alive.load(), 0);
+}
+
+void test_concurrent() {
+    constexpr int writes = 2000;
+    {
+        boost::anys::atomic_any value{boost::any(counted(0))};
+        std::atomic<bool> done{false};
+        std::atomic<int> failures{0};
+
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 4; ++t) {
+            readers.emplace_back([&value, &done, &failures, t]() {
+                int last = 0;
+                while (!done.load()) {
+                    const int current = (t % 2)
+                        ? value.visit([](const boost::any& v) { return boost::any_cast<const counted&>(v).value; })
+                        : boost::any_cast<const counted&>(*value.load()).value;
+                    if (current < last) {
+                        ++failures;
+                    }
+                    last = current;
+                }
+            });
+        }
+
+        std::thread incrementer([&value]() {
+            for (int i = 0; i < writes; ++i) {
+                boost::anys::any_snapshot expected = value.load();
+                for (;;) {
+                    boost::any desired = counted(boost::any_cast<const counted&>(*expected).value + 1);
+                    if (value.compare_exchange(expected, std::move(desired))) {
+                        break;
+                    }
+                }
+            }
+        });
+
+        for (int i = 0; i < writes; ++i) {
+            boost::anys::any_snapshot expected = value.load();
+            for (;;) {
+                boost::any desired = counted(boost::any_cast<const counted&>(*expected).value + 1);
+                if (value.compare_exchange(expected, std::move(desired))) {
+                    break;
+                }
+            }
+        }
+
+        incrementer.join();
+        done = true;
+        for (std::thread& t : readers) {
+            t.join();
+        }
+
+        BOOST_TEST_EQ(failures.load(), 0);
+        BOOST_TEST_EQ(boost::any_cast<const counted&>(*value.load()).value, 2 * writes);
+    }
+
+    // Values protected at the moment of the last release wait for
+    // reclaim_retired()
+    boost::anys::reclaim_retired();
+    BOOST_TEST_EQ(counted::alive.load(), 0);
+}
+
+} // anonymous namespace
+
+int main() {
+    test_basics();
+    test_compare_exchange();
+    test_lifetime();
+    test_concurrent();
+
+    return boost::report_errors();
+}
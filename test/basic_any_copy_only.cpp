@@ -0,0 +1,27 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/any/basic_any.hpp>
+
+// Copy constructible type with a deleted move constructor
+struct copy_only {
+    copy_only() = default;
+    copy_only(const copy_only&) = default;
+    copy_only(copy_only&&) = delete;
+    copy_only& operator=(const copy_only&) = default;
+
+    long long value[2] = {1, 2};
+};
+
+int main()
+{
+    const copy_only c;
+    boost::anys::basic_any<8, 8> a(c);
+    boost::anys::basic_any<8, 8> b(a);
+    b = a;
+    boost::anys::basic_any<8, 8> moved(std::move(a));
+    return boost::anys::any_cast<const copy_only&>(b).value[1] == 2 ? 0 : 1;
+}
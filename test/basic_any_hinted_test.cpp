@@ -0,0 +1,133 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/any/basic_any_hinted.hpp>
+#include "basic_test.hpp"
+#include "move_test.hpp"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+using hinted = boost::anys::basic_any_hinted<16, 8, int, std::string, std::vector<int>, any_tests::huge_structure>;
+
+struct visitor {
+    int operator()(int v) const { return v; }
+    int operator()(const std::string& v) const { return static_cast<int>(v.size()); }
+    int operator()(const std::vector<int>& v) const { return static_cast<int>(v.size()) * 10; }
+    int operator()(const any_tests::huge_structure&) const { return 1024; }
+    int operator()(const hinted& v) const { return v.empty() ? -1 : -2; }
+};
+
+struct incrementer {
+    void operator()(int& v) const { ++v; }
+    void operator()(std::string& v) const { v += '!'; }
+    void operator()(std::vector<int>& v) const { v.push_back(0); }
+    void operator()(any_tests::huge_structure&) const {}
+    void operator()(hinted&) const {}
+};
+
+void test_hint_index() {
+    hinted a;
+    BOOST_TEST_EQ(a.hint_index(), 0u);
+
+    a = 42;
+    BOOST_TEST_EQ(a.hint_index(), 1u);
+    BOOST_TEST_EQ(boost::any_cast<int>(a), 42);
+    BOOST_TEST(!boost::any_cast<std::string>(&a));
+
+    a = std::string("hello");
+    BOOST_TEST_EQ(a.hint_index(), 2u);
+    BOOST_TEST_EQ(boost::any_cast<const std::string&>(a), "hello");
+    BOOST_TEST(!boost::any_cast<int>(&a));
+
+    a = std::vector<int>(3, 7);
+    BOOST_TEST_EQ(a.hint_index(), 3u);
+    BOOST_TEST_EQ(boost::any_cast<std::vector<int>&>(a).size(), 3u);
+
+    a = 'c';
+    BOOST_TEST_EQ(a.hint_index(), 0u);
+    BOOST_TEST_EQ(boost::any_cast<char>(a), 'c');
+    BOOST_TEST(!boost::any_cast<int>(&a));
+
+    hinted b = std::move(a);
+    BOOST_TEST(a.empty());
+    BOOST_TEST_EQ(a.hint_index(), 0u);
+    BOOST_TEST_EQ(b.hint_index(), 0u);
+    BOOST_TEST_EQ(boost::any_cast<char>(b), 'c');
+
+    a = std::string("world");
+    b = a;
+    BOOST_TEST_EQ(b.hint_index(), 2u);
+    BOOST_TEST_EQ(boost::any_cast<std::string>(b), "world");
+
+    b.clear();
+    BOOST_TEST_EQ(b.hint_index(), 0u);
+    BOOST_TEST(!boost::any_cast<std::string>(&b));
+}
+
+void test_swap_keeps_hints() {
+    hinted a = 42;
+    hinted b = any_tests::huge_structure();
+    a.swap(b);
+    BOOST_TEST_EQ(a.hint_index(), 4u);
+    BOOST_TEST_EQ(b.hint_index(), 1u);
+    BOOST_TEST(boost::any_cast<any_tests::huge_structure>(&a));
+    BOOST_TEST_EQ(boost::any_cast<int>(b), 42);
+
+    hinted c;
+    swap(b, c);
+    BOOST_TEST(b.empty());
+    BOOST_TEST_EQ(b.hint_index(), 0u);
+    BOOST_TEST_EQ(c.hint_index(), 1u);
+}
+
+void test_visit() {
+    hinted a;
+    BOOST_TEST_EQ(boost::anys::visit(visitor(), a), -1);
+
+    a = 42;
+    BOOST_TEST_EQ(boost::anys::visit(visitor(), a), 42);
+    boost::anys::visit(incrementer(), a);
+    BOOST_TEST_EQ(boost::any_cast<int>(a), 43);
+
+    a = std::string("abc");
+    BOOST_TEST_EQ(boost::anys::visit(visitor(), a), 3);
+    boost::anys::visit(incrementer(), a);
+    BOOST_TEST_EQ(boost::any_cast<std::string>(a), "abc!");
+
+    a = std::vector<int>(2, 1);
+    const hinted& ca = a;
+    BOOST_TEST_EQ(boost::anys::visit(visitor(), ca), 20);
+
+    a = any_tests::huge_structure();
+    BOOST_TEST_EQ(boost::anys::visit(visitor(), a), 1024);
+
+    a = 1.0;
+    BOOST_TEST_EQ(boost::anys::visit(visitor(), a), -2);
+}
+
+}
+
+int main() {
+    test_hint_index();
+    test_swap_keeps_hints();
+    test_visit();
+
+    if (boost::report_errors()) return 1;
+
+    const int res1 = any_tests::basic_tests<hinted>::run_tests();
+    if (res1) return 2;
+
+    const int res2 = any_tests::basic_tests<boost::anys::basic_any_hinted<8, 8> >::run_tests();
+    if (res2) return 3;
+
+    const int res3 = any_tests::move_tests<hinted>::run_tests();
+    if (res3) return 4;
+
+    return 0;
+}
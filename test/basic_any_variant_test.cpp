@@ -0,0 +1,128 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/any/variant.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#ifndef BOOST_NO_CXX17_HDR_VARIANT
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/any.hpp>
+#include <boost/any/unique_any.hpp>
+
+namespace {
+
+using any_t = boost::anys::basic_any<32, 8>;
+
+struct move_counter {
+    static int moves;
+    static int copies;
+
+    move_counter() = default;
+    move_counter(const move_counter&) { ++copies; }
+    move_counter(move_counter&&) noexcept { ++moves; }
+};
+
+int move_counter::moves = 0;
+int move_counter::copies = 0;
+
+void test_to_variant() {
+    any_t a = 42;
+    auto v1 = boost::anys::to_variant<std::string, int, double>(std::move(a));
+    BOOST_TEST(a.empty());
+    BOOST_TEST_EQ(v1.index(), 1u);
+    BOOST_TEST_EQ(std::get<int>(v1), 42);
+
+    a = std::string("text");
+    auto v2 = boost::anys::to_variant<std::string, int, double>(std::move(a));
+    BOOST_TEST(a.empty());
+    BOOST_TEST_EQ(std::get<std::string>(v2), "text");
+
+    a = std::vector<int>(100, 1);  // does not fit the buffer
+    auto v3 = boost::anys::to_variant<int, std::vector<int>>(std::move(a));
+    BOOST_TEST(a.empty());
+    BOOST_TEST_EQ(std::get<std::vector<int>>(v3).size(), 100u);
+
+    a = 'c';
+    BOOST_TEST_THROWS((boost::anys::to_variant<int, double>(std::move(a))), boost::bad_any_cast);
+    BOOST_TEST_EQ(boost::any_cast<char>(a), 'c');
+}
+
+void test_to_variant_empty() {
+    any_t a;
+    auto v = boost::anys::to_variant<int, std::monostate, std::string>(std::move(a));
+    BOOST_TEST_EQ(v.index(), 1u);
+
+    BOOST_TEST_THROWS((boost::anys::to_variant<int, std::string>(std::move(a))), boost::bad_any_cast);
+}
+
+void test_to_variant_moves_once() {
+    any_t a = move_counter();
+    move_counter::moves = 0;
+    move_counter::copies = 0;
+
+    auto v = boost::anys::to_variant<int, move_counter>(std::move(a));
+    BOOST_TEST_EQ(v.index(), 1u);
+    BOOST_TEST_EQ(move_counter::moves, 1);
+    BOOST_TEST_EQ(move_counter::copies, 0);
+}
+
+void test_from_variant() {
+    std::variant<std::monostate, int, std::string> v = std::string("text");
+    any_t a = boost::anys::from_variant<any_t>(std::move(v));
+    BOOST_TEST_EQ(boost::any_cast<std::string>(a), "text");
+
+    v = 7;
+    a = boost::anys::from_variant<any_t>(v);
+    BOOST_TEST_EQ(boost::any_cast<int>(a), 7);
+
+    v = std::monostate();
+    a = boost::anys::from_variant<any_t>(v);
+    BOOST_TEST(a.empty());
+
+    std::variant<int, std::unique_ptr<int>> u = std::unique_ptr<int>(new int(5));
+    boost::anys::unique_any ua = boost::anys::from_variant<boost::anys::unique_any>(std::move(u));
+    BOOST_TEST_EQ(*boost::any_cast<std::unique_ptr<int>&>(ua), 5);
+
+    std::variant<double> d = 1.0;
+    boost::any ba = boost::anys::from_variant<boost::any>(d);
+    BOOST_TEST_EQ(boost::any_cast<double>(ba), 1.0);
+}
+
+void test_from_variant_moves_once() {
+    std::variant<int, move_counter> v{std::in_place_index<1>};
+    move_counter::moves = 0;
+    move_counter::copies = 0;
+
+    any_t a = boost::anys::from_variant<any_t>(std::move(v));
+    BOOST_TEST(boost::any_cast<move_counter>(&a));
+    BOOST_TEST_EQ(move_counter::moves, 1);
+    BOOST_TEST_EQ(move_counter::copies, 0);
+}
+
+}
+
+int main() {
+    test_to_variant();
+    test_to_variant_empty();
+    test_to_variant_moves_once();
+    test_from_variant();
+    test_from_variant_moves_once();
+
+    return boost::report_errors();
+}
+
+#else
+
+int main() {
+    return boost::report_errors();
+}
+
+#endif
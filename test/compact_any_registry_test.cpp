@@ -0,0 +1,66 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_ANY_COMPACT_ANY_MAX_INLINE_TYPES 2
+#include <boost/any/compact_any.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+namespace {
+
+template <int I>
+struct probe {
+    short value;
+};
+
+template <class T>
+bool is_inline(const boost::anys::compact_any& a) {
+    const unsigned char* begin = reinterpret_cast<const unsigned char*>(&a);
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(boost::any_cast<T>(&a));
+    return p && p >= begin && p < begin + sizeof(a);
+}
+
+// Casts to the types that were never stored take no indexes
+void test_casts_do_not_register() {
+    boost::anys::compact_any a;
+    BOOST_TEST(!boost::any_cast<probe<0>>(&a));
+    BOOST_TEST(!boost::any_cast<probe<1>>(&a));
+    BOOST_TEST(!boost::any_cast<probe<2>>(&a));
+
+    a = probe<3>{3};
+    BOOST_TEST(!boost::any_cast<probe<4>>(&a));
+    BOOST_TEST(!boost::any_cast<probe<5>>(&a));
+
+    boost::anys::compact_any b = probe<6>{6};
+    BOOST_TEST(is_inline<probe<3>>(a));
+    BOOST_TEST(is_inline<probe<6>>(b));
+    BOOST_TEST_EQ(boost::any_cast<probe<3>>(a).value, 3);
+    BOOST_TEST_EQ(boost::any_cast<probe<6>>(b).value, 6);
+    BOOST_TEST(b.type() == boost::typeindex::type_id<probe<6>>());
+}
+
+// Types stored after the registry is full go to the heap
+void test_full_registry() {
+    boost::anys::compact_any a = probe<7>{7};
+    BOOST_TEST(!is_inline<probe<7>>(a));
+    BOOST_TEST_EQ(boost::any_cast<probe<7>>(a).value, 7);
+    BOOST_TEST(!boost::any_cast<probe<3>>(&a));
+    BOOST_TEST(a.type() == boost::typeindex::type_id<probe<7>>());
+
+    a = probe<3>{30};
+    BOOST_TEST(is_inline<probe<3>>(a));
+    BOOST_TEST(!boost::any_cast<probe<7>>(&a));
+    BOOST_TEST_EQ(boost::any_cast<probe<3>>(a).value, 30);
+}
+
+} // anonymous namespace
+
+int main() {
+    test_casts_do_not_register();
+    test_full_registry();
+
+    return boost::report_errors();
+}
@@ -0,0 +1,101 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/any/compact_any.hpp>
+#include "basic_test.hpp"
+#include "move_test.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace {
+
+struct rgb {
+    unsigned char r, g, b;
+};
+
+template <class T>
+bool is_inline(const boost::anys::compact_any& a) {
+    const unsigned char* begin = reinterpret_cast<const unsigned char*>(&a);
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(boost::any_cast<T>(&a));
+    return p && p >= begin && p < begin + sizeof(a);
+}
+
+void test_size() {
+    BOOST_TEST_EQ(sizeof(boost::anys::compact_any), 8u);
+}
+
+void test_inline_values() {
+    boost::anys::compact_any a = 42;
+    BOOST_TEST(is_inline<int>(a));
+    BOOST_TEST_EQ(boost::any_cast<int>(a), 42);
+    BOOST_TEST(!boost::any_cast<unsigned>(&a));
+    BOOST_TEST(!boost::any_cast<float>(&a));
+    BOOST_TEST(a.type() == boost::typeindex::type_id<int>());
+
+    a = static_cast<short>(-7);
+    BOOST_TEST(is_inline<short>(a));
+    BOOST_TEST_EQ(boost::any_cast<short>(a), -7);
+    BOOST_TEST(!boost::any_cast<int>(&a));
+
+    a = 1.5f;
+    BOOST_TEST(is_inline<float>(a));
+    BOOST_TEST_EQ(boost::any_cast<float>(a), 1.5f);
+
+    rgb color = {1, 2, 3};
+    a = color;
+    BOOST_TEST(is_inline<rgb>(a));
+    BOOST_TEST_EQ(boost::any_cast<rgb&>(a).b, 3);
+    BOOST_TEST(a.type() == boost::typeindex::type_id<rgb>());
+
+    boost::anys::compact_any b = a;
+    BOOST_TEST(is_inline<rgb>(b));
+    BOOST_TEST_EQ(boost::any_cast<rgb&>(b).g, 2);
+    boost::any_cast<rgb&>(b).g = 20;
+    BOOST_TEST_EQ(boost::any_cast<rgb&>(a).g, 2);
+
+    boost::anys::compact_any c = std::move(b);
+    BOOST_TEST(b.empty());
+    BOOST_TEST_EQ(boost::any_cast<rgb&>(c).g, 20);
+}
+
+void test_heap_values() {
+    boost::anys::compact_any a = std::string("long enough string to not fit into 8 bytes");
+    BOOST_TEST(!is_inline<std::string>(a));
+    BOOST_TEST_EQ(boost::any_cast<std::string>(a), "long enough string to not fit into 8 bytes");
+    BOOST_TEST(!boost::any_cast<int>(&a));
+
+    a = static_cast<std::uint64_t>(1) << 60;
+    BOOST_TEST(!is_inline<std::uint64_t>(a));
+    BOOST_TEST_EQ(boost::any_cast<std::uint64_t>(a), static_cast<std::uint64_t>(1) << 60);
+
+    boost::anys::compact_any b = 42;
+    a.swap(b);
+    BOOST_TEST_EQ(boost::any_cast<int>(a), 42);
+    BOOST_TEST_EQ(boost::any_cast<std::uint64_t>(b), static_cast<std::uint64_t>(1) << 60);
+
+    b.clear();
+    BOOST_TEST(b.empty());
+    BOOST_TEST(b.type() == boost::typeindex::type_id<void>());
+}
+
+}
+
+int main() {
+    test_size();
+    test_inline_values();
+    test_heap_values();
+
+    if (boost::report_errors()) return 1;
+
+    const int res1 = any_tests::basic_tests<boost::anys::compact_any>::run_tests();
+    if (res1) return 2;
+
+    const int res2 = any_tests::move_tests<boost::anys::compact_any>::run_tests();
+    if (res2) return 3;
+
+    return 0;
+}
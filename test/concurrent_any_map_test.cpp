@@ -0,0 +1,185 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/any/concurrent_any_map.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::atomic<int> alive{0};
+
+struct tracked {
+    explicit tracked(int v) : value(v) { ++alive; }
+    tracked(const tracked& other) : value(other.value) { ++alive; }
+    ~tracked() { --alive; }
+    int value;
+};
+
+void test_basics() {
+    boost::anys::concurrent_any_map map(4);
+    BOOST_TEST_EQ(map.size(), 0u);
+    BOOST_TEST(!map.contains("a"));
+    BOOST_TEST(map.find("a")->empty());
+    BOOST_TEST(!map.get<int>("a"));
+
+    BOOST_TEST(map.insert_or_assign("a", 1));
+    BOOST_TEST(map.insert("b", std::string("text")));
+    BOOST_TEST(!map.insert("b", 2));
+    BOOST_TEST_EQ(map.size(), 2u);
+
+    BOOST_TEST_EQ(*map.get<int>("a"), 1);
+    BOOST_TEST(!map.get<double>("a"));
+    BOOST_TEST_EQ(*map.get<std::string>("b"), "text");
+    BOOST_TEST_EQ(map.get<std::string>("b")->size(), 4u);
+    BOOST_TEST_EQ(boost::any_cast<int>(*map.find("a")), 1);
+
+    BOOST_TEST(!map.insert_or_assign("a", 10));
+    BOOST_TEST_EQ(*map.get<int>("a"), 10);
+    BOOST_TEST_EQ(map.size(), 2u);
+
+    BOOST_TEST(map.erase("a"));
+    BOOST_TEST(!map.erase("a"));
+    BOOST_TEST(!map.contains("a"));
+    BOOST_TEST_EQ(map.size(), 1u);
+
+    for (int i = 0; i < 1000; ++i) {
+        map.insert_or_assign("key" + std::to_string(i), i);
+    }
+    BOOST_TEST_EQ(map.size(), 1001u);
+    for (int i = 0; i < 1000; ++i) {
+        BOOST_TEST_EQ(*map.get<int>("key" + std::to_string(i)), i);
+    }
+
+    map.clear();
+    BOOST_TEST_EQ(map.size(), 0u);
+    BOOST_TEST(!map.contains("b"));
+}
+
+void test_snapshot_lifetime() {
+    {
+        boost::anys::concurrent_any_map map;
+        map.insert_or_assign("value", tracked(1));
+        const boost::anys::typed_snapshot<tracked> kept = map.get<tracked>("value");
+
+        map.insert_or_assign("value", tracked(2));
+        BOOST_TEST_EQ(kept->value, 1);
+        BOOST_TEST_EQ(map.get<tracked>("value")->value, 2);
+
+        map.erase("value");
+        BOOST_TEST_EQ(kept->value, 1);
+        BOOST_TEST(!map.contains("value"));
+
+        map.insert_or_assign("other", tracked(3));
+    }
+
+    boost::anys::reclaim_retired();
+    BOOST_TEST_EQ(alive.load(), 0);
+}
+
+void test_visit() {
+    boost::anys::concurrent_any_map map(4);
+    int seen = 0;
+    BOOST_TEST(!map.visit("a", [&seen](const boost::any&) { ++seen; }));
+    BOOST_TEST_EQ(seen, 0);
+
+    map.insert_or_assign("a", 5);
+    BOOST_TEST(map.visit("a", [&seen](const boost::any& value) { seen = boost::any_cast<int>(value); }));
+    BOOST_TEST_EQ(seen, 5);
+    BOOST_TEST(!map.visit("b", [&seen](const boost::any&) { seen = 0; }));
+    BOOST_TEST_EQ(seen, 5);
+
+#ifndef BOOST_NO_EXCEPTIONS
+    {
+        map.insert_or_assign("value", tracked(1));
+        BOOST_TEST_THROWS(map.visit("value", [](const boost::any&) { throw 1; }), int);
+
+        // The hazard pointer was cleared, so the value is freed
+        map.erase("value");
+        boost::anys::reclaim_retired();
+        BOOST_TEST_EQ(alive.load(), 0);
+    }
+#endif
+}
+
+void test_concurrent() {
+    constexpr int keys = 64;
+    constexpr int writes = 2000;
+    boost::anys::concurrent_any_map map(8);
+    for (int k = 0; k < keys; ++k) {
+        map.insert_or_assign(std::to_string(k), 0);
+    }
+
+    std::atomic<bool> done{false};
+    std::atomic<int> failures{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&map, &done, &failures, t]() {
+            std::vector<int> last(keys, 0);
+            while (!done.load()) {
+                for (int k = 0; k < keys; ++k) {
+                    int current = -1;
+                    if (t % 2) {
+                        map.visit(std::to_string(k), [&current](const boost::any& value) {
+                            current = boost::any_cast<int>(value);
+                        });
+                    } else if (const boost::anys::typed_snapshot<int> value = map.get<int>(std::to_string(k))) {
+                        current = *value;
+                    }
+                    if (current < last[k]) {
+                        ++failures;
+                        continue;
+                    }
+                    last[k] = current;
+                }
+            }
+        });
+    }
+
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 2; ++t) {
+        writers.emplace_back([&map, t]() {
+            for (int i = 1; i <= writes; ++i) {
+                const int k = (i * 2 + t) % keys;
+                const int current = *map.get<int>(std::to_string(k));
+                map.insert_or_assign(std::to_string(k), current + 1);
+                map.insert_or_assign("temporary" + std::to_string(t), i);
+                map.erase("temporary" + std::to_string(t));
+            }
+        });
+    }
+    for (std::thread& t : writers) {
+        t.join();
+    }
+    done = true;
+    for (std::thread& t : readers) {
+        t.join();
+    }
+
+    BOOST_TEST_EQ(failures.load(), 0);
+    BOOST_TEST_EQ(map.size(), static_cast<std::size_t>(keys));
+    int total = 0;
+    for (int k = 0; k < keys; ++k) {
+        total += *map.get<int>(std::to_string(k));
+    }
+    BOOST_TEST_EQ(total, 2 * writes);
+}
+
+} // anonymous namespace
+
+int main() {
+    test_basics();
+    test_snapshot_lifetime();
+    test_visit();
+    test_concurrent();
+
+    return boost::report_errors();
+}
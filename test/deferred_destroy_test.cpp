@@ -0,0 +1,148 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/any/deferred_destroy.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::atomic<int> destroyed{0};
+std::atomic<bool> destroyed_on_other_thread{false};
+std::thread::id main_thread;
+
+struct payload {
+    payload() = default;
+    payload(const payload&) = default;
+    payload(payload&& other) noexcept : data(std::move(other.data)), owner(other.owner) { other.owner = false; }
+
+    ~payload() {
+        if (owner) {
+            ++destroyed;
+            if (std::this_thread::get_id() != main_thread) {
+                destroyed_on_other_thread = true;
+            }
+        }
+    }
+
+    std::vector<int> data = std::vector<int>(1000, 42);
+    bool owner = true;
+};
+
+struct move_only_payload {
+    move_only_payload() = default;
+    move_only_payload(move_only_payload&&) = default;
+    std::unique_ptr<payload> value{new payload};
+};
+
+void test_background_thread() {
+    destroyed = 0;
+    boost::any value = payload{};
+    BOOST_TEST_EQ(destroyed.load(), 0);
+
+    boost::anys::deferred_destroy(std::move(value));
+    BOOST_TEST(value.empty());
+
+    for (int i = 0; i < 1000 && destroyed.load() != 1; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    BOOST_TEST_EQ(destroyed.load(), 1);
+    BOOST_TEST(destroyed_on_other_thread.load());
+}
+
+void test_all_anys() {
+    destroyed = 0;
+
+    boost::any a = payload{};
+    boost::anys::deferred_destroy(std::move(a));
+    BOOST_TEST(a.empty());
+
+    boost::anys::basic_any<8, 8> large = payload{};
+    boost::anys::deferred_destroy(std::move(large));
+    BOOST_TEST(large.empty());
+
+    boost::anys::basic_any<64, 8> small = payload{};
+    boost::anys::deferred_destroy(std::move(small));
+    BOOST_TEST(small.empty());
+
+    boost::anys::basic_any_hinted<64, 8, int, payload> hinted = payload{};
+    boost::anys::deferred_destroy(std::move(hinted));
+    BOOST_TEST(hinted.empty());
+
+    boost::anys::unique_any u = move_only_payload{};
+    boost::anys::deferred_destroy(std::move(u));
+    BOOST_TEST(!u.has_value());
+
+    // Empty values are ignored
+    boost::anys::deferred_destroy(boost::any());
+    boost::anys::deferred_destroy(boost::anys::unique_any());
+
+    boost::anys::deferred_flush();
+    BOOST_TEST_EQ(destroyed.load(), 5);
+}
+
+// Values in the buffer are destroyed by the caller right away
+void test_in_buffer_destroyed_inline() {
+    destroyed = 0;
+    destroyed_on_other_thread = false;
+
+    boost::anys::basic_any<64, 8> small = payload{};
+    boost::anys::deferred_destroy(std::move(small));
+    BOOST_TEST(small.empty());
+    BOOST_TEST_EQ(destroyed.load(), 1);
+
+    boost::anys::basic_any_hinted<64, 8, int, payload> hinted = payload{};
+    boost::anys::deferred_destroy(std::move(hinted));
+    BOOST_TEST(hinted.empty());
+    BOOST_TEST_EQ(hinted.hint_index(), 0u);
+    BOOST_TEST_EQ(destroyed.load(), 2);
+
+    BOOST_TEST(!destroyed_on_other_thread.load());
+}
+
+void test_many_threads() {
+    destroyed = 0;
+    constexpr int per_thread = 500;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([]() {
+            for (int i = 0; i < per_thread; ++i) {
+                boost::anys::deferred_destroy(boost::any(payload{}));
+            }
+        });
+    }
+    for (std::thread& t : threads) {
+        t.join();
+    }
+
+    boost::anys::deferred_flush();
+    BOOST_TEST_EQ(destroyed.load(), 4 * per_thread);
+
+    // Nothing to flush
+    boost::anys::deferred_flush();
+    BOOST_TEST_EQ(destroyed.load(), 4 * per_thread);
+}
+
+} // anonymous namespace
+
+int main() {
+    main_thread = std::this_thread::get_id();
+    boost::anys::deferred_flush();
+
+    test_background_thread();
+    test_all_anys();
+    test_in_buffer_destroyed_inline();
+    test_many_threads();
+
+    return boost::report_errors();
+}
@@ -0,0 +1,150 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/any/event_bus.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct key_pressed {
+    int code;
+};
+
+void test_publish() {
+    boost::anys::event_bus bus;
+    BOOST_TEST_EQ(bus.publish(boost::any(1)), 0u);
+
+    std::vector<int> ints;
+    std::vector<std::string> strings;
+    int keys = 0;
+    const auto a = bus.subscribe<int>([&](const int& v) { ints.push_back(v); });
+    bus.subscribe<int>([&](int v) { ints.push_back(v * 10); });
+    bus.subscribe<std::string>([&](const std::string& v) { strings.push_back(v); });
+    bus.subscribe<key_pressed>([&](const key_pressed& e) { keys += e.code; });
+
+    BOOST_TEST_EQ(bus.publish(boost::any(2)), 2u);
+    BOOST_TEST_EQ(bus.publish(boost::any(std::string("s"))), 1u);
+    BOOST_TEST_EQ(bus.publish(boost::any(key_pressed{5})), 1u);
+    BOOST_TEST_EQ(bus.publish(boost::any(2.0)), 0u);
+    BOOST_TEST_EQ(bus.publish(boost::any()), 0u);
+
+    BOOST_TEST_EQ(ints.size(), 2u);
+    BOOST_TEST_EQ(ints[0], 2);
+    BOOST_TEST_EQ(ints[1], 20);
+    BOOST_TEST_EQ(strings.size(), 1u);
+    BOOST_TEST_EQ(keys, 5);
+
+    BOOST_TEST(bus.unsubscribe(a));
+    BOOST_TEST(!bus.unsubscribe(a));
+    BOOST_TEST(!bus.unsubscribe(0));
+    BOOST_TEST_EQ(bus.publish(boost::any(3)), 1u);
+    BOOST_TEST_EQ(ints.back(), 30);
+
+    // Subscribing to a type that was published without subscribers
+    int doubles = 0;
+    bus.subscribe<double>([&](double) { ++doubles; });
+    BOOST_TEST_EQ(bus.publish(boost::any(1.0)), 1u);
+    BOOST_TEST_EQ(doubles, 1);
+}
+
+void test_publish_many() {
+    boost::anys::event_bus bus;
+    std::vector<std::string> log;
+    bus.subscribe<int>([&](int v) { log.push_back("i" + std::to_string(v)); });
+    bus.subscribe<std::string>([&](const std::string& v) { log.push_back("s" + v); });
+
+    std::vector<boost::any> events;
+    events.emplace_back(1);
+    events.emplace_back(std::string("a"));
+    events.emplace_back(2);
+    events.emplace_back(1.5);
+    events.emplace_back();
+    events.emplace_back(std::string("b"));
+    events.emplace_back(3);
+
+    BOOST_TEST_EQ(bus.publish_many(events.begin(), events.end()), 5u);
+    const std::vector<std::string> expected = {"i1", "i2", "i3", "sa", "sb"};
+    BOOST_TEST_ALL_EQ(log.begin(), log.end(), expected.begin(), expected.end());
+
+    log.clear();
+    BOOST_TEST_EQ(bus.publish_many(events.begin(), events.end()), 5u);
+    BOOST_TEST_ALL_EQ(log.begin(), log.end(), expected.begin(), expected.end());
+    BOOST_TEST_EQ(bus.publish_many(events.end(), events.end()), 0u);
+}
+
+void test_reentrancy() {
+    boost::anys::event_bus bus;
+    int first = 0;
+    int late = 0;
+    int nested = 0;
+    boost::anys::event_bus::subscription self = 0;
+    self = bus.subscribe<int>([&](int) {
+        ++first;
+        bus.unsubscribe(self);
+        bus.subscribe<int>([&](int) { ++late; });
+        bus.publish(boost::any(std::string("nested")));
+    });
+    bus.subscribe<std::string>([&](const std::string&) { ++nested; });
+
+    BOOST_TEST_EQ(bus.publish(boost::any(1)), 1u);
+    BOOST_TEST_EQ(first, 1);
+    BOOST_TEST_EQ(late, 0);
+    BOOST_TEST_EQ(nested, 1);
+
+    BOOST_TEST_EQ(bus.publish(boost::any(1)), 1u);
+    BOOST_TEST_EQ(first, 1);
+    BOOST_TEST_EQ(late, 1);
+
+    std::vector<boost::any> events;
+    events.emplace_back(std::string("x"));
+    bus.subscribe<double>([&](double) { bus.publish_many(events.begin(), events.end()); });
+    std::vector<boost::any> outer;
+    outer.emplace_back(1.0);
+    outer.emplace_back(2);
+    BOOST_TEST_EQ(bus.publish_many(outer.begin(), outer.end()), 2u);
+    BOOST_TEST_EQ(nested, 2);
+    BOOST_TEST_EQ(late, 2);
+}
+
+void test_exceptions() {
+#ifndef BOOST_NO_EXCEPTIONS
+    boost::anys::event_bus bus;
+    int calls = 0;
+    bus.subscribe<int>([&](int v) {
+        ++calls;
+        if (v < 0) {
+            throw std::runtime_error("negative");
+        }
+    });
+
+    std::vector<boost::any> events;
+    events.emplace_back(-1);
+    events.emplace_back(2);
+    BOOST_TEST_THROWS(bus.publish_many(events.begin(), events.end()), std::runtime_error);
+    BOOST_TEST_EQ(calls, 1);
+
+    // Nothing is left from the failed batch
+    BOOST_TEST_EQ(bus.publish_many(events.begin() + 1, events.end()), 1u);
+    BOOST_TEST_EQ(calls, 2);
+    BOOST_TEST_THROWS(bus.publish(boost::any(-1)), std::runtime_error);
+#endif
+}
+
+} // anonymous namespace
+
+int main() {
+    test_publish();
+    test_publish_many();
+    test_reentrancy();
+    test_exceptions();
+
+    return boost::report_errors();
+}
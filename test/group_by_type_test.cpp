@@ -0,0 +1,131 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/any/group_by_type.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <list>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct counted {
+    static int instances;
+
+    explicit counted(int v) noexcept : value(v) { ++instances; }
+    counted(const counted& other) noexcept : value(other.value) { ++instances; }
+    ~counted() { --instances; }
+
+    int value;
+};
+
+int counted::instances = 0;
+
+// Small, but not trivially copyable: relocated by the move constructor
+struct self_pointing {
+    explicit self_pointing(int v) noexcept : value(v), self(this) {}
+    self_pointing(const self_pointing& other) noexcept : value(other.value), self(this) {}
+    self_pointing& operator=(const self_pointing&) = delete;
+
+    int value;
+    self_pointing* self;
+};
+
+template <class Container>
+void fill(Container& values) {
+    for (int i = 0; i < 12; ++i) {
+        switch (i % 4) {
+        case 0: values.emplace_back(i); break;
+        case 1: values.emplace_back(std::string(30, static_cast<char>('a' + i))); break;
+        case 2: values.emplace_back(); break;
+        default: values.emplace_back(counted(i)); break;
+        }
+    }
+}
+
+template <class Container>
+void check_grouped(Container& values) {
+    auto it = values.begin();
+    for (int i = 0; i < 12; i += 4, ++it) {
+        BOOST_TEST_EQ(boost::any_cast<int>(*it), i);
+    }
+    for (int i = 1; i < 12; i += 4, ++it) {
+        BOOST_TEST_EQ(boost::any_cast<const std::string&>(*it), std::string(30, static_cast<char>('a' + i)));
+    }
+    for (int i = 2; i < 12; i += 4, ++it) {
+        BOOST_TEST(it->type() == boost::typeindex::type_id<void>());
+    }
+    for (int i = 3; i < 12; i += 4, ++it) {
+        BOOST_TEST_EQ(boost::any_cast<const counted&>(*it).value, i);
+    }
+    BOOST_TEST(it == values.end());
+}
+
+template <class Any>
+void test_group() {
+    {
+        std::vector<Any> values;
+        fill(values);
+        BOOST_TEST_EQ(counted::instances, 3);
+
+        BOOST_TEST_EQ(boost::anys::group_by_type(values.begin(), values.end()), 4u);
+        check_grouped(values);
+        BOOST_TEST_EQ(counted::instances, 3);
+
+        // Already grouped
+        BOOST_TEST_EQ(boost::anys::group_by_type(values.begin(), values.end()), 4u);
+        check_grouped(values);
+    }
+    BOOST_TEST_EQ(counted::instances, 0);
+
+    std::vector<Any> empty;
+    BOOST_TEST_EQ(boost::anys::group_by_type(empty.begin(), empty.end()), 0u);
+}
+
+template <class Container>
+void test_list() {
+    Container values;
+    fill(values);
+    BOOST_TEST_EQ(boost::anys::group_by_type(values.begin(), values.end()), 4u);
+    check_grouped(values);
+}
+
+void test_not_bitwise_relocatable() {
+    std::vector<boost::anys::basic_any<>> values;
+    for (int i = 0; i < 6; ++i) {
+        if (i % 2) {
+            values.emplace_back(self_pointing(i));
+        } else {
+            values.emplace_back(i);
+        }
+    }
+
+    BOOST_TEST_EQ(boost::anys::group_by_type(values.begin(), values.end()), 2u);
+    for (int i = 0; i < 3; ++i) {
+        BOOST_TEST_EQ(boost::any_cast<int>(values[i]), 2 * i);
+    }
+    for (int i = 0; i < 3; ++i) {
+        const self_pointing& v = boost::any_cast<const self_pointing&>(values[3 + i]);
+        BOOST_TEST_EQ(v.value, 2 * i + 1);
+        BOOST_TEST_EQ(v.self, &v);
+    }
+}
+
+} // namespace
+
+int main() {
+    test_group<boost::any>();
+    test_group<boost::anys::basic_any<>>();
+    test_group<boost::anys::basic_any<8, 8>>();
+    test_group<boost::anys::unique_any>();
+    test_list<std::list<boost::any>>();
+    test_list<std::list<boost::anys::basic_any<>>>();
+    test_not_bitwise_relocatable();
+
+    return boost::report_errors();
+}
@@ -0,0 +1,119 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/any/parallel.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t size = 50000;
+
+template <class Any>
+std::vector<Any> make_values() {
+    std::vector<Any> values;
+    values.reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        switch (i % 5) {
+        case 0: values.emplace_back(static_cast<int>(i)); break;
+        case 1: values.emplace_back(std::to_string(i) + " that is long enough for the heap"); break;
+        case 2: values.emplace_back(); break;
+        case 3: values.emplace_back(static_cast<double>(i)); break;
+        default: values.emplace_back(static_cast<int>(i)); break;
+        }
+    }
+    return values;
+}
+
+template <class Any>
+void test_copy_and_reset() {
+    const std::vector<Any> values = make_values<Any>();
+    for (std::size_t threads : {std::size_t{0}, std::size_t{1}, std::size_t{4}}) {
+        std::vector<Any> copy(values.size());
+        const auto end = boost::anys::parallel_copy(values.begin(), values.end(), copy.begin(), threads);
+        BOOST_TEST(end == copy.end());
+        for (std::size_t i = 0; i < size; i += 997) {
+            BOOST_TEST(boost::typeindex::type_index(copy[i].type()) == values[i].type());
+        }
+        BOOST_TEST_EQ(boost::any_cast<const std::string&>(copy[size - 4]), boost::any_cast<const std::string&>(values[size - 4]));
+
+        boost::anys::parallel_reset(copy.begin(), copy.end(), threads);
+        for (std::size_t i = 0; i < size; i += 101) {
+            BOOST_TEST(copy[i].empty());
+        }
+    }
+}
+
+template <class Any>
+void test_for_each_type() {
+    std::vector<Any> values = make_values<Any>();
+
+    std::atomic<std::size_t> count{0};
+    boost::anys::parallel_for_each_type<int>(values.begin(), values.end(), [&count](int& v) {
+        ++count;
+        v = -1;
+    }, 4);
+    BOOST_TEST_EQ(count.load(), size / 5 * 2);
+    BOOST_TEST_EQ(boost::any_cast<int>(values[5]), -1);
+    BOOST_TEST_EQ(boost::any_cast<double>(values[3]), 3.0);
+
+    const std::vector<Any>& cvalues = values;
+    std::atomic<std::size_t> doubles{0};
+    boost::anys::parallel_for_each_type<double>(cvalues.begin(), cvalues.end(), [&doubles](const double&) {
+        ++doubles;
+    });
+    BOOST_TEST_EQ(doubles.load(), size / 5);
+
+    BOOST_TEST_THROWS(
+        boost::anys::parallel_for_each_type<std::string>(values.begin(), values.end(), [](std::string& v) {
+            if (v.compare(0, 5, "40001") == 0) {
+                throw std::runtime_error("failed");
+            }
+        }, 4),
+        std::runtime_error
+    );
+}
+
+template <class Any>
+void test_group_by_type() {
+    std::vector<Any> expected = make_values<Any>();
+    BOOST_TEST_EQ(boost::anys::group_by_type(expected.begin(), expected.end()), 4u);
+
+    for (std::size_t threads : {std::size_t{0}, std::size_t{1}, std::size_t{3}, std::size_t{8}}) {
+        std::vector<Any> values = make_values<Any>();
+        BOOST_TEST_EQ(boost::anys::parallel_group_by_type(values.begin(), values.end(), threads), 4u);
+        for (std::size_t i = 0; i < size; ++i) {
+            if (boost::typeindex::type_index(values[i].type()) != expected[i].type()) {
+                BOOST_TEST(false);
+                break;
+            }
+        }
+        BOOST_TEST_EQ(boost::any_cast<int>(values[0]), 0);
+        BOOST_TEST_EQ(boost::any_cast<int>(values[1]), 4);
+        BOOST_TEST_EQ(boost::any_cast<int>(values[size / 5 * 2 - 1]), static_cast<int>(size - 1));
+        BOOST_TEST_EQ(boost::any_cast<const std::string&>(values[size / 5 * 2]), boost::any_cast<const std::string&>(expected[size / 5 * 2]));
+    }
+}
+
+} // namespace
+
+int main() {
+    test_copy_and_reset<boost::any>();
+    test_copy_and_reset<boost::anys::basic_any<>>();
+    test_for_each_type<boost::any>();
+    test_for_each_type<boost::anys::basic_any<>>();
+    test_for_each_type<boost::anys::unique_any>();
+    test_group_by_type<boost::any>();
+    test_group_by_type<boost::anys::basic_any<>>();
+    test_group_by_type<boost::anys::unique_any>();
+
+    return boost::report_errors();
+}
@@ -0,0 +1,204 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/any/persistent_any_map.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int alive = 0;
+
+struct tracked {
+    explicit tracked(int v) : value(v) { ++alive; }
+    tracked(const tracked& other) : value(other.value) { ++alive; }
+    ~tracked() { --alive; }
+    int value;
+};
+
+// Few distinct hashes, so the keys share paths and collide at the bottom
+struct colliding_hash {
+    std::size_t operator()(const std::string& key) const noexcept
+    {
+        return key.size() % 4;
+    }
+};
+
+void test_basics() {
+    boost::anys::persistent_any_map map;
+    BOOST_TEST(map.empty());
+    BOOST_TEST(!map.find("a"));
+    BOOST_TEST(!map.share("a"));
+    BOOST_TEST(!map.erase("a"));
+
+    BOOST_TEST(map.insert_or_assign("a", 1));
+    BOOST_TEST(map.insert_or_assign("b", std::string("text")));
+    BOOST_TEST(!map.insert_or_assign("a", 2));
+    BOOST_TEST_EQ(map.size(), 2u);
+    BOOST_TEST_EQ(*map.get<int>("a"), 2);
+    BOOST_TEST_EQ(*map.get<std::string>("b"), "text");
+    BOOST_TEST(!map.get<double>("a"));
+    BOOST_TEST(map.contains("b"));
+
+    BOOST_TEST(map.erase("a"));
+    BOOST_TEST(!map.erase("a"));
+    BOOST_TEST(!map.contains("a"));
+    BOOST_TEST_EQ(map.size(), 1u);
+
+    map.clear();
+    BOOST_TEST(map.empty());
+    BOOST_TEST(!map.contains("b"));
+}
+
+void test_snapshots() {
+    {
+        boost::anys::persistent_any_map state;
+        for (int i = 0; i < 2000; ++i) {
+            state.insert_or_assign("key" + std::to_string(i), tracked(i));
+        }
+        BOOST_TEST_EQ(alive, 2000);
+
+        // Snapshots copy no values
+        const boost::anys::persistent_any_map snapshot = state;
+        BOOST_TEST_EQ(alive, 2000);
+        BOOST_TEST(snapshot.shares_with(state));
+
+        state.insert_or_assign("key7", tracked(-7));
+        BOOST_TEST(state.erase("key8"));
+        BOOST_TEST(!snapshot.shares_with(state));
+        BOOST_TEST_EQ(alive, 2001);
+
+        BOOST_TEST_EQ(snapshot.get<tracked>("key7")->value, 7);
+        BOOST_TEST_EQ(state.get<tracked>("key7")->value, -7);
+        BOOST_TEST(snapshot.contains("key8"));
+        BOOST_TEST(!state.contains("key8"));
+        BOOST_TEST_EQ(snapshot.size(), 2000u);
+        BOOST_TEST_EQ(state.size(), 1999u);
+
+        // Shared value outlives the maps
+        std::shared_ptr<const boost::any> shared = snapshot.share("key9");
+        state.clear();
+        {
+            boost::anys::persistent_any_map empty;
+            swap(empty, state);
+        }
+        const boost::anys::persistent_any_map moved = snapshot;
+        BOOST_TEST_EQ(boost::any_cast<const tracked&>(*shared).value, 9);
+
+        int sum = 0;
+        std::size_t visited = 0;
+        moved.for_each([&](const std::string&, const boost::any& value) {
+            sum += boost::any_cast<const tracked&>(value).value;
+            ++visited;
+        });
+        BOOST_TEST_EQ(visited, 2000u);
+        BOOST_TEST_EQ(sum, 1999 * 2000 / 2);
+    }
+    BOOST_TEST_EQ(alive, 0);
+}
+
+template <class Map>
+void check_same(const Map& map, const std::map<std::string, int>& reference) {
+    BOOST_TEST_EQ(map.size(), reference.size());
+    std::size_t visited = 0;
+    map.for_each([&](const std::string& key, const boost::any& value) {
+        BOOST_TEST_EQ(reference.at(key), boost::any_cast<int>(value));
+        ++visited;
+    });
+    BOOST_TEST_EQ(visited, reference.size());
+    for (const auto& entry : reference) {
+        BOOST_TEST_EQ(*map.template get<int>(entry.first), entry.second);
+    }
+}
+
+template <class Map>
+void test_against_map() {
+    Map map;
+    std::map<std::string, int> reference;
+    std::vector<Map> snapshots;
+    std::vector<std::map<std::string, int>> expected;
+
+    unsigned seed = 12345;
+    for (int step = 0; step < 3000; ++step) {
+        seed = seed * 1103515245u + 12345u;
+        const std::string key = "k" + std::to_string((seed >> 8) % 300);
+        if ((seed >> 4) % 3) {
+            const bool added = reference.find(key) == reference.end();
+            reference[key] = step;
+            BOOST_TEST_EQ(map.insert_or_assign(key, step), added);
+        } else {
+            const bool removed = reference.erase(key) != 0;
+            BOOST_TEST_EQ(map.erase(key), removed);
+        }
+
+        if (step % 500 == 0) {
+            snapshots.push_back(map);
+            expected.push_back(reference);
+        }
+    }
+
+    check_same(map, reference);
+    for (std::size_t i = 0; i < snapshots.size(); ++i) {
+        check_same(snapshots[i], expected[i]);
+    }
+
+    for (const auto& entry : expected.back()) {
+        map.erase(entry.first);
+    }
+    for (const auto& entry : reference) {
+        map.erase(entry.first);
+    }
+    BOOST_TEST(map.empty());
+    BOOST_TEST(!map.contains("k1"));
+}
+
+void test_threads() {
+    boost::anys::persistent_any_map state;
+    for (int i = 0; i < 100; ++i) {
+        state.insert_or_assign(std::to_string(i), i);
+    }
+
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; ++t) {
+        const boost::anys::persistent_any_map snapshot = state;
+        readers.emplace_back([snapshot]() {
+            for (int round = 0; round < 20; ++round) {
+                int sum = 0;
+                for (int i = 0; i < 100; ++i) {
+                    sum += *snapshot.get<int>(std::to_string(i));
+                }
+                BOOST_TEST_EQ(sum, 4950);
+                std::this_thread::yield();
+            }
+        });
+    }
+    for (int i = 0; i < 100; ++i) {
+        state.insert_or_assign(std::to_string(i), 0);
+    }
+    for (std::thread& t : readers) {
+        t.join();
+    }
+    BOOST_TEST_EQ(*state.get<int>("50"), 0);
+}
+
+} // anonymous namespace
+
+int main() {
+    test_basics();
+    test_snapshots();
+    test_against_map<boost::anys::persistent_any_map>();
+    test_against_map<boost::anys::basic_persistent_any_map<colliding_hash>>();
+    test_threads();
+
+    return boost::report_errors();
+}
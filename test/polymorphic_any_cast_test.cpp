@@ -0,0 +1,97 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_ANY_USE_POLYMORPHIC_CAST
+#include <boost/any/polymorphic_any_cast.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <string>
+
+namespace {
+
+struct base1 {
+    virtual ~base1() = default;
+    int value1 = 1;
+};
+
+struct base2 {
+    int value2 = 2;
+};
+
+struct virtual_base {
+    int value3 = 3;
+};
+
+struct derived: base1, base2, virtual virtual_base {
+    std::string name = "derived";
+};
+
+struct private_derived: private base2 {
+};
+
+struct small_derived: base2 {
+};
+
+template <class Any>
+void test_any() {
+    Any a = derived();
+    derived& d = boost::any_cast<derived&>(a);
+
+    for (int i = 0; i < 3; ++i) {  // second and third casts take the cached offset
+        base1* b1 = boost::polymorphic_any_cast<base1>(&a);
+        BOOST_TEST_EQ(b1, static_cast<base1*>(&d));
+        BOOST_TEST_EQ(b1->value1, 1);
+
+        base2* b2 = boost::polymorphic_any_cast<base2>(&a);
+        BOOST_TEST_EQ(b2, static_cast<base2*>(&d));
+        BOOST_TEST_EQ(b2->value2, 2);
+
+        const Any& ca = a;
+        const virtual_base* vb = boost::polymorphic_any_cast<virtual_base>(&ca);
+        BOOST_TEST_EQ(vb, static_cast<virtual_base*>(&d));
+        BOOST_TEST_EQ(vb->value3, 3);
+
+        BOOST_TEST_EQ(boost::polymorphic_any_cast<derived>(&a), &d);
+        BOOST_TEST(!boost::polymorphic_any_cast<std::string>(&a));
+        BOOST_TEST_EQ(&boost::polymorphic_any_cast<base2>(a), static_cast<base2*>(&d));
+        BOOST_TEST_EQ(&boost::polymorphic_any_cast<const base1>(ca), static_cast<base1*>(&d));
+    }
+
+    Any other = derived();
+    BOOST_TEST_EQ(
+        boost::polymorphic_any_cast<base2>(&other),
+        static_cast<base2*>(&boost::any_cast<derived&>(other))
+    );
+
+    Any priv = private_derived();
+    BOOST_TEST(!boost::polymorphic_any_cast<base2>(&priv));
+    BOOST_TEST_THROWS(boost::polymorphic_any_cast<base2>(priv), boost::bad_any_cast);
+
+    Any small = small_derived();
+    BOOST_TEST_EQ(
+        boost::polymorphic_any_cast<base2>(&small),
+        static_cast<base2*>(&boost::any_cast<small_derived&>(small))
+    );
+
+    Any empty;
+    BOOST_TEST(!boost::polymorphic_any_cast<base1>(&empty));
+    BOOST_TEST_THROWS(boost::polymorphic_any_cast<base1>(empty), boost::bad_any_cast);
+
+    Any* null = nullptr;
+    BOOST_TEST(!boost::polymorphic_any_cast<base1>(null));
+}
+
+}
+
+int main() {
+    test_any<boost::any>();
+    test_any<boost::anys::unique_any>();
+    test_any<boost::anys::basic_any<> >();
+    test_any<boost::anys::basic_any<256, 8> >();
+
+    return boost::report_errors();
+}
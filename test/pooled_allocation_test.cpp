@@ -0,0 +1,206 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/any.hpp>
+#include <boost/any/basic_any.hpp>
+#include <boost/any/pooled_allocation.hpp>
+#include <boost/any/unique_any.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct message {
+    explicit message(int v) : value(v) {}
+    int value;
+    char payload[40];
+};
+
+struct large_message {
+    explicit large_message(int v) : value(v) {}
+    int value;
+    char payload[500];
+};
+
+struct alignas(64) aligned_message {
+    explicit aligned_message(int v) : value(v) {}
+    int value;
+};
+
+struct throws_on_copy {
+    throws_on_copy() = default;
+    throws_on_copy(throws_on_copy&&) = default;
+    throws_on_copy(const throws_on_copy&) { throw std::runtime_error("copy"); }
+    char payload[24];
+};
+
+} // anonymous namespace
+
+namespace boost { namespace anys {
+
+template <> struct use_pooled_allocation<message> : std::true_type {};
+template <> struct use_pooled_allocation<large_message> : std::true_type {};
+template <> struct use_pooled_allocation<aligned_message> : std::true_type {};
+template <> struct use_pooled_allocation<throws_on_copy> : std::true_type {};
+
+}} // namespace boost::anys
+
+namespace {
+
+template <class Any>
+const void* make_and_free(int value) {
+    Any a(message{value});
+    BOOST_TEST_EQ(boost::any_cast<message&>(a).value, value);
+    return boost::any_cast<message>(&a);
+}
+
+template <class Any>
+void test_reuse_on_the_same_thread() {
+    const void* first = make_and_free<Any>(1);
+    const void* second = make_and_free<Any>(2);
+    BOOST_TEST_EQ(first, second);
+}
+
+template <class Any>
+void test_remote_free() {
+    Any* value = new Any(message{1});
+    const void* address = boost::any_cast<message>(value);
+
+    std::thread consumer([value]() {
+        BOOST_TEST_EQ(boost::any_cast<message&>(*value).value, 1);
+        delete value;
+    });
+    consumer.join();
+
+    // The block was returned to the allocating thread and is reused after
+    // the blocks that are already cached locally
+    std::vector<Any> again;
+    bool reused = false;
+    for (int i = 0; i < 16 && !reused; ++i) {
+        again.emplace_back(message{i});
+        reused = (boost::any_cast<message>(&again.back()) == address);
+    }
+    BOOST_TEST(reused);
+}
+
+void test_basic_any() {
+    using any_type = boost::anys::basic_any<8, 8>;
+    test_reuse_on_the_same_thread<any_type>();
+    test_remote_free<any_type>();
+
+    any_type a(message{5});
+    any_type copy = a;
+    BOOST_TEST_EQ(boost::any_cast<message&>(copy).value, 5);
+    BOOST_TEST(boost::any_cast<message>(&copy) != boost::any_cast<message>(&a));
+
+    any_type large(large_message{6});
+    BOOST_TEST_EQ(boost::any_cast<large_message&>(large).value, 6);
+
+#ifdef __cpp_aligned_new
+    any_type aligned(aligned_message{7});
+    BOOST_TEST_EQ(boost::any_cast<aligned_message&>(aligned).value, 7);
+    BOOST_TEST_EQ(reinterpret_cast<std::uintptr_t>(boost::any_cast<aligned_message>(&aligned)) % 64, 0u);
+#endif
+
+    any_type throwing(throws_on_copy{});
+    BOOST_TEST_THROWS(any_type{throwing}, std::runtime_error);
+}
+
+void test_any() {
+    test_reuse_on_the_same_thread<boost::any>();
+    test_remote_free<boost::any>();
+
+    boost::any a(message{5});
+    boost::any copy = a;
+    BOOST_TEST_EQ(boost::any_cast<message&>(copy).value, 5);
+
+    boost::any large(large_message{6});
+    BOOST_TEST_EQ(boost::any_cast<large_message&>(large).value, 6);
+
+#ifdef __cpp_aligned_new
+    boost::any aligned(aligned_message{7});
+    BOOST_TEST_EQ(boost::any_cast<aligned_message&>(aligned).value, 7);
+    BOOST_TEST_EQ(reinterpret_cast<std::uintptr_t>(boost::any_cast<aligned_message>(&aligned)) % 64, 0u);
+#endif
+
+    boost::any throwing(throws_on_copy{});
+    BOOST_TEST_THROWS(boost::any{throwing}, std::runtime_error);
+}
+
+void test_unique_any() {
+    test_reuse_on_the_same_thread<boost::anys::unique_any>();
+    test_remote_free<boost::anys::unique_any>();
+
+    boost::anys::unique_any a;
+    a.emplace<message>(8);
+    BOOST_TEST_EQ(boost::any_cast<message&>(a).value, 8);
+
+    boost::anys::unique_any from_any(boost::any(message{9}));
+    BOOST_TEST_EQ(boost::any_cast<message&>(from_any).value, 9);
+}
+
+void test_exited_thread() {
+    std::vector<boost::any> values;
+    std::thread producer([&values]() {
+        for (int i = 0; i < 100; ++i) {
+            values.emplace_back(message{i});
+        }
+    });
+    producer.join();
+
+    // Blocks of the exited thread are freed into its cache, that is adopted
+    // by the next thread
+    for (int i = 0; i < 100; ++i) {
+        BOOST_TEST_EQ(boost::any_cast<message&>(values[i]).value, i);
+    }
+    values.clear();
+
+    std::thread next([]() {
+        std::vector<boost::any> reused;
+        for (int i = 0; i < 100; ++i) {
+            reused.emplace_back(message{i});
+        }
+    });
+    next.join();
+}
+
+void test_producer_consumer() {
+    constexpr int count = 10000;
+    std::vector<boost::any*> values(count);
+
+    std::thread producer([&values]() {
+        for (int i = 0; i < count; ++i) {
+            values[i] = new boost::any(message{i});
+        }
+    });
+    producer.join();
+
+    std::thread consumer([&values]() {
+        for (int i = 0; i < count; ++i) {
+            BOOST_TEST_EQ(boost::any_cast<message&>(*values[i]).value, i);
+            delete values[i];
+        }
+    });
+    consumer.join();
+}
+
+} // anonymous namespace
+
+int main() {
+    test_basic_any();
+    test_any();
+    test_unique_any();
+    test_exited_thread();
+    test_producer_consumer();
+
+    return boost::report_errors();
+}
@@ -0,0 +1,119 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/any/try_any_cast.hpp>
+#include <boost/any/compact_any.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+#ifdef BOOST_NO_EXCEPTIONS
+namespace boost {
+
+BOOST_NORETURN void throw_exception(const std::exception&) {
+    std::abort();
+}
+
+BOOST_NORETURN void throw_exception(const std::exception&, const boost::source_location&) {
+    std::abort();
+}
+
+} // namespace boost
+#endif
+
+namespace {
+
+template <class Any>
+void test_try_any_cast() {
+    Any a = std::string("hello");
+
+    auto s = boost::try_any_cast<std::string>(a);
+    BOOST_TEST(s);
+    BOOST_TEST(s.has_value());
+    BOOST_TEST_EQ(*s, "hello");
+    BOOST_TEST_EQ(s->size(), 5u);
+    BOOST_TEST_EQ(&s.value(), boost::any_cast<std::string>(&a));
+    s->push_back('!');
+    BOOST_TEST_EQ(boost::any_cast<std::string>(a), "hello!");
+
+    const Any& ca = a;
+    auto cs = boost::try_any_cast<std::string&>(ca);
+    static_assert(std::is_same<decltype(*cs), const std::string&>::value, "");
+    BOOST_TEST_EQ(*cs, "hello!");
+
+    auto mismatch = boost::try_any_cast<int>(a);
+    BOOST_TEST(!mismatch);
+    BOOST_TEST(mismatch.error() == boost::anys::any_cast_error::type_mismatch);
+    BOOST_TEST_EQ(mismatch.value_or(42), 42);
+#ifndef BOOST_NO_EXCEPTIONS
+    BOOST_TEST_THROWS(mismatch.value(), boost::bad_any_cast);
+#endif
+
+    Any empty;
+    auto e = boost::try_any_cast<int>(empty);
+    BOOST_TEST(!e.has_value());
+    BOOST_TEST(e.error() == boost::anys::any_cast_error::empty);
+}
+
+template <class Any>
+void test_any_cast_or() {
+    Any a = 7;
+    BOOST_TEST_EQ(boost::any_cast_or<int>(a, 1), 7);
+    BOOST_TEST_EQ(boost::any_cast_or<long>(a, 1), 1);
+    BOOST_TEST_EQ(boost::any_cast_or<const int>(a, 1), 7);
+
+    const Any& ca = a;
+    BOOST_TEST_EQ(boost::any_cast_or<int>(ca, 1), 7);
+    BOOST_TEST_EQ(boost::any_cast_or<std::string>(ca, "default"), "default");
+
+    Any empty;
+    BOOST_TEST_EQ(boost::any_cast_or<int>(empty, -1), -1);
+
+    Any s = std::string(100, 'x');
+    const std::string copy = boost::any_cast_or<std::string>(s, "");
+    BOOST_TEST_EQ(copy, std::string(100, 'x'));
+    BOOST_TEST_EQ(boost::any_cast<std::string>(s), copy);
+
+    const std::string moved = boost::any_cast_or<std::string>(std::move(s), "");
+    BOOST_TEST_EQ(moved, copy);
+    BOOST_TEST(boost::any_cast<std::string>(&s));
+    BOOST_TEST(boost::any_cast<std::string>(s).empty());
+}
+
+void test_move_only() {
+    boost::anys::unique_any a = std::unique_ptr<int>(new int(5));
+    auto r = boost::try_any_cast<std::unique_ptr<int> >(a);
+    BOOST_TEST(r);
+    BOOST_TEST_EQ(**r, 5);
+
+    std::unique_ptr<int> p = boost::any_cast_or<std::unique_ptr<int> >(std::move(a), nullptr);
+    BOOST_TEST(p);
+    BOOST_TEST_EQ(*p, 5);
+
+    std::unique_ptr<int> q = boost::any_cast_or<std::unique_ptr<int> >(std::move(a), nullptr);
+    BOOST_TEST(!q);  // moved out value
+}
+
+}
+
+int main() {
+    test_try_any_cast<boost::any>();
+    test_try_any_cast<boost::anys::basic_any<> >();
+    test_try_any_cast<boost::anys::unique_any>();
+    test_try_any_cast<boost::anys::compact_any>();
+
+    test_any_cast_or<boost::any>();
+    test_any_cast_or<boost::anys::basic_any<> >();
+    test_any_cast_or<boost::anys::unique_any>();
+    test_any_cast_or<boost::anys::compact_any>();
+
+    test_move_only();
+
+    return boost::report_errors();
+}
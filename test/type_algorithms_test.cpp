@@ -0,0 +1,100 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/any/type_algorithms.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <list>
+#include <string>
+#include <vector>
+
+namespace {
+
+using any_t = boost::anys::basic_any<>;
+
+std::vector<any_t> make_values(std::size_t count) {
+    std::vector<any_t> values;
+    for (std::size_t i = 0; i < count; ++i) {
+        switch (i % 3) {
+        case 0: values.emplace_back(static_cast<int>(i)); break;
+        case 1: values.emplace_back(std::string(i, 'x')); break;
+        default: values.emplace_back(); break;
+        }
+    }
+    return values;
+}
+
+void test_find_type() {
+    for (std::size_t n = 0; n < 12; ++n) {
+        std::vector<any_t> values = make_values(n);
+        auto it = boost::anys::find_type<std::string>(values.begin(), values.end());
+        BOOST_TEST(it == (n > 1 ? values.begin() + 1 : values.end()));
+
+        it = boost::anys::find_type<int>(values.begin() + (n ? 1 : 0), values.end());
+        BOOST_TEST(it == (n > 3 ? values.begin() + 3 : values.end()));
+
+        BOOST_TEST(boost::anys::find_type<double>(values.begin(), values.end()) == values.end());
+    }
+
+    std::vector<any_t> values(9);
+    values[8] = 1.0;
+    BOOST_TEST(boost::anys::find_type<double>(values.begin(), values.end()) == values.begin() + 8);
+    BOOST_TEST(boost::anys::find_type<const double>(values.cbegin(), values.cend()) == values.cbegin() + 8);
+
+    std::list<any_t> list(values.begin(), values.end());
+    BOOST_TEST(boost::anys::find_type<double>(list.begin(), list.end()) == std::prev(list.end()));
+    BOOST_TEST(boost::anys::find_type<int>(list.begin(), list.end()) == list.end());
+}
+
+void test_count_type() {
+    for (std::size_t n = 0; n < 12; ++n) {
+        const std::vector<any_t> values = make_values(n);
+        BOOST_TEST_EQ(boost::anys::count_type<int>(values.begin(), values.end()), (n + 2) / 3);
+        BOOST_TEST_EQ(boost::anys::count_type<std::string>(values.begin(), values.end()), (n + 1) / 3);
+        BOOST_TEST_EQ(boost::anys::count_type<double>(values.begin(), values.end()), 0u);
+
+        const std::list<any_t> list(values.begin(), values.end());
+        BOOST_TEST_EQ(boost::anys::count_type<int>(list.begin(), list.end()), (n + 2) / 3);
+    }
+
+    // Large objects have a different manager, but the same identity semantics
+    using small_any = boost::anys::basic_any<8, 8>;
+    std::vector<small_any> values;
+    values.emplace_back(std::string("large"));
+    values.emplace_back(1);
+    values.emplace_back(std::string("large"));
+    BOOST_TEST_EQ(boost::anys::count_type<std::string>(values.begin(), values.end()), 2u);
+    BOOST_TEST_EQ(boost::anys::count_type<int>(values.begin(), values.end()), 1u);
+}
+
+void test_partition_by_type() {
+    std::vector<any_t> values = make_values(20);
+    const std::size_t ints = boost::anys::count_type<int>(values.begin(), values.end());
+
+    auto middle = boost::anys::partition_by_type<int>(values.begin(), values.end());
+    BOOST_TEST_EQ(static_cast<std::size_t>(middle - values.begin()), ints);
+    for (auto it = values.begin(); it != middle; ++it) {
+        BOOST_TEST(boost::any_cast<int>(&*it));
+    }
+    for (auto it = middle; it != values.end(); ++it) {
+        BOOST_TEST(!boost::any_cast<int>(&*it));
+    }
+    BOOST_TEST_EQ(boost::anys::count_type<std::string>(middle, values.end()), 7u);
+
+    std::vector<any_t> empty;
+    BOOST_TEST(boost::anys::partition_by_type<int>(empty.begin(), empty.end()) == empty.end());
+}
+
+} // namespace
+
+int main() {
+    test_find_type();
+    test_count_type();
+    test_partition_by_type();
+
+    return boost::report_errors();
+}
@@ -0,0 +1,112 @@
+// Copyright Antony Polukhin, 2025.
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/any/type_map.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace {
+
+int alive = 0;
+
+struct service {
+    explicit service(int v) : value(v) { ++alive; }
+    service(const service&) = delete;
+    service& operator=(const service&) = delete;
+    ~service() { --alive; }
+    int value;
+};
+
+struct throws_on_construction {
+    throws_on_construction() { throw std::runtime_error("construction"); }
+};
+
+void test_basics() {
+    boost::anys::type_map map;
+    BOOST_TEST(map.empty());
+    BOOST_TEST(!map.get<int>());
+    BOOST_TEST(!map.contains<std::string>());
+    BOOST_TEST(!map.erase<int>());
+
+    BOOST_TEST_EQ(map.emplace<int>(42), 42);
+    BOOST_TEST_EQ(map.emplace<std::string>(3, 'a'), "aaa");
+    BOOST_TEST_EQ(map.size(), 2u);
+    BOOST_TEST_EQ(*map.get<int>(), 42);
+    BOOST_TEST_EQ(map.at<std::string>(), "aaa");
+    BOOST_TEST(!map.get<long>());
+    BOOST_TEST(!map.get<unsigned>());
+
+    map.emplace<int>(7);
+    BOOST_TEST_EQ(map.size(), 2u);
+    BOOST_TEST_EQ(*map.get<int>(), 7);
+
+    const boost::anys::type_map& cmap = map;
+    BOOST_TEST_EQ(*cmap.get<int>(), 7);
+    BOOST_TEST_EQ(cmap.at<std::string>().size(), 3u);
+    BOOST_TEST(cmap.contains<int>());
+
+    BOOST_TEST(map.erase<int>());
+    BOOST_TEST(!map.erase<int>());
+    BOOST_TEST(!map.get<int>());
+    BOOST_TEST_EQ(map.size(), 1u);
+    BOOST_TEST_THROWS(map.at<int>(), boost::bad_any_cast);
+    BOOST_TEST_THROWS(cmap.at<double>(), boost::bad_any_cast);
+}
+
+void test_move_only() {
+    {
+        boost::anys::type_map map;
+        map.emplace<service>(1);
+        map.emplace<std::unique_ptr<int>>(new int(5));
+        BOOST_TEST_EQ(alive, 1);
+        BOOST_TEST_EQ(map.get<service>()->value, 1);
+        BOOST_TEST_EQ(**map.get<std::unique_ptr<int>>(), 5);
+
+        map.emplace<service>(2);
+        BOOST_TEST_EQ(alive, 1);
+        BOOST_TEST_EQ(map.at<service>().value, 2);
+
+        boost::anys::type_map other(std::move(map));
+        BOOST_TEST_EQ(other.get<service>()->value, 2);
+        BOOST_TEST(map.empty());
+        BOOST_TEST(!map.contains<service>());
+
+        boost::anys::type_map third;
+        swap(other, third);
+        BOOST_TEST(!other.contains<service>());
+        BOOST_TEST_EQ(third.size(), 2u);
+
+        third.clear();
+        BOOST_TEST(third.empty());
+        BOOST_TEST_EQ(alive, 0);
+        third.emplace<service>(3);
+    }
+    BOOST_TEST_EQ(alive, 0);
+}
+
+void test_exceptions() {
+#ifndef BOOST_NO_EXCEPTIONS
+    boost::anys::type_map map;
+    BOOST_TEST_THROWS(map.emplace<throws_on_construction>(), std::runtime_error);
+    BOOST_TEST(!map.contains<throws_on_construction>());
+    BOOST_TEST(map.empty());
+#endif
+}
+
+} // anonymous namespace
+
+int main() {
+    test_basics();
+    test_move_only();
+    test_exceptions();
+
+    return boost::report_errors();
+}